@@ -2,8 +2,9 @@
 Options Analysis API Endpoints.
 """
 from fastapi import APIRouter, HTTPException
+from app.services.engine_jobs import EngineOverloaded
 from app.services.options_service import OptionsService
-from app.schemas.options import IVSurfaceResponse
+from app.schemas.options import AmericanChainRequest, AmericanChainResponse, IVSurfaceResponse
 
 router = APIRouter(prefix="/options", tags=["Options Analysis"])
 
@@ -26,6 +27,8 @@ def get_iv_surface(ticker: str):
         # It is synchronous. So I should use `def` or loop.run_in_executor.
         # Simple fix: make endpoint `def`.
         data = service.get_iv_surface(ticker)
+    except EngineOverloaded as e:
+        raise HTTPException(status_code=503, detail=str(e), headers={"Retry-After": "1"})
     except Exception as e:
         raise HTTPException(status_code=500, detail=str(e))
     
@@ -37,3 +40,22 @@ def get_iv_surface(ticker: str):
         **data,  # Unpack x, y, z, delta, gamma, etc.
         "count": len(data["x"])
     }
+
+
+@router.post("/american", response_model=AmericanChainResponse)
+def price_american_chain(request: AmericanChainRequest):
+    """
+    Price a chain of American options by Longstaff-Schwartz Monte Carlo.
+
+    Every contract is priced in one interactive engine job (sync endpoint,
+    so FastAPI's threadpool thread just waits for it); Greeks are per
+    contract in the units of the IV surface Greeks. 503 if the engine's
+    queue is full.
+    """
+    service = OptionsService()
+    try:
+        return service.price_american(request)
+    except EngineOverloaded as e:
+        raise HTTPException(status_code=503, detail=str(e), headers={"Retry-After": "1"})
+    except ImportError as e:
+        raise HTTPException(status_code=500, detail=f"Options engine not available: {e}")
@@ -4,38 +4,97 @@ Monte Carlo simulation API endpoints.
 Provides endpoints for running price path simulations using the C++ engine.
 """
 
+import asyncio
+import os
+import uuid
 from typing import Annotated
 
-from fastapi import APIRouter, Depends, HTTPException, status
-from fastapi.concurrency import run_in_threadpool
+from fastapi import APIRouter, Depends, HTTPException, WebSocket, WebSocketDisconnect, status
+from fastapi.responses import FileResponse
+from pydantic import ValidationError
 from sqlmodel import Session
+from starlette.background import BackgroundTask
 
+from app.core.config import settings
 from app.core.db import get_session
 from app.schemas.simulation import (
+    BatchSimulationRequest,
+    BatchSimulationResponse,
+    PathExportRequest,
+    PortfolioSimulationRequest,
+    PortfolioSimulationResponse,
     SimulationError,
     SimulationRequest,
     SimulationResponse,
+    StreamingSimulationRequest,
 )
+from app.services.engine_jobs import BATCH, EngineOverloaded, run_engine_job
 from app.services.simulation_service import (
+    DEFAULT_CONFIDENCE_LEVELS,
+    DEFAULT_QUANTILES,
+    BatchSimulationRequest as ServiceBatchRequest,
+    PortfolioSimulationRequest as ServicePortfolioRequest,
     SimulationRequest as ServiceRequest,
+    export_simulation_paths,
+    get_batch_simulation_summary,
+    get_portfolio_simulation_summary,
+    get_progressive_summary,
     get_simulation_summary,
+    progressive_chunk_size,
+    start_progressive_simulation,
 )
+from app.services.websocket_manager import ConnectionManager
 
 router = APIRouter(prefix="/simulation", tags=["Simulation"])
 
 # Type alias for session dependency
 SessionDep = Annotated[Session, Depends(get_session)]
 
+# Connections of progressive simulation streams
+manager = ConnectionManager()
+
+
+def _service_request(request: SimulationRequest) -> ServiceRequest:
+    """Convert an API request to a service request."""
+    return ServiceRequest(
+        ticker=request.ticker.upper(),
+        start_date=request.start_date,
+        end_date=request.end_date,
+        num_simulations=request.num_simulations,
+        num_steps=request.num_steps,
+        histogram_bins=request.histogram_bins,
+        seed=request.seed or 0,
+        quantiles=tuple(request.quantiles) if request.quantiles else DEFAULT_QUANTILES,
+        confidence_levels=(
+            tuple(request.confidence_levels)
+            if request.confidence_levels
+            else DEFAULT_CONFIDENCE_LEVELS
+        ),
+        include_final_prices=request.include_final_prices,
+        variance_reduction=request.variance_reduction,
+        target_standard_error=request.target_standard_error,
+        output_stride=request.output_stride,
+    )
+
 
 def _run_simulation_sync(session: Session, request: ServiceRequest) -> dict:
     """
     Synchronous wrapper for simulation service.
 
-    This runs in a thread pool to avoid blocking the async event loop.
+    This runs as an engine job to avoid blocking the async event loop.
     """
     return get_simulation_summary(session, request)
 
 
+def _overloaded(e: Exception) -> HTTPException:
+    """503 for a request the engine scheduler has no room for."""
+    return HTTPException(
+        status_code=status.HTTP_503_SERVICE_UNAVAILABLE,
+        detail=f"Simulation engine overloaded: {e}",
+        headers={"Retry-After": "1"},
+    )
+
+
 @router.post(
     "/monte-carlo",
     response_model=SimulationResponse,
@@ -47,14 +106,27 @@ The simulation:
 1. Fetches historical price data for the specified ticker
 2. Calculates annualized drift (μ) and volatility (σ) from log returns
 3. Runs the C++ Monte Carlo engine with the computed parameters
-4. Returns aggregated results (mean path, percentiles, histogram)
+4. Returns aggregated results (mean path, percentile bands, histogram)
+   and tail risk (VaR, CVaR, drawdown, probability of loss) computed in C++
+
+Set `include_final_prices` to also receive every path's final price.
 
-**Note:** The heavy computation runs in a thread pool to avoid blocking.
+`variance_reduction` picks antithetic pairs, a control variate on the mean or
+randomized Sobol points; `final_price.standard_error` reports the matching
+standard error. With `target_standard_error` a short pilot run sizes
+`num_simulations` to reach it.
+
+**Note:** The heavy computation runs as an interactive job of the engine's
+own scheduler (one worker per physical core) to avoid blocking. The engine
+releases the GIL and spreads paths across idle workers, so other requests
+keep being served while it runs; when the scheduler's queue is full the
+request is rejected with 503.
     """,
     responses={
         400: {"model": SimulationError, "description": "Validation error"},
         404: {"model": SimulationError, "description": "Ticker not found"},
         500: {"model": SimulationError, "description": "Engine error"},
+        503: {"model": SimulationError, "description": "Engine overloaded"},
     },
 )
 async def run_monte_carlo(
@@ -76,20 +148,12 @@ async def run_monte_carlo(
                       500 for engine errors
     """
     # Convert API request to service request
-    service_request = ServiceRequest(
-        ticker=request.ticker.upper(),
-        start_date=request.start_date,
-        end_date=request.end_date,
-        num_simulations=request.num_simulations,
-        num_steps=request.num_steps,
-        histogram_bins=request.histogram_bins,
-        seed=request.seed or 0,
-    )
+    service_request = _service_request(request)
 
     try:
-        # Run simulation in thread pool to avoid blocking async event loop
-        # This is crucial because the C++ engine is CPU-bound
-        result = await run_in_threadpool(
+        # Run simulation on the engine workers to avoid blocking the event
+        # loop; this is crucial because the C++ engine is CPU-bound
+        result = await run_engine_job(
             _run_simulation_sync,
             session,
             service_request,
@@ -113,6 +177,9 @@ async def run_monte_carlo(
                 detail=error_msg,
             )
 
+    except EngineOverloaded as e:
+        raise _overloaded(e)
+
     except ImportError as e:
         # C++ engine not built
         raise HTTPException(
@@ -128,6 +195,332 @@ async def run_monte_carlo(
         )
 
 
+@router.post(
+    "/monte-carlo/batch",
+    response_model=BatchSimulationResponse,
+    summary="Run Monte Carlo simulations for several tickers",
+    description="""
+Run the `/monte-carlo` simulation for every ticker of a list in one request.
+
+Price data is validated per ticker; the tickers that validate are simulated
+together in a single C++ engine call that shares the thread pool and scratch
+memory, so a watchlist costs one round trip instead of one per ticker. Each
+entry of `results` is exactly the `/monte-carlo` response for that ticker
+with the same options and seed; tickers without usable data are reported in
+`errors` instead of failing the request.
+    """,
+    responses={
+        400: {"model": SimulationError, "description": "Validation error"},
+        500: {"model": SimulationError, "description": "Engine error"},
+        503: {"model": SimulationError, "description": "Engine overloaded"},
+    },
+)
+async def run_monte_carlo_batch(
+    request: BatchSimulationRequest,
+    session: SessionDep,
+) -> BatchSimulationResponse:
+    """
+    Run one Monte Carlo simulation per ticker.
+
+    Args:
+        request: Tickers and shared simulation parameters
+        session: Database session (injected)
+
+    Returns:
+        Per-ticker simulation results and errors
+
+    Raises:
+        HTTPException: 400 for validation errors, 500 for engine errors
+    """
+    service_request = ServiceBatchRequest(
+        tickers=tuple(t.upper() for t in request.tickers),
+        start_date=request.start_date,
+        end_date=request.end_date,
+        num_simulations=request.num_simulations,
+        num_steps=request.num_steps,
+        histogram_bins=request.histogram_bins,
+        seed=request.seed or 0,
+        quantiles=tuple(request.quantiles) if request.quantiles else DEFAULT_QUANTILES,
+        confidence_levels=(
+            tuple(request.confidence_levels)
+            if request.confidence_levels
+            else DEFAULT_CONFIDENCE_LEVELS
+        ),
+        include_final_prices=request.include_final_prices,
+        variance_reduction=request.variance_reduction,
+        output_stride=request.output_stride,
+    )
+
+    try:
+        result = await run_engine_job(
+            get_batch_simulation_summary, session, service_request, priority=BATCH
+        )
+        return BatchSimulationResponse(**result)
+
+    except ValueError as e:
+        raise HTTPException(
+            status_code=status.HTTP_400_BAD_REQUEST,
+            detail=str(e),
+        )
+
+    except EngineOverloaded as e:
+        raise _overloaded(e)
+
+    except ImportError as e:
+        raise HTTPException(
+            status_code=status.HTTP_500_INTERNAL_SERVER_ERROR,
+            detail=f"Monte Carlo engine not available: {e}. Please build the extension.",
+        )
+
+    except Exception as e:
+        raise HTTPException(
+            status_code=status.HTTP_500_INTERNAL_SERVER_ERROR,
+            detail=f"Simulation failed: {e}",
+        )
+
+
+async def _watch_for_cancel(websocket: WebSocket, token) -> None:
+    """Cancel the run on {"action": "cancel"} or when the client goes away."""
+    try:
+        while True:
+            message = await websocket.receive_json()
+            if isinstance(message, dict) and message.get("action") == "cancel":
+                break
+    except Exception:
+        pass
+    token.cancel()
+
+
+@router.websocket("/ws")
+async def stream_monte_carlo(websocket: WebSocket, session: SessionDep) -> None:
+    """
+    Progressive Monte Carlo simulation over WebSocket.
+
+    The client sends one StreamingSimulationRequest as JSON. The run is then
+    simulated in chunks of paths and, after each chunk, a message with the
+    /monte-carlo response shape over the paths done so far plus a progress
+    section is sent ({"type": "progress", ...}); the last one has
+    {"type": "complete"}. A run with target_standard_error completes as soon
+    as the snapshot reaches it.
+
+    Sending {"action": "cancel"} or closing the socket stops the engine
+    within one block of paths and frees its threads. Errors are sent as
+    {"type": "error", "detail": ...}.
+    """
+    from app.engine import CancellationToken
+
+    await manager.connect(websocket)
+    token = CancellationToken() if CancellationToken is not None else None
+    watcher = None
+
+    try:
+        try:
+            request = StreamingSimulationRequest(**await websocket.receive_json())
+        except (ValidationError, TypeError, ValueError) as e:
+            await manager.send(websocket, {"type": "error", "detail": str(e)})
+            return
+
+        service_request = _service_request(request)
+        params, simulation = await run_engine_job(
+            start_progressive_simulation, session, service_request
+        )
+
+        watcher = asyncio.create_task(_watch_for_cancel(websocket, token))
+        chunk = progressive_chunk_size(service_request.num_simulations)
+
+        while not token.cancelled:
+            # The engine releases the GIL and checks the token per block
+            if await run_engine_job(simulation.run, chunk, token) == 0:
+                break
+
+            summary = await run_engine_job(
+                get_progressive_summary, params, service_request, simulation
+            )
+            done = summary["progress"]["done"]
+            if not await manager.send(websocket, {"type": "complete" if done else "progress", **summary}):
+                break
+            if done:
+                break
+
+        if token.cancelled:
+            await manager.send(websocket, {"type": "cancelled"})
+
+    except WebSocketDisconnect:
+        pass
+
+    except (ValueError, ImportError, EngineOverloaded) as e:
+        await manager.send(websocket, {"type": "error", "detail": str(e)})
+
+    except Exception as e:
+        await manager.send(websocket, {"type": "error", "detail": f"Simulation failed: {e}"})
+
+    finally:
+        if token is not None:
+            token.cancel()
+        if watcher is not None:
+            watcher.cancel()
+        manager.disconnect(websocket)
+
+
+@router.post(
+    "/portfolio",
+    response_model=PortfolioSimulationResponse,
+    summary="Run correlated portfolio Monte Carlo simulation",
+    description="""
+Simulate the value of a multi-asset portfolio with correlated returns.
+
+The daily log-return mean vector and covariance matrix are estimated from
+the overlapping DailyPrice history (the same estimate the HRP optimizer
+uses). The C++ engine factors the covariance once, draws correlated shocks
+for all assets and aggregates portfolio value paths directly. Results have
+the same shape as `/monte-carlo`, in portfolio value instead of price.
+    """,
+    responses={
+        400: {"model": SimulationError, "description": "Validation error"},
+        500: {"model": SimulationError, "description": "Engine error"},
+        503: {"model": SimulationError, "description": "Engine overloaded"},
+    },
+)
+async def run_portfolio_monte_carlo(
+    request: PortfolioSimulationRequest,
+) -> PortfolioSimulationResponse:
+    """
+    Run correlated portfolio simulation.
+
+    Args:
+        request: Portfolio simulation parameters
+
+    Returns:
+        Portfolio simulation results
+
+    Raises:
+        HTTPException: 400 for validation/data errors, 500 for engine errors
+    """
+    service_request = ServicePortfolioRequest(
+        tickers=tuple(t.upper() for t in request.tickers),
+        weights=tuple(request.weights),
+        initial_value=request.initial_value,
+        num_simulations=request.num_simulations,
+        num_steps=request.num_steps,
+        histogram_bins=request.histogram_bins,
+        seed=request.seed or 0,
+        quantiles=tuple(request.quantiles) if request.quantiles else DEFAULT_QUANTILES,
+        confidence_levels=(
+            tuple(request.confidence_levels)
+            if request.confidence_levels
+            else DEFAULT_CONFIDENCE_LEVELS
+        ),
+        include_final_prices=request.include_final_prices,
+    )
+
+    try:
+        result = await run_engine_job(get_portfolio_simulation_summary, service_request)
+        return PortfolioSimulationResponse(**result)
+
+    except ValueError as e:
+        raise HTTPException(
+            status_code=status.HTTP_400_BAD_REQUEST,
+            detail=str(e),
+        )
+
+    except EngineOverloaded as e:
+        raise _overloaded(e)
+
+    except ImportError as e:
+        raise HTTPException(
+            status_code=status.HTTP_500_INTERNAL_SERVER_ERROR,
+            detail=f"Monte Carlo engine not available: {e}. Please build the extension.",
+        )
+
+    except Exception as e:
+        raise HTTPException(
+            status_code=status.HTTP_500_INTERNAL_SERVER_ERROR,
+            detail=f"Simulation failed: {e}",
+        )
+
+
+def _remove_file(path: str) -> None:
+    try:
+        os.remove(path)
+    except OSError:
+        pass
+
+
+@router.post(
+    "/export",
+    summary="Export simulated paths as a binary file",
+    description="""
+Run the same simulation as `/monte-carlo` and download every price path.
+
+The C++ engine writes the paths to disk while it generates them and the file
+is streamed back from disk, so exports of millions of paths never pass
+through JSON or Python memory. The body is a `STRATAPT` file: a 64-byte
+header, the exported step indices, then one row of all paths per step
+(`float32` by default). Load it with
+`app.services.path_export.read_path_export`, or with `numpy.memmap` using the
+header's `values_offset`.
+
+`step_stride` keeps every k-th step plus the final one.
+    """,
+    response_class=FileResponse,
+    responses={
+        200: {"content": {"application/octet-stream": {}}, "description": "Path file"},
+        400: {"model": SimulationError, "description": "Validation error"},
+        404: {"model": SimulationError, "description": "Ticker not found"},
+        500: {"model": SimulationError, "description": "Engine error"},
+        503: {"model": SimulationError, "description": "Engine overloaded"},
+    },
+)
+async def export_paths(
+    request: PathExportRequest,
+    session: SessionDep,
+) -> FileResponse:
+    """
+    Simulate and return the raw paths.
+
+    The file lives in settings.path_export_dir until the response is sent.
+    """
+    service_request = _service_request(request)
+    os.makedirs(settings.path_export_dir, exist_ok=True)
+    path = os.path.join(settings.path_export_dir, f"{uuid.uuid4().hex}.stratapt")
+
+    try:
+        params = await run_engine_job(
+            export_simulation_paths,
+            session,
+            service_request,
+            path,
+            request.float32,
+            request.step_stride,
+            priority=BATCH,
+        )
+    except ValueError as e:
+        error_msg = str(e)
+        if "not found" in error_msg.lower() or "no price data" in error_msg.lower():
+            raise HTTPException(status_code=status.HTTP_404_NOT_FOUND, detail=error_msg)
+        raise HTTPException(status_code=status.HTTP_400_BAD_REQUEST, detail=error_msg)
+    except EngineOverloaded as e:
+        raise _overloaded(e)
+    except ImportError as e:
+        raise HTTPException(
+            status_code=status.HTTP_500_INTERNAL_SERVER_ERROR,
+            detail=f"Monte Carlo engine not available: {e}. Please build the extension.",
+        )
+    except Exception as e:
+        _remove_file(path)
+        raise HTTPException(
+            status_code=status.HTTP_500_INTERNAL_SERVER_ERROR,
+            detail=f"Path export failed: {e}",
+        )
+
+    return FileResponse(
+        path,
+        media_type="application/octet-stream",
+        filename=f"{params.ticker}_{request.num_simulations}_paths.stratapt",
+        background=BackgroundTask(_remove_file, path),
+    )
+
+
 @router.get(
     "/health",
     summary="Check simulation engine health",
@@ -150,7 +543,7 @@ async def check_engine_health() -> dict:
             }
 
         # Quick test run
-        result = await run_in_threadpool(
+        result = await run_engine_job(
             engine_func,
             s0=100.0,
             mu=0.08,
@@ -7,15 +7,20 @@ from sqlmodel import Session, select
 from app.core.db import get_session, engine
 from app.models.statarb import CointegratedPair
 from app.services.cointegration import CointegrationService
-from app.schemas.statarb import AnalysisRequest, AnalysisResponse, SpreadPoint
+from app.services.engine_jobs import BATCH, EngineOverloaded, run_engine_job, submit_engine_job
+from app.services.pair_signals import pair_signal_monitor
+from app.schemas.statarb import AnalysisRequest, AnalysisResponse, PairSignalPoint, SpreadPoint
 
 router = APIRouter(prefix="/statarb", tags=["StatArb"])
 
 def run_analysis_task(universe: List[str]):
-    """Background task to run pairs analysis."""
-    with Session(engine) as session:
-        service = CointegrationService()
-        service.find_pairs(universe, session)
+    """Batch engine job (or background task) to run pairs analysis."""
+    try:
+        with Session(engine) as session:
+            service = CointegrationService()
+            service.find_pairs(universe, session)
+    except Exception as e:
+        print(f"Pair analysis failed: {e}")
 
 @router.post("/analyze", response_model=AnalysisResponse)
 async def analyze_pairs(
@@ -24,9 +29,15 @@ async def analyze_pairs(
 ):
     """
     Start a cointegration analysis on the provided universe.
-    Runs in the background.
+    Runs in the background as a batch engine job; 503 if the engine's
+    batch queue is full.
     """
-    background_tasks.add_task(run_analysis_task, request.universe)
+    try:
+        submit_engine_job(run_analysis_task, request.universe, priority=BATCH)
+    except EngineOverloaded as e:
+        raise HTTPException(status_code=503, detail=str(e), headers={"Retry-After": "5"})
+    except ImportError:
+        background_tasks.add_task(run_analysis_task, request.universe)
     return {"message": f"Analysis started for {len(request.universe)} tickers", "status": "processing"}
 
 @router.get("/pairs", response_model=List[CointegratedPair])
@@ -46,3 +57,19 @@ async def get_spread(
     if not data:
         raise HTTPException(status_code=404, detail="Insufficient data for pair")
     return data
+
+@router.get("/signals", response_model=List[PairSignalPoint])
+async def get_signals(session: Session = Depends(get_session)):
+    """
+    Get the rolling spread z-score and position of every active pair.
+
+    Only daily closes since the previous call are applied, so this stays
+    cheap however long the price history.
+    """
+    try:
+        await run_engine_job(pair_signal_monitor.refresh, session)
+    except EngineOverloaded as e:
+        raise HTTPException(status_code=503, detail=str(e), headers={"Retry-After": "1"})
+    except ImportError as e:
+        raise HTTPException(status_code=503, detail=str(e))
+    return pair_signal_monitor.signals()
@@ -1,10 +1,21 @@
 from fastapi import APIRouter, WebSocket, WebSocketDisconnect
+from sqlmodel import Session
+from app.core.db import engine
+from app.services.engine_jobs import BATCH, EngineOverloaded, run_engine_job
+from app.services.pair_signals import pair_signal_monitor
 from app.services.websocket_manager import ConnectionManager, price_generator
 import asyncio
 
 router = APIRouter(prefix="/stream", tags=["Live Stream"])
 manager = ConnectionManager()
 
+def _refresh_pair_signals():
+    try:
+        with Session(engine) as session:
+            pair_signal_monitor.refresh(session)
+    except Exception as e:
+        print(f"Pair signal refresh failed: {e}")
+
 @router.websocket("/ws/live/{ticker}")
 async def websocket_endpoint(websocket: WebSocket, ticker: str):
     """
@@ -12,8 +23,15 @@ async def websocket_endpoint(websocket: WebSocket, ticker: str):
     """
     await manager.connect(websocket)
     try:
+        # Bring the pair signals up to the latest close; ticks only preview them
+        try:
+            await run_engine_job(_refresh_pair_signals, priority=BATCH)
+        except EngineOverloaded as e:
+            print(f"Pair signal refresh skipped: {e}")
+
         # Create a generator for this connection
         async for data in price_generator(ticker):
+            data["pair_signals"] = pair_signal_monitor.on_tick(data["ticker"], data["price"])
             # Check connection state before sending (though send_json raises if closed)
             await websocket.send_json(data)
     except WebSocketDisconnect:
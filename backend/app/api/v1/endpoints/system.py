@@ -4,15 +4,51 @@ from sqlmodel import Session, select, func, text
 from app.core.db import get_session
 from app.models.market_data import DailyPrice, Ticker
 from app.core.config import settings
+from app.services.engine_jobs import scheduler_snapshot
+from app.services.engine_metrics import engine_metrics
 from pydantic import BaseModel
 
 router = APIRouter(prefix="/system", tags=["system"])
 
+class HistogramSnapshot(BaseModel):
+    bounds: list[float]  # bucket upper bounds; counts has one extra overflow bucket
+    counts: list[int]
+    count: int
+    sum: float
+    mean: float
+    max: float
+
+class EngineMetricsSnapshot(BaseModel):
+    runs: int
+    timings_enabled: bool | None  # None until the first run
+    phases: dict[str, HistogramSnapshot]  # seconds per simulation phase
+    bytes_allocated: HistogramSnapshot
+    paths_per_second: HistogramSnapshot
+
+class SchedulerClassSnapshot(BaseModel):
+    queued: int  # jobs waiting for a worker now
+    running: int
+    submitted: int
+    completed: int
+    failed: int
+    rejected: int  # turned away with 503 (queue full)
+    cancelled: int
+    wait_seconds_total: float  # submission to start
+    wait_seconds_max: float
+    run_seconds_total: float
+    run_seconds_max: float
+
+class SchedulerSnapshot(BaseModel):
+    slots: int  # engine jobs run at once
+    classes: dict[str, SchedulerClassSnapshot]  # "interactive", "batch"
+
 class SystemHealthResponse(BaseModel):
     ticker_count: int
     price_rows: int
     db_size_mb: float
     status: str
+    engine: EngineMetricsSnapshot
+    scheduler: SchedulerSnapshot | None  # None without the compiled engine
 
 @router.get("/health", response_model=SystemHealthResponse)
 def get_system_health(db: Session = Depends(get_session)):
@@ -56,7 +92,9 @@ def get_system_health(db: Session = Depends(get_session)):
             ticker_count=ticker_count,
             price_rows=price_rows,
             db_size_mb=round(size_mb, 2),
-            status="ok"
+            status="ok",
+            engine=EngineMetricsSnapshot(**engine_metrics.snapshot()),
+            scheduler=scheduler_snapshot(),
         )
     except Exception as e:
         raise HTTPException(status_code=500, detail=str(e))
@@ -44,6 +44,51 @@ class Settings(BaseSettings):
         default="sqlite:///../data/quant.db",
         description="Database connection URL",
     )
+    price_panel_path: str = Field(
+        default="../data/price_panel.bin",
+        description="Memory-mapped price panel snapshot rebuilt by ingestion",
+    )
+    path_export_dir: str = Field(
+        default="../data/exports",
+        description="Scratch directory of simulated path files served by /simulation/export",
+    )
+
+    # =========================
+    # C++ Engine Configuration
+    # =========================
+    engine_num_threads: int = Field(
+        default=0,
+        ge=0,
+        description="Worker threads per engine call (0 = all cores)",
+    )
+    engine_max_queued_interactive: int = Field(
+        default=64,
+        ge=0,
+        description="Interactive engine jobs allowed to wait for a worker before "
+        "requests are rejected with 503",
+    )
+    engine_max_queued_batch: int = Field(
+        default=16,
+        ge=0,
+        description="Batch engine jobs (multi-ticker runs, exports, pair screens) "
+        "allowed to wait for a worker before requests are rejected with 503",
+    )
+    engine_float32_paths: bool = Field(
+        default=False,
+        description="Keep simulated step rows in float32: half the path memory, "
+        "fan-chart values within a relative 6e-8, terminal statistics unchanged",
+    )
+
+    simulation_cache_entries: int = Field(
+        default=128,
+        ge=0,
+        description="Seeded simulation summaries kept in memory (0 = no cache)",
+    )
+    simulation_cache_mb: int = Field(
+        default=256,
+        ge=0,
+        description="Approximate memory budget of the simulation cache in MB",
+    )
 
     # =========================
     # Alpaca Trading API
@@ -6,9 +6,93 @@ The compiled extension should be placed in this directory.
 """
 
 try:
-    from .monte_carlo_engine import SimulationResult, run_monte_carlo
+    from .monte_carlo_engine import (
+        AlignedPanel,
+        AmericanOptionBatch,
+        CancellationToken,
+        CointegrationPair,
+        EngineJob,
+        GarchParams,
+        HestonParams,
+        HrpAllocation,
+        MertonParams,
+        PairSignal,
+        PairSignalState,
+        PairsBacktestResult,
+        PairsGridResult,
+        PairsMetrics,
+        PathPrecision,
+        PathStorage,
+        PricePanel,
+        ProcessModel,
+        ProgressiveSimulation,
+        RollingStatistics,
+        SchedulerOverloaded,
+        SchedulerStats,
+        SimulationResult,
+        SimulationTimings,
+        SimulationWorkspace,
+        TaskPriority,
+        VarianceReduction,
+        configure_scheduler,
+        hrp_allocation,
+        physical_core_count,
+        price_american_batch,
+        run_monte_carlo,
+        run_monte_carlo_batch,
+        run_pairs_backtest,
+        run_pairs_grid,
+        run_portfolio_monte_carlo,
+        scheduler_slots,
+        scheduler_stats,
+        screen_cointegrated_pairs,
+        submit_job,
+        write_price_panel,
+    )
 
-    __all__ = ["SimulationResult", "run_monte_carlo"]
+    __all__ = [
+        "AlignedPanel",
+        "AmericanOptionBatch",
+        "CancellationToken",
+        "CointegrationPair",
+        "EngineJob",
+        "GarchParams",
+        "HestonParams",
+        "HrpAllocation",
+        "MertonParams",
+        "PairSignal",
+        "PairSignalState",
+        "PairsBacktestResult",
+        "PairsGridResult",
+        "PairsMetrics",
+        "PathPrecision",
+        "PathStorage",
+        "PricePanel",
+        "ProcessModel",
+        "ProgressiveSimulation",
+        "RollingStatistics",
+        "SchedulerOverloaded",
+        "SchedulerStats",
+        "SimulationResult",
+        "SimulationTimings",
+        "SimulationWorkspace",
+        "TaskPriority",
+        "VarianceReduction",
+        "configure_scheduler",
+        "hrp_allocation",
+        "physical_core_count",
+        "price_american_batch",
+        "run_monte_carlo",
+        "run_monte_carlo_batch",
+        "run_pairs_backtest",
+        "run_pairs_grid",
+        "run_portfolio_monte_carlo",
+        "scheduler_slots",
+        "scheduler_stats",
+        "screen_cointegrated_pairs",
+        "submit_job",
+        "write_price_panel",
+    ]
 
 except ImportError as e:
     import warnings
@@ -21,7 +105,46 @@ except ImportError as e:
     )
 
     # Provide stub for type hints
+    AlignedPanel = None
+    AmericanOptionBatch = None
+    CancellationToken = None
+    CointegrationPair = None
+    EngineJob = None
+    GarchParams = None
+    HestonParams = None
+    HrpAllocation = None
+    MertonParams = None
+    PairSignal = None
+    PairSignalState = None
+    PairsBacktestResult = None
+    PairsGridResult = None
+    PairsMetrics = None
+    PathPrecision = None
+    PathStorage = None
+    PricePanel = None
+    ProcessModel = None
+    ProgressiveSimulation = None
+    RollingStatistics = None
+    SchedulerOverloaded = None
+    SchedulerStats = None
     SimulationResult = None
+    SimulationTimings = None
+    SimulationWorkspace = None
+    TaskPriority = None
+    VarianceReduction = None
+    configure_scheduler = None
+    hrp_allocation = None
+    physical_core_count = None
+    price_american_batch = None
     run_monte_carlo = None
+    run_monte_carlo_batch = None
+    run_pairs_backtest = None
+    run_pairs_grid = None
+    run_portfolio_monte_carlo = None
+    scheduler_slots = None
+    scheduler_stats = None
+    screen_cointegrated_pairs = None
+    submit_job = None
+    write_price_panel = None
 
     __all__ = []
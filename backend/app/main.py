@@ -11,10 +11,12 @@ from typing import Any
 
 from fastapi import FastAPI
 from fastapi.middleware.cors import CORSMiddleware
+from sqlmodel import Session
 
 from app.api import api_router, get_available_routes
 from app.core.config import settings 
-from app.core.db import create_db_and_tables 
+from app.core.db import create_db_and_tables, engine
+from app.services.price_panel import price_panel_store
 
 @asynccontextmanager
 async def lifespan(app: FastAPI):
@@ -27,6 +29,13 @@ async def lifespan(app: FastAPI):
     # Initialize database tables
     create_db_and_tables()
 
+    # Build the price panel snapshot on first start (ingestion keeps it current)
+    try:
+        with Session(engine) as session:
+            price_panel_store.ensure(session)
+    except Exception as e:
+        print(f"Price panel not built: {e}")
+
     yield
 
     # Shutdown: Cleanup resources
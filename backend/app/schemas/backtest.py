@@ -24,6 +24,7 @@ class SensitivityPoint(BaseModel):
     exit_z: float
     sharpe_ratio: float
     total_return: float
+    max_drawdown: float
     win_rate: float
     trades: int
 
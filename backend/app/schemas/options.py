@@ -2,7 +2,14 @@
 Options Analysis Pydantic schemas.
 """
 from typing import List, Optional
-from pydantic import BaseModel
+from pydantic import BaseModel, Field, model_validator
+
+# One contract's path matrix is (exercise_dates + 1) x num_simulations
+# doubles; 10M cells is 80 MB
+MAX_PATH_CELLS_PER_CONTRACT = 10_000_000
+
+# Path steps of a whole chain, priced serially in one engine job
+MAX_PATH_STEPS_PER_CHAIN = 250_000_000
 
 class IVSurfaceResponse(BaseModel):
     ticker: str
@@ -15,3 +22,49 @@ class IVSurfaceResponse(BaseModel):
     theta: Optional[List[float]] = None
     rho: Optional[List[float]] = None
     count: int
+
+
+class AmericanContract(BaseModel):
+    strike: float = Field(..., gt=0)
+    days_to_expiry: float = Field(..., gt=0, le=3650)
+    volatility: float = Field(..., gt=0, le=5.0)
+    is_call: bool = True
+
+
+class AmericanChainRequest(BaseModel):
+    """Chain of American options on one underlying."""
+
+    spot: float = Field(..., gt=0)
+    risk_free_rate: float = Field(0.045, ge=-0.1, le=1.0)
+    dividend_yield: float = Field(0.0, ge=0.0, le=1.0, description="Continuous dividend yield")
+    contracts: List[AmericanContract] = Field(..., min_length=1, max_length=500)
+    num_simulations: int = Field(50_000, ge=1_000, le=500_000, description="Paths per contract")
+    exercise_dates: int = Field(50, ge=1, le=365, description="Exercise dates up to expiry")
+    seed: Optional[int] = Field(None, ge=0, description="Random seed (None = random)")
+
+    @model_validator(mode="after")
+    def bounded_work(self) -> "AmericanChainRequest":
+        """Cap the path memory of one contract and the work of the chain."""
+        steps = self.num_simulations * self.exercise_dates
+        if self.num_simulations * (self.exercise_dates + 1) > MAX_PATH_CELLS_PER_CONTRACT:
+            raise ValueError(
+                f"num_simulations x (exercise_dates + 1) must not exceed {MAX_PATH_CELLS_PER_CONTRACT:,}"
+            )
+        if steps * len(self.contracts) > MAX_PATH_STEPS_PER_CHAIN:
+            raise ValueError(
+                f"num_simulations x exercise_dates x contracts must not exceed {MAX_PATH_STEPS_PER_CHAIN:,}"
+            )
+        return self
+
+
+class AmericanChainResponse(BaseModel):
+    """Longstaff-Schwartz prices and Greeks, one entry per contract."""
+
+    price: List[float]
+    standard_error: List[float]
+    delta: List[float]
+    gamma: List[float]
+    vega: List[float]
+    theta: List[float]
+    rho: List[float]
+    count: int
@@ -7,7 +7,7 @@ Defines request/response models for Monte Carlo simulation endpoints.
 from __future__ import annotations
 
 from datetime import date
-from typing import Optional
+from typing import Literal, Optional
 
 from pydantic import BaseModel, Field, field_validator
 
@@ -46,6 +46,153 @@ class SimulationRequest(BaseModel):
         ge=0,
         description="Random seed for reproducibility (None = random)",
     )
+    quantiles: Optional[list[float]] = Field(
+        None,
+        min_length=1,
+        max_length=20,
+        description="Quantiles in (0, 1) for the percentile bands (None = 1/5/25/50/75/95/99)",
+    )
+    confidence_levels: Optional[list[float]] = Field(
+        None,
+        min_length=1,
+        max_length=20,
+        description="Confidence levels in (0, 1) for VaR/CVaR/drawdown (95% and 99% always included)",
+    )
+    include_final_prices: bool = Field(
+        False,
+        description="Also return the final price of every path",
+    )
+    variance_reduction: Literal["none", "antithetic", "control_variate", "sobol"] = Field(
+        "none",
+        description="Shock scheme: antithetic pairs, a control variate on the mean, or randomized Sobol points",
+    )
+    target_standard_error: Optional[float] = Field(
+        None,
+        gt=0,
+        description="Standard error of the mean final price to aim for; overrides num_simulations (up to 100,000 paths)",
+    )
+    output_stride: int = Field(
+        1,
+        ge=1,
+        le=2520,
+        description="Return the paths at every k-th step plus the final one (smaller response, faster run)",
+    )
+
+    @field_validator("end_date")
+    @classmethod
+    def end_date_after_start(cls, v: date, info) -> date:
+        """Validate that end_date is after start_date."""
+        start = info.data.get("start_date")
+        if start and v <= start:
+            raise ValueError("end_date must be after start_date")
+        return v
+
+    @field_validator("quantiles", "confidence_levels")
+    @classmethod
+    def quantiles_in_range(cls, v: Optional[list[float]]) -> Optional[list[float]]:
+        """Validate that every quantile / level lies strictly between 0 and 1."""
+        if v is not None and any(not 0.0 < q < 1.0 for q in v):
+            raise ValueError("values must lie strictly between 0 and 1")
+        return v
+
+
+class StreamingSimulationRequest(SimulationRequest):
+    """Request for a progressive simulation streamed over WebSocket."""
+
+    num_simulations: int = Field(
+        100_000,
+        ge=100,
+        le=1_000_000,
+        description="Total number of Monte Carlo paths; snapshots are sent as chunks complete",
+    )
+    target_standard_error: Optional[float] = Field(
+        None,
+        gt=0,
+        description="Stop early once the standard error of the mean final price reaches it",
+    )
+
+
+class PathExportRequest(SimulationRequest):
+    """Request for the raw simulated paths as a binary file."""
+
+    num_simulations: int = Field(
+        10_000,
+        ge=100,
+        le=2_000_000,
+        description="Number of Monte Carlo paths to export",
+    )
+    float32: bool = Field(
+        True,
+        description="Store prices as float32 (half the size of float64)",
+    )
+    step_stride: int = Field(
+        1,
+        ge=1,
+        le=2520,
+        description="Export every k-th step plus the final one",
+    )
+
+
+class BatchSimulationRequest(BaseModel):
+    """Request for one Monte Carlo simulation per ticker with shared options."""
+
+    tickers: list[str] = Field(
+        ...,
+        min_length=1,
+        max_length=100,
+        description="Tickers to simulate, e.g. a watchlist",
+    )
+    start_date: date = Field(..., description="Start date for historical data analysis")
+    end_date: date = Field(..., description="End date for historical data analysis")
+    num_simulations: int = Field(
+        10_000,
+        ge=100,
+        le=100_000,
+        description="Number of Monte Carlo paths per ticker",
+    )
+    num_steps: int = Field(
+        252,
+        ge=1,
+        le=2520,
+        description="Number of time steps (trading days) to project",
+    )
+    histogram_bins: int = Field(
+        50,
+        ge=10,
+        le=200,
+        description="Number of bins for each final price histogram",
+    )
+    seed: Optional[int] = Field(
+        None,
+        ge=0,
+        description="Random seed for reproducibility (None = random)",
+    )
+    quantiles: Optional[list[float]] = Field(
+        None,
+        min_length=1,
+        max_length=20,
+        description="Quantiles in (0, 1) for the percentile bands (None = 1/5/25/50/75/95/99)",
+    )
+    confidence_levels: Optional[list[float]] = Field(
+        None,
+        min_length=1,
+        max_length=20,
+        description="Confidence levels in (0, 1) for VaR/CVaR/drawdown (95% and 99% always included)",
+    )
+    include_final_prices: bool = Field(
+        False,
+        description="Also return the final price of every path",
+    )
+    variance_reduction: Literal["none", "antithetic", "control_variate", "sobol"] = Field(
+        "none",
+        description="Shock scheme: antithetic pairs, a control variate on the mean, or randomized Sobol points",
+    )
+    output_stride: int = Field(
+        1,
+        ge=1,
+        le=2520,
+        description="Return the paths at every k-th step plus the final one (smaller response, faster run)",
+    )
 
     @field_validator("end_date")
     @classmethod
@@ -56,6 +203,14 @@ class SimulationRequest(BaseModel):
             raise ValueError("end_date must be after start_date")
         return v
 
+    @field_validator("quantiles", "confidence_levels")
+    @classmethod
+    def quantiles_in_range(cls, v: Optional[list[float]]) -> Optional[list[float]]:
+        """Validate that every quantile / level lies strictly between 0 and 1."""
+        if v is not None and any(not 0.0 < q < 1.0 for q in v):
+            raise ValueError("values must lie strictly between 0 and 1")
+        return v
+
 
 class SimulationParameters(BaseModel):
     """Computed simulation parameters from historical data."""
@@ -65,6 +220,7 @@ class SimulationParameters(BaseModel):
     sigma: float = Field(..., description="Annualized volatility")
     num_simulations: int = Field(..., description="Number of simulation paths")
     num_steps: int = Field(..., description="Number of time steps")
+    variance_reduction: str = Field("none", description="Shock scheme used")
     data_points_used: int = Field(..., description="Number of historical data points used")
     analysis_period: dict = Field(..., description="Start and end dates of analysis")
 
@@ -76,6 +232,7 @@ class FinalPriceStats(BaseModel):
     std: float = Field(..., description="Standard deviation of final prices")
     min: float = Field(..., description="Minimum final price")
     max: float = Field(..., description="Maximum final price")
+    standard_error: float = Field(..., description="Standard error of the mean final price")
 
 
 class HistogramData(BaseModel):
@@ -85,6 +242,20 @@ class HistogramData(BaseModel):
     edges: list[float] = Field(..., description="Bin edge values")
 
 
+class PercentileBands(BaseModel):
+    """Percentile paths for fan charts."""
+
+    quantiles: list[float] = Field(..., description="Quantile of each band")
+    paths: list[list[float]] = Field(..., description="One price path per quantile")
+
+
+class MaxDrawdownStats(BaseModel):
+    """Distribution of per-path maximum drawdowns (fraction of running peak)."""
+
+    mean: float = Field(..., description="Mean maximum drawdown")
+    quantiles: list[float] = Field(..., description="Maximum drawdown quantile at each confidence level")
+
+
 class TailRiskMetrics(BaseModel):
     """Value at Risk and Conditional Value at Risk metrics."""
     
@@ -92,17 +263,28 @@ class TailRiskMetrics(BaseModel):
     var_99: float = Field(..., description="Value at Risk (99% confidence)")
     cvar_95: float = Field(..., description="Conditional VaR (95%) - Expected Shortfall")
     cvar_99: float = Field(..., description="Conditional VaR (99%) - Expected Shortfall")
+    confidence_levels: list[float] = Field(..., description="Confidence levels of var/cvar/max_drawdown")
+    var: list[float] = Field(..., description="Value at Risk at each confidence level")
+    cvar: list[float] = Field(..., description="Expected Shortfall at each confidence level")
+    probability_of_loss: float = Field(..., description="Fraction of paths ending below s0")
+    max_drawdown: MaxDrawdownStats = Field(..., description="Maximum drawdown distribution")
 
 
 class SimulationResults(BaseModel):
     """Core simulation output data."""
 
+    steps: list[int] = Field(..., description="Step index of each point of the paths and bands")
     mean_path: list[float] = Field(..., description="Average price path across simulations")
     percentile_05: list[float] = Field(..., description="5th percentile path (95% CI lower)")
     percentile_95: list[float] = Field(..., description="95th percentile path (95% CI upper)")
+    percentile_bands: PercentileBands = Field(..., description="Percentile paths for all requested quantiles")
     histogram: HistogramData = Field(..., description="Final price distribution")
     final_price: FinalPriceStats = Field(..., description="Final price statistics")
     tail_risk: TailRiskMetrics = Field(..., description="Risk analysis metrics")
+    final_prices: Optional[list[float]] = Field(
+        None,
+        description="Final price of every path (only if include_final_prices)",
+    )
 
 
 class SimulationResponse(BaseModel):
@@ -122,6 +304,7 @@ class SimulationResponse(BaseModel):
                     "sigma": 0.25,
                     "num_simulations": 10000,
                     "num_steps": 252,
+                    "variance_reduction": "none",
                     "data_points_used": 252,
                     "analysis_period": {
                         "start": "2023-01-01",
@@ -129,9 +312,14 @@ class SimulationResponse(BaseModel):
                     },
                 },
                 "results": {
+                    "steps": [0, 1, "..."],
                     "mean_path": [195.50, 196.20, "..."],
                     "percentile_05": [195.50, 194.10, "..."],
                     "percentile_95": [195.50, 198.30, "..."],
+                    "percentile_bands": {
+                        "quantiles": [0.05, 0.50, 0.95],
+                        "paths": [[195.50, 194.10, "..."], [195.50, 196.00, "..."], [195.50, 198.30, "..."]],
+                    },
                     "histogram": {
                         "counts": [10, 45, 120, "..."],
                         "edges": [150.0, 160.0, 170.0, "..."],
@@ -141,6 +329,7 @@ class SimulationResponse(BaseModel):
                         "std": 45.20,
                         "min": 120.50,
                         "max": 380.25,
+                        "standard_error": 0.45,
                     },
                 },
             }
@@ -148,6 +337,115 @@ class SimulationResponse(BaseModel):
     }
 
 
+class BatchSimulationResponse(BaseModel):
+    """Response of a batch simulation."""
+
+    results: list[SimulationResponse] = Field(
+        ..., description="One simulation per ticker with usable price data, in request order"
+    )
+    errors: dict[str, str] = Field(
+        default_factory=dict, description="Why each remaining ticker could not be simulated"
+    )
+
+
+class PortfolioSimulationRequest(BaseModel):
+    """Request parameters for a correlated portfolio Monte Carlo simulation."""
+
+    tickers: list[str] = Field(
+        ...,
+        min_length=1,
+        max_length=100,
+        description="Tickers held in the portfolio",
+    )
+    weights: list[float] = Field(
+        ...,
+        min_length=1,
+        max_length=100,
+        description="Fraction of initial_value held in each ticker (same order as tickers)",
+    )
+    initial_value: float = Field(
+        10_000.0,
+        gt=0,
+        description="Portfolio value at the start of the simulation",
+    )
+    num_simulations: int = Field(
+        10_000,
+        ge=100,
+        le=100_000,
+        description="Number of Monte Carlo paths to simulate",
+    )
+    num_steps: int = Field(
+        252,
+        ge=1,
+        le=2520,
+        description="Number of time steps (trading days) to project",
+    )
+    histogram_bins: int = Field(
+        50,
+        ge=10,
+        le=200,
+        description="Number of bins for final value histogram",
+    )
+    seed: Optional[int] = Field(
+        None,
+        ge=0,
+        description="Random seed for reproducibility (None = random)",
+    )
+    quantiles: Optional[list[float]] = Field(
+        None,
+        min_length=1,
+        max_length=20,
+        description="Quantiles in (0, 1) for the percentile bands (None = 1/5/25/50/75/95/99)",
+    )
+    confidence_levels: Optional[list[float]] = Field(
+        None,
+        min_length=1,
+        max_length=20,
+        description="Confidence levels in (0, 1) for VaR/CVaR/drawdown (95% and 99% always included)",
+    )
+    include_final_prices: bool = Field(
+        False,
+        description="Also return the final portfolio value of every path",
+    )
+
+    @field_validator("weights")
+    @classmethod
+    def weights_match_tickers(cls, v: list[float], info) -> list[float]:
+        """Validate that there is one weight per ticker."""
+        tickers = info.data.get("tickers")
+        if tickers is not None and len(v) != len(tickers):
+            raise ValueError("weights must have one entry per ticker")
+        return v
+
+    @field_validator("quantiles", "confidence_levels")
+    @classmethod
+    def quantiles_in_range(cls, v: Optional[list[float]]) -> Optional[list[float]]:
+        """Validate that every quantile / level lies strictly between 0 and 1."""
+        if v is not None and any(not 0.0 < q < 1.0 for q in v):
+            raise ValueError("values must lie strictly between 0 and 1")
+        return v
+
+
+class PortfolioSimulationParameters(BaseModel):
+    """Model parameters estimated from the overlapping price history."""
+
+    initial_value: float = Field(..., description="Portfolio value at t = 0")
+    mu: list[float] = Field(..., description="Annualized mean log return per ticker")
+    sigma: list[float] = Field(..., description="Annualized volatility per ticker")
+    correlation: list[list[float]] = Field(..., description="Correlation matrix of daily log returns")
+    num_simulations: int = Field(..., description="Number of simulation paths")
+    num_steps: int = Field(..., description="Number of time steps")
+
+
+class PortfolioSimulationResponse(BaseModel):
+    """Portfolio simulation response; results hold portfolio values."""
+
+    tickers: list[str] = Field(..., description="Tickers, in the order of the parameters")
+    weights: list[float] = Field(..., description="Weight of each ticker")
+    parameters: PortfolioSimulationParameters = Field(..., description="Estimated model parameters")
+    results: SimulationResults = Field(..., description="Simulation results of the portfolio value")
+
+
 class SimulationError(BaseModel):
     """Error response for simulation failures."""
 
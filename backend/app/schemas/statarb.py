@@ -1,7 +1,7 @@
 """
 StatArb Pydantic schemas.
 """
-from typing import List
+from typing import List, Optional
 from pydantic import BaseModel
 
 class AnalysisRequest(BaseModel):
@@ -14,3 +14,13 @@ class SpreadPoint(BaseModel):
 class AnalysisResponse(BaseModel):
     message: str
     status: str
+
+class PairSignalPoint(BaseModel):
+    ticker_1: str
+    ticker_2: str
+    hedge_ratio: float
+    spread: float
+    z_score: float
+    position: int  # -1 short spread, 0 flat, +1 long spread
+    ready: bool  # rolling window full
+    as_of: Optional[str] = None  # date of the last committed bar
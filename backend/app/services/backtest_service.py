@@ -3,9 +3,11 @@ import numpy as np
 from datetime import date, timedelta
 from typing import Tuple, Dict, Any, List
 from app.services.ingestion import MarketDataService
+from app.services.price_panel import price_panel_store
 from app.schemas.backtest import BacktestRequest, BacktestResponse
 from app.models.market_data import DailyPrice, Ticker
 from sqlmodel import Session, select
+from app.core.config import settings
 from app.core.db import engine
 
 class BacktestService:
@@ -13,7 +15,13 @@ class BacktestService:
         self.market_service = MarketDataService()
 
     def get_data_for_ticker(self, ticker: str, start_date: date) -> pl.DataFrame:
-        """Fetch daily prices from DB and convert to Polars DataFrame"""
+        """Fetch daily prices from the price panel (or the DB) as a Polars DataFrame"""
+        panel = price_panel_store.frame([ticker], "close", start_date)
+        if panel is not None:
+            if panel.is_empty():
+                return pl.DataFrame({"date": [], "close": []})
+            return panel.rename({ticker: "close"})
+
         with Session(engine) as session:
              # Manual query using sqlmodel select to get raw data
              statement = (
@@ -57,81 +65,41 @@ class BacktestService:
             # Fallback (e.g. if len is too small)
             return 1.0
 
+    def _series(self, df: pl.DataFrame, hedge_ratio: float) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """Z-score, spread and invested capital arrays for the native kernel"""
+        z_scores = df["z_score"].to_numpy()
+        spread = df["spread"].to_numpy()
+        capital = (df["c1"] + hedge_ratio * df["c2"]).to_numpy()
+        return z_scores, spread, capital
+
     def _run_strategy(self, df: pl.DataFrame, entry_z: float, exit_z: float, stop_loss_z: float, hedge_ratio: float) -> Dict[str, Any]:
         """Run strategy for specific parameters and return metrics/curves"""
-        # Fast iteration for Signal State Machine
-        z_scores = df["z_score"].to_list()
-        
-        signals = [0] * len(z_scores)
-        position = 0 # 0, 1 (Long Spread), -1 (Short Spread)
-        
-        for i in range(len(z_scores)):
-            z = z_scores[i]
-            
-            if position == 0:
-                if z < -entry_z:
-                    position = 1 # Long Spread (Long A, Short B)
-                elif z > entry_z:
-                    position = -1 # Short Spread (Short A, Long B)
-            elif position == 1:
-                if z > -exit_z or z < -stop_z: # Revert to mean (profit) or Stop Loss
-                    position = 0
-            elif position == -1:
-                if z < exit_z or z > stop_z: # Revert to mean (profit) or Stop Loss
-                    position = 0
-            
-            signals[i] = position
-            
-        # PnL Calculation
-        df_strat = df.with_columns(pl.Series("position", signals))
-        
-        df_strat = df_strat.with_columns([
-            (pl.col("spread") - pl.col("spread").shift(1)).alias("spread_change"),
-            pl.col("c1").pct_change().fill_null(0).alias("ret_1"), # Benchmark Return
-            (pl.col("c1") + hedge_ratio * pl.col("c2")).alias("capital_inv")
-        ])
-        
-        df_strat = df_strat.with_columns([
-            (pl.col("position").shift(1).fill_null(0) * pl.col("spread_change") / pl.col("capital_inv")).alias("strat_ret")
-        ])
-        
-        df_strat = df_strat.drop_nulls()
-        
-        # Equity Curves
-        df_strat = df_strat.with_columns([
-            (1 + pl.col("strat_ret")).cum_prod().alias("equity_curve"),
-            (1 + pl.col("ret_1")).cum_prod().alias("benchmark_curve")
-        ])
-        
-        # Metrics
-        eq = df_strat["equity_curve"].to_numpy()
-        running_max = np.maximum.accumulate(eq)
-        drawdown = (eq - running_max) / running_max
-        
-        total_return = eq[-1] - 1
-        
-        daily_rets = df_strat["strat_ret"].to_numpy()
-        sharpe = 0.0
-        if np.std(daily_rets) > 0:
-            sharpe = (np.mean(daily_rets) / np.std(daily_rets)) * np.sqrt(252)
-            
-        wins = np.sum(daily_rets > 0)
-        total_trades = np.sum(daily_rets != 0)
-        win_rate = wins / total_trades if total_trades > 0 else 0
+        from app.engine import run_pairs_backtest
+
+        if run_pairs_backtest is None:
+            raise ImportError("Backtest engine not available. Run 'python backend/scripts/build_extension.py' to build.")
+
+        # Signal state machine, PnL and metrics run in C++
+        result = run_pairs_backtest(*self._series(df, hedge_ratio), entry_z, exit_z, stop_loss_z)
+        m = result.metrics
+
+        # Buy & hold ticker 1 over the same return days (the first day has none)
+        c1 = df["c1"].to_numpy()
+        benchmark_curve = c1[1:] / c1[0]
 
         return {
             "metrics": {
-                "total_return": float(total_return),
-                "sharpe_ratio": float(sharpe),
-                "max_drawdown": float(np.min(drawdown)),
-                "win_rate": float(win_rate),
+                "total_return": m.total_return,
+                "sharpe_ratio": m.sharpe_ratio,
+                "max_drawdown": m.max_drawdown,
+                "win_rate": m.win_rate,
                 "hedge_ratio": float(hedge_ratio),
-                "trades": int(total_trades)
+                "trades": m.trades
             },
-            "equity_curve": df_strat["equity_curve"].to_list(),
-            "benchmark_curve": df_strat["benchmark_curve"].to_list(),
-            "drawdown": drawdown.tolist(),
-            "dates": [d.isoformat() for d in df_strat["date"].to_list()]
+            "equity_curve": result.equity_curve.tolist(),
+            "benchmark_curve": benchmark_curve.tolist(),
+            "drawdown": result.drawdown.tolist(),
+            "dates": [d.isoformat() for d in df["date"].to_list()[1:]]
         }
 
     async def run_backtest(self, request: BacktestRequest) -> BacktestResponse:
@@ -179,6 +147,8 @@ class BacktestService:
         
         # 6. Grid Search (Optional)
         if request.entry_z_min is not None and request.entry_z_max is not None:
+            from app.engine import run_pairs_grid
+
             # Generate ranges
             entry_step = request.entry_z_step or 0.5
             exit_step = request.exit_z_step or 0.5
@@ -186,20 +156,27 @@ class BacktestService:
             entry_range = np.arange(request.entry_z_min, request.entry_z_max + 0.1, entry_step)
             exit_range = np.arange(request.exit_z_min, request.exit_z_max + 0.1, exit_step)
             
-            for ez in entry_range:
-                for ex in exit_range:
+            # Whole grid in one native call, cells in parallel
+            grid = run_pairs_grid(
+                *self._series(df, hedge_ratio),
+                entry_z=entry_range.tolist(),
+                exit_z=exit_range.tolist(),
+                stop_loss_z=request.stop_loss_z,
+                num_threads=settings.engine_num_threads,
+            )
+
+            for i, ez in enumerate(entry_range):
+                for j, ex in enumerate(exit_range):
                     if ex >= ez: continue # Skip invalid parameters (Exit >= Entry is usually nonsense for mean reversion)
-                    
-                    res = self._run_strategy(df, float(ez), float(ex), request.stop_loss_z, hedge_ratio)
-                    m = res["metrics"]
-                    
+
                     sensitivity_matrix.append({
                         "entry_z": float(ez),
                         "exit_z": float(ex),
-                        "sharpe_ratio": m["sharpe_ratio"],
-                        "total_return": m["total_return"],
-                        "win_rate": m["win_rate"],
-                        "trades": m["trades"]
+                        "sharpe_ratio": float(grid.sharpe_ratio[i, j]),
+                        "total_return": float(grid.total_return[i, j]),
+                        "max_drawdown": float(grid.max_drawdown[i, j]),
+                        "win_rate": float(grid.win_rate[i, j]),
+                        "trades": int(grid.trades[i, j])
                     })
 
         return BacktestResponse(
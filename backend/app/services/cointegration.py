@@ -3,15 +3,27 @@ Cointegration Service.
 
 Math engine for finding and analyzing cointegrated pairs for statistical arbitrage.
 """
-from typing import List, Tuple, Dict, Any
+from datetime import date, timedelta
+from typing import List, Tuple, Dict, Any, Optional
 import numpy as np
 import polars as pl
 import statsmodels.api as sm
 from statsmodels.tsa.stattools import coint, adfuller
 from sqlmodel import Session, select, delete
 
+from app.core.config import settings
 from app.models.market_data import DailyPrice
 from app.models.statarb import CointegratedPair
+from app.services.price_panel import price_panel_store
+
+# Minimum aligned observations for a pair test
+MIN_OBSERVATIONS = 30
+
+# Significance level of the Engle-Granger test
+MAX_P_VALUE = 0.05
+
+# Pairs whose price levels correlate less are not tested
+MIN_ABS_CORRELATION = 0.5
 
 
 class CointegrationService:
@@ -92,10 +104,18 @@ class CointegrationService:
             "spread_std": spread_std
         }
 
-    def prepare_data(self, tickers: List[str], session: Session) -> pl.DataFrame:
-        """Fetch and align data for multiple tickers."""
+    def prepare_data(self, tickers: List[str], session: Session, after: Optional[date] = None) -> pl.DataFrame:
+        """Fetch and align data for multiple tickers (only dates past `after` if given)."""
+        # Aligned and forward-filled by the price panel when it is available
+        start = after + timedelta(days=1) if after is not None else None
+        panel = price_panel_store.frame(tickers, "adjusted_close", start, forward_fill=True)
+        if panel is not None:
+            return panel
+
         # Fetch data
         statement = select(DailyPrice).where(DailyPrice.symbol.in_(tickers)).order_by(DailyPrice.trade_date)
+        if after is not None:
+            statement = statement.where(DailyPrice.trade_date > after)
         results = session.exec(statement).all()
         
         if not results:
@@ -141,44 +161,38 @@ class CointegrationService:
             return 0
             
         available_tickers = [c for c in df.columns if c != "date"]
-        pairs_found = 0
-        
-        # 2. Iterate Logic
-        n = len(available_tickers)
-        for i in range(n):
-            for j in range(i + 1, n):
-                t1 = available_tickers[i]
-                t2 = available_tickers[j]
-                
-                s1 = df[t1].to_numpy()
-                s2 = df[t2].to_numpy()
-                
-                # Check lengths match (they should from drop_nulls)
-                if len(s1) < 30: # Minimum data requirement
-                    continue
-                    
-                # 3. Calculate Cointegration
-                score, p_value, crit_val = self.calculate_cointegration(s1, s2)
-                
-                if p_value < 0.05:
-                    # Found a pair! Calculate metrics
-                    metrics = self.calculate_spread_metrics(s1, s2)
-                    
-                    # 4. Save to DB
-                    pair = CointegratedPair(
-                        ticker_1=t1,
-                        ticker_2=t2,
-                        p_value=p_value,
-                        hedge_ratio=metrics["hedge_ratio"],
-                        half_life=metrics["half_life"],
-                        last_z_score=metrics["last_z_score"],
-                        is_active=True
-                    )
-                    session.add(pair)
-                    pairs_found += 1
-        
+        if df.height < MIN_OBSERVATIONS:
+            return 0
+
+        from app.engine import screen_cointegrated_pairs
+
+        if screen_cointegrated_pairs is None:
+            raise ImportError("Cointegration engine not available. Run 'python backend/scripts/build_extension.py' to build.")
+
+        # 2. Screen every pair in one native call: correlation pre-filter,
+        # then hedge ratio, Engle-Granger ADF test and half-life, in parallel
+        prices = df.select(available_tickers).to_numpy()
+        pairs = screen_cointegrated_pairs(
+            prices,
+            max_p_value=MAX_P_VALUE,
+            min_abs_correlation=MIN_ABS_CORRELATION,
+            num_threads=settings.engine_num_threads,
+        )
+
+        # 3. Save to DB
+        for p in pairs:
+            session.add(CointegratedPair(
+                ticker_1=available_tickers[p.first],
+                ticker_2=available_tickers[p.second],
+                p_value=p.p_value,
+                hedge_ratio=p.hedge_ratio,
+                half_life=p.half_life,
+                last_z_score=p.last_z_score,
+                is_active=True
+            ))
+
         session.commit()
-        return pairs_found
+        return len(pairs)
 
     def get_spread_series(self, ticker1: str, ticker2: str, session: Session) -> List[Dict[str, Any]]:
         """Get z-score historical series for visualization."""
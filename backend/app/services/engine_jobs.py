@@ -0,0 +1,163 @@
+"""
+Engine job service.
+
+Runs CPU-heavy engine calls as jobs of the C++ job scheduler instead of
+FastAPI's shared threadpool. The scheduler runs at most one job per
+physical core, starts interactive jobs before batch ones and never lets
+batch jobs take the last worker, so bulk runs cannot starve request
+servicing. Each class has a bounded queue (settings.engine_max_queued_*);
+submitting to a full one raises EngineOverloaded, which endpoints turn
+into HTTP 503.
+
+Queue waits and run times are recorded in engine_metrics as the
+job_wait_<class> and job_run_<class> phases; scheduler_snapshot() has the
+scheduler's own counters. Without the compiled engine, jobs fall back to
+the threadpool (or a direct call) unchanged.
+"""
+from __future__ import annotations
+
+import asyncio
+import concurrent.futures
+import functools
+from typing import Any, Callable, Optional
+
+from fastapi.concurrency import run_in_threadpool
+
+from app.core.config import settings
+from app.engine import (
+    SchedulerOverloaded,
+    TaskPriority,
+    configure_scheduler,
+    scheduler_slots,
+    scheduler_stats,
+    submit_job,
+)
+from app.services.engine_metrics import engine_metrics
+
+INTERACTIVE = "interactive"
+BATCH = "batch"
+
+# SchedulerStats attributes reported per class
+STATS_FIELDS = (
+    "queued", "running", "submitted", "completed", "failed", "rejected", "cancelled",
+    "wait_seconds_total", "wait_seconds_max", "run_seconds_total", "run_seconds_max",
+)
+
+
+class _EngineNotBuilt(RuntimeError):
+    """Stand-in for SchedulerOverloaded; never raised."""
+
+
+# Raised at submission when the job's priority class has a full queue
+EngineOverloaded = SchedulerOverloaded if SchedulerOverloaded is not None else _EngineNotBuilt
+
+if configure_scheduler is not None:
+    configure_scheduler(
+        max_queued_interactive=settings.engine_max_queued_interactive,
+        max_queued_batch=settings.engine_max_queued_batch,
+    )
+
+
+def _task_priority(priority: str) -> Any:
+    if priority == INTERACTIVE:
+        return TaskPriority.Interactive
+    if priority == BATCH:
+        return TaskPriority.Batch
+    raise ValueError(f"Unknown engine job priority: {priority}")
+
+
+def submit_engine_job(fn: Callable[..., Any], *args: Any, priority: str = INTERACTIVE, **kwargs: Any) -> Any:
+    """
+    Queue fn(*args, **kwargs) on the engine scheduler without waiting.
+
+    fn runs on a native worker (taking the GIL for its Python parts) and
+    must not wait for another engine job.
+
+    Returns:
+        The EngineJob
+
+    Raises:
+        EngineOverloaded: If the priority class's queue is full
+        ImportError: If C++ engine is not built
+    """
+    if submit_job is None:
+        raise ImportError(
+            "Engine scheduler not available. "
+            "Run 'python backend/scripts/build_extension.py' to build."
+        )
+
+    job = submit_job(functools.partial(fn, *args, **kwargs), _task_priority(priority))
+
+    def observe() -> None:
+        if not job.cancelled():
+            engine_metrics.observe(f"job_wait_{priority}", job.queued_seconds)
+            engine_metrics.observe(f"job_run_{priority}", job.run_seconds)
+
+    job.add_done_callback(observe)
+    return job
+
+
+async def run_engine_job(fn: Callable[..., Any], *args: Any, priority: str = INTERACTIVE, **kwargs: Any) -> Any:
+    """
+    Await fn(*args, **kwargs) run as an engine job.
+
+    The event loop is woken by the worker that finishes the job. If the
+    awaiting task is cancelled, a job that has not started is withdrawn
+    (one already running finishes and its result is dropped).
+
+    Raises:
+        EngineOverloaded: If the priority class's queue is full
+        Whatever fn raises
+    """
+    if submit_job is None:
+        return await run_in_threadpool(fn, *args, **kwargs)
+
+    loop = asyncio.get_running_loop()
+    future = loop.create_future()
+    job = submit_engine_job(fn, *args, priority=priority, **kwargs)
+
+    def resolve() -> None:
+        if future.done():
+            return
+        try:
+            future.set_result(job.result())
+        except concurrent.futures.CancelledError:
+            future.cancel()
+        except Exception as e:
+            future.set_exception(e)
+
+    def wake() -> None:
+        try:
+            loop.call_soon_threadsafe(resolve)
+        except RuntimeError:
+            pass  # loop already closed
+
+    job.add_done_callback(wake)
+    try:
+        return await future
+    except asyncio.CancelledError:
+        job.cancel()
+        raise
+
+
+def run_engine_job_sync(fn: Callable[..., Any], *args: Any, priority: str = INTERACTIVE, **kwargs: Any) -> Any:
+    """
+    run_engine_job for synchronous callers (e.g. `def` endpoints already
+    on a threadpool thread): block until the job is done.
+
+    Must not be called from inside an engine job.
+    """
+    if submit_job is None:
+        return fn(*args, **kwargs)
+    return submit_engine_job(fn, *args, priority=priority, **kwargs).result()
+
+
+def scheduler_snapshot() -> Optional[dict]:
+    """Slots and per-class counters of the scheduler (None without the engine)."""
+    if scheduler_stats is None:
+        return None
+    classes = {}
+    for name in (INTERACTIVE, BATCH):
+        stats = scheduler_stats(_task_priority(name))
+        classes[name] = {field: getattr(stats, field) for field in STATS_FIELDS}
+    return {"slots": scheduler_slots(), "classes": classes}
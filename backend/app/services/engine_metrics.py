@@ -0,0 +1,118 @@
+"""
+Engine metrics service.
+
+Aggregates the per-run SimulationResult.timings of the C++ engine, plus
+the Python-side phases around it (the DailyPrice fetch in
+validate_and_prepare_params and the NumPy-to-JSON copy of the results),
+into fixed-bucket latency histograms for the system health endpoint.
+"""
+from __future__ import annotations
+
+import bisect
+import threading
+from typing import Any, Optional
+
+# Upper bounds (seconds) of the latency buckets; a final bucket holds the rest
+LATENCY_BUCKETS = (
+    0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+    0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0,
+)
+
+# Engine phases, as SimulationTimings attributes without the _seconds suffix
+ENGINE_PHASES = ("setup", "path", "step_stats", "final_stats", "histogram", "export", "total")
+
+
+class Histogram:
+    """Bucket counts plus count, sum and max of one series."""
+
+    def __init__(self, bounds: tuple = LATENCY_BUCKETS):
+        self.bounds = bounds
+        self.counts = [0] * (len(bounds) + 1)
+        self.count = 0
+        self.total = 0.0
+        self.max = 0.0
+
+    def observe(self, value: float) -> None:
+        self.counts[bisect.bisect_left(self.bounds, value)] += 1
+        self.count += 1
+        self.total += value
+        self.max = max(self.max, value)
+
+    def snapshot(self) -> dict:
+        return {
+            "bounds": list(self.bounds),
+            "counts": list(self.counts),
+            "count": self.count,
+            "sum": self.total,
+            "mean": self.total / self.count if self.count else 0.0,
+            "max": self.max,
+        }
+
+
+class EngineMetrics:
+    """Thread-safe registry of simulation phase histograms."""
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._reset()
+
+    def _reset(self) -> None:
+        self._phases: dict[str, Histogram] = {}
+        self._runs = 0
+        self._bytes = Histogram(bounds=tuple(float(1 << s) for s in range(20, 36, 2)))
+        self._paths_per_second = Histogram(bounds=(1e4, 1e5, 3e5, 1e6, 3e6, 1e7, 3e7, 1e8))
+        self._timings_enabled: Optional[bool] = None
+
+    def observe(self, phase: str, seconds: float) -> None:
+        """Add one measurement of a phase."""
+        with self._lock:
+            self._phases.setdefault(phase, Histogram()).observe(seconds)
+
+    def record_run(
+        self,
+        result: Any,
+        db_fetch_seconds: Optional[float] = None,
+        copy_seconds: Optional[float] = None,
+    ) -> None:
+        """
+        Add the timings of one engine run.
+
+        Args:
+            result: Engine SimulationResult
+            db_fetch_seconds: Time spent loading and validating price data
+            copy_seconds: Time spent converting the result to JSON types
+        """
+        timings = result.timings
+        with self._lock:
+            self._runs += 1
+            self._timings_enabled = timings.enabled
+            if timings.enabled:
+                for phase in ENGINE_PHASES:
+                    self._phases.setdefault(phase, Histogram()).observe(
+                        getattr(timings, f"{phase}_seconds")
+                    )
+                self._bytes.observe(float(timings.bytes_allocated))
+                self._paths_per_second.observe(timings.paths_per_second)
+            if db_fetch_seconds is not None:
+                self._phases.setdefault("db_fetch", Histogram()).observe(db_fetch_seconds)
+            if copy_seconds is not None:
+                self._phases.setdefault("result_copy", Histogram()).observe(copy_seconds)
+
+    def snapshot(self) -> dict:
+        """JSON-serializable state of every histogram."""
+        with self._lock:
+            return {
+                "runs": self._runs,
+                "timings_enabled": self._timings_enabled,
+                "phases": {name: h.snapshot() for name, h in self._phases.items()},
+                "bytes_allocated": self._bytes.snapshot(),
+                "paths_per_second": self._paths_per_second.snapshot(),
+            }
+
+    def clear(self) -> None:
+        with self._lock:
+            self._reset()
+
+
+# Shared by the simulation services (writers) and the system endpoint
+engine_metrics = EngineMetrics()
@@ -12,6 +12,7 @@ from sqlmodel import Session, select
 
 from app.models.market_data import DailyPrice, Ticker
 from app.services.data_providers import DataProvider, DataProviderError, YFinanceProvider
+from app.services.price_panel import price_panel_store
 
 
 class MarketDataService:
@@ -36,6 +37,7 @@ class MarketDataService:
         symbol: str,
         session: Session,
         start_date: date = date(2000, 1, 1),
+        refresh_panel: bool = True,
     ) -> int:
         """
         Synchronize historical data for a ticker.
@@ -44,11 +46,13 @@ class MarketDataService:
         1. If no data exists, fetches from start_date
         2. If data exists, fetches from last_date + 1 day
         3. Bulk inserts new records
+        4. Rewrites the price panel snapshot (if rows were added)
 
         Args:
             symbol: Ticker symbol to sync
             session: SQLModel session
             start_date: Default start date for initial sync
+            refresh_panel: Rewrite the price panel after inserting
 
         Returns:
             Number of rows inserted
@@ -86,8 +90,23 @@ class MarketDataService:
         # Bulk insert new rows
         rows_inserted = self._bulk_insert(symbol, df, session)
 
+        if refresh_panel and rows_inserted > 0:
+            self.refresh_price_panel(session)
+
         return rows_inserted
 
+    def refresh_price_panel(self, session: Session) -> None:
+        """
+        Rewrite the columnar price panel the engines read from.
+
+        A failure only leaves readers on the previous snapshot (or the
+        database), so it is reported rather than raised.
+        """
+        try:
+            price_panel_store.rebuild(session)
+        except Exception as e:
+            print(f"Price panel refresh failed: {e}")
+
     def _ensure_ticker_exists(self, symbol: str, session: Session) -> Ticker:
         """Ensure ticker record exists, create if not."""
         statement = select(Ticker).where(Ticker.symbol == symbol)
@@ -170,7 +189,7 @@ class MarketDataService:
         results = {}
         for symbol in symbols:
             try:
-                rows = self.sync_ticker(symbol, session, start_date)
+                rows = self.sync_ticker(symbol, session, start_date, refresh_panel=False)
                 results[symbol] = rows
                 print(f"Synced {symbol}: {rows} rows added")
             except DataProviderError as e:
@@ -180,4 +199,8 @@ class MarketDataService:
                 results[symbol] = -1
                 print(f"Error {symbol}: {e}")
 
+        # One panel rewrite for the whole batch
+        if any(rows > 0 for rows in results.values()):
+            self.refresh_price_panel(session)
+
         return results
@@ -10,6 +10,49 @@ from datetime import datetime, date
 from functools import lru_cache
 from typing import Dict, List, Any, Optional
 
+from app.core.config import settings
+from app.services.engine_jobs import EngineOverloaded, run_engine_job_sync
+
+# Plausible IV range; rows outside it are treated as bad quotes
+MIN_IV = 0.01
+MAX_IV = 3.0
+
+
+def _solve_implied_volatility(df: pd.DataFrame, spot_price: float, r: float) -> pd.DataFrame:
+    """
+    Replace impliedVolatility with IV backed out of the quotes.
+
+    Uses the bid/ask mid where both sides are quoted, else the last trade.
+    Rows the solver cannot price (no-arbitrage violations, no convergence)
+    and rows outside [MIN_IV, MAX_IV] are dropped.
+    """
+    try:
+        from app.engine import monte_carlo_engine
+
+        bid = df['bid'].to_numpy(dtype=np.float64)
+        ask = df['ask'].to_numpy(dtype=np.float64)
+        last = df['lastPrice'].to_numpy(dtype=np.float64)
+        price = np.where((bid > 0) & (ask > 0), 0.5 * (bid + ask), last)
+        expiries = np.maximum(df['daysToExpiry'].to_numpy(dtype=np.float64) / 365.0, 0.001)
+
+        solved = monte_carlo_engine.implied_volatility_batch(
+            price=price,
+            strike=df['strike'].to_numpy(dtype=np.float64),
+            time_to_expiry=expiries,
+            spot=spot_price,
+            risk_free_rate=r,
+            is_call=True
+        )
+
+        converged = solved.status == int(monte_carlo_engine.IvStatus.Converged)
+        df = df.assign(impliedVolatility=solved.volatility)[converged]
+    except ImportError:
+        print("IV solver not available (ImportError). Using yfinance impliedVolatility.")
+
+    mask = (df['impliedVolatility'] > MIN_IV) & (df['impliedVolatility'] < MAX_IV)
+    return df[mask].reset_index(drop=True)
+
+
 # Caching at module level to persist across request instances if service is instantiated per request
 # Caching removed for debugging
 # @lru_cache(maxsize=32)
@@ -44,13 +87,11 @@ def get_cached_options_data(ticker_symbol: str) -> Dict[str, Any]:
             if calls.empty:
                 continue
                 
-            # Filter garbage data
-            # Volume > 5, OI > 5, 0.01 < IV < 3.0
+            # Filter illiquid contracts
+            # Volume > 5, OI > 5 (IV range is checked after solving below)
             mask = (
                 (calls['volume'] > 5) & 
-                (calls['openInterest'] > 5) & 
-                (calls['impliedVolatility'] > 0.01) & 
-                (calls['impliedVolatility'] < 3.0)
+                (calls['openInterest'] > 5)
             )
             filtered_calls = calls[mask].copy()
             
@@ -66,8 +107,8 @@ def get_cached_options_data(ticker_symbol: str) -> Dict[str, Any]:
                 
             filtered_calls['daysToExpiry'] = days_to_expiry
             
-            # Keep relevant columns
-            all_calls.append(filtered_calls[['strike', 'daysToExpiry', 'impliedVolatility']])
+            # Keep relevant columns (quotes are needed to solve IV ourselves)
+            all_calls.append(filtered_calls[['strike', 'daysToExpiry', 'impliedVolatility', 'bid', 'ask', 'lastPrice']])
             
         except Exception as e:
             print(f"Error fetching expiry {exp_str}: {e}")
@@ -107,7 +148,21 @@ def get_cached_options_data(ticker_symbol: str) -> Dict[str, Any]:
         else:
             spot_price = 100.0 # Fallback default
     
-    # Calculate Greeks via C++ Engine
+    # Ensure spot_price is float
+    if spot_price is None:
+        spot_price = 100.0
+    spot_price = float(spot_price)
+
+    # Assuming Risk Free Rate = 4.5%
+    r = 0.045
+
+    # Back out IV from quotes via C++ Engine instead of trusting yfinance's
+    # impliedVolatility column; falls back to it if the engine is missing
+    final_df = _solve_implied_volatility(final_df, spot_price, r)
+    if final_df.empty:
+        return {"x": [], "y": [], "z": [], "error": "No valid data after filtering"}
+
+    # Calculate Greeks via C++ Engine (one batched call for the whole chain)
     num_rows = len(final_df)
     deltas = [0.0] * num_rows
     gammas = [0.0] * num_rows
@@ -118,42 +173,34 @@ def get_cached_options_data(ticker_symbol: str) -> Dict[str, Any]:
     try:
         from app.engine import monte_carlo_engine
         
-        # Ensure spot_price is float
-        if spot_price is None:
-            spot_price = 100.0
-        spot_price = float(spot_price)
-
-        for i, (_, row) in enumerate(final_df.iterrows()):
-            try:
-                k = float(row['strike'])
-                # avoid division by zero if daysToExpiry is 0 (though we filtered <=0)
-                t = max(float(row['daysToExpiry']) / 365.0, 0.001)
-                sigma = float(row['impliedVolatility'])
-                
-                # Assuming Risk Free Rate = 4.5%
-                r = 0.045
-                
-                greeks = monte_carlo_engine.calculate_greeks(
-                    strike=k,
-                    time_to_expiry=t,
-                    spot=spot_price,
-                    risk_free_rate=r,
-                    volatility=sigma,
-                    is_call=True
-                )
-                
-                deltas[i] = greeks.delta
-                gammas[i] = greeks.gamma
-                vegas[i] = greeks.vega
-                thetas[i] = greeks.theta
-                rhos[i] = greeks.rho
-            except Exception as e_row:
-                # Log occasional row error but continue
-                print(f"Row {i} error: {e_row}")
-                continue
+        strikes = final_df['strike'].to_numpy(dtype=np.float64)
+        # avoid division by zero if daysToExpiry is 0 (though we filtered <=0)
+        expiries = np.maximum(final_df['daysToExpiry'].to_numpy(dtype=np.float64) / 365.0, 0.001)
+        sigmas = final_df['impliedVolatility'].to_numpy(dtype=np.float64)
+
+        # Spot and rate broadcast over the chain; an engine job, so it queues
+        # with the simulations instead of competing with them
+        greeks = run_engine_job_sync(
+            monte_carlo_engine.calculate_greeks_batch,
+            strike=strikes,
+            time_to_expiry=expiries,
+            spot=spot_price,
+            risk_free_rate=r,
+            volatility=sigmas,
+            is_call=True
+        )
+
+        deltas = greeks.delta.tolist()
+        gammas = greeks.gamma.tolist()
+        vegas = greeks.vega.tolist()
+        thetas = greeks.theta.tolist()
+        rhos = greeks.rho.tolist()
             
     except ImportError:
         print("Greeks engine not available (ImportError). Using zeros.")
+    except EngineOverloaded:
+        # A full queue is not a chain without Greeks; let the request fail with 503
+        raise
     except Exception as e:
         print(f"Error initializing Greeks engine: {e}")
     
@@ -168,9 +215,83 @@ def get_cached_options_data(ticker_symbol: str) -> Dict[str, Any]:
         "rho": rhos
     }
 
+def price_american_chain(
+    spot: float,
+    risk_free_rate: float,
+    strike: np.ndarray,
+    time_to_expiry: np.ndarray,
+    volatility: np.ndarray,
+    is_call: np.ndarray,
+    dividend_yield: float = 0.0,
+    num_simulations: int = 50_000,
+    exercise_dates: int = 50,
+    seed: int = 0,
+) -> Dict[str, List[float]]:
+    """
+    Longstaff-Schwartz prices and Greeks of American options, one engine
+    call for the whole chain.
+
+    Raises:
+        ImportError: If C++ engine is not built
+        EngineOverloaded: If the engine scheduler's queue is full
+    """
+    from app.engine import price_american_batch
+
+    if price_american_batch is None:
+        raise ImportError(
+            "Options engine not available. "
+            "Run 'python backend/scripts/build_extension.py' to build."
+        )
+
+    # Spot, rate and yield broadcast over the chain
+    result = run_engine_job_sync(
+        price_american_batch,
+        strike=strike,
+        time_to_expiry=time_to_expiry,
+        spot=spot,
+        risk_free_rate=risk_free_rate,
+        volatility=volatility,
+        dividend_yield=dividend_yield,
+        is_call=is_call,
+        num_simulations=num_simulations,
+        exercise_dates=exercise_dates,
+        seed=seed,
+        num_threads=settings.engine_num_threads,
+    )
+
+    return {
+        "price": result.price.tolist(),
+        "standard_error": result.standard_error.tolist(),
+        "delta": result.delta.tolist(),
+        "gamma": result.gamma.tolist(),
+        "vega": result.vega.tolist(),
+        "theta": result.theta.tolist(),
+        "rho": result.rho.tolist(),
+    }
+
+
 class OptionsService:
     def get_iv_surface(self, ticker: str) -> Dict[str, Any]:
         """
         Get IV surface data for a ticker.
         """
         return get_cached_options_data(ticker.upper())
+
+    def price_american(self, request: Any) -> Dict[str, Any]:
+        """
+        Price an American option chain (AmericanChainRequest).
+        """
+        contracts = request.contracts
+        priced = price_american_chain(
+            spot=request.spot,
+            risk_free_rate=request.risk_free_rate,
+            strike=np.array([c.strike for c in contracts], dtype=np.float64),
+            time_to_expiry=np.array([c.days_to_expiry / 365.0 for c in contracts], dtype=np.float64),
+            volatility=np.array([c.volatility for c in contracts], dtype=np.float64),
+            is_call=np.array([c.is_call for c in contracts], dtype=bool),
+            dividend_yield=request.dividend_yield,
+            num_simulations=request.num_simulations,
+            exercise_dates=request.exercise_dates,
+            seed=request.seed or 0,
+        )
+        return {**priced, "count": len(contracts)}
@@ -0,0 +1,146 @@
+"""
+Live pair signal service.
+
+Keeps one native PairSignal per active CointegratedPair. Each is seeded
+once from the aligned price history; after that, new daily closes are
+applied in O(1) each and stream ticks are previewed against the bar in
+progress, so live z-scores and entry/exit signals never recompute the
+history.
+"""
+from __future__ import annotations
+
+import threading
+from dataclasses import dataclass
+from datetime import date
+from typing import Any, Dict, List, Optional
+
+from sqlmodel import Session, select
+
+from app.models.statarb import CointegratedPair
+from app.services.cointegration import CointegrationService
+
+# Rolling window of the spread z-score (the backtest lookback default)
+DEFAULT_WINDOW = 30
+
+# Signal thresholds (the backtest defaults)
+DEFAULT_ENTRY_Z = 2.0
+DEFAULT_EXIT_Z = 0.0
+DEFAULT_STOP_LOSS_Z = 4.0
+
+
+@dataclass
+class _TrackedPair:
+    ticker_1: str
+    ticker_2: str
+    signal: Any  # engine PairSignal
+    last_date: Optional[date]
+    last_close: Dict[str, float]
+
+
+class PairSignalMonitor:
+    """Rolling z-score state of every active pair, shared by the process."""
+
+    def __init__(
+        self,
+        window: int = DEFAULT_WINDOW,
+        entry_z: float = DEFAULT_ENTRY_Z,
+        exit_z: float = DEFAULT_EXIT_Z,
+        stop_loss_z: float = DEFAULT_STOP_LOSS_Z,
+    ):
+        self.window = window
+        self.entry_z = entry_z
+        self.exit_z = exit_z
+        self.stop_loss_z = stop_loss_z
+        self._pairs: Dict[int, _TrackedPair] = {}
+        self._ticks: Dict[str, float] = {}
+        self._lock = threading.Lock()
+        self._data = CointegrationService()
+
+    def refresh(self, session: Session) -> None:
+        """
+        Track the active pairs and apply any daily closes since the last refresh.
+
+        New pairs replay their full history once; known pairs only fetch and
+        push the bars after their last committed date.
+        """
+        from app.engine import PairSignal
+
+        if PairSignal is None:
+            raise ImportError("Engine not available. Run 'python backend/scripts/build_extension.py' to build.")
+
+        active = session.exec(select(CointegratedPair).where(CointegratedPair.is_active == True)).all()
+
+        with self._lock:
+            active_ids = {p.id for p in active}
+            for pair_id in list(self._pairs):
+                if pair_id not in active_ids:
+                    del self._pairs[pair_id]
+
+            for pair in active:
+                tracked = self._pairs.get(pair.id)
+                if tracked is None:
+                    tracked = _TrackedPair(
+                        ticker_1=pair.ticker_1,
+                        ticker_2=pair.ticker_2,
+                        signal=PairSignal(
+                            hedge_ratio=pair.hedge_ratio,
+                            window=self.window,
+                            entry_z=self.entry_z,
+                            exit_z=self.exit_z,
+                            stop_loss_z=self.stop_loss_z,
+                        ),
+                        last_date=None,
+                        last_close={},
+                    )
+                    self._pairs[pair.id] = tracked
+
+                df = self._data.prepare_data([pair.ticker_1, pair.ticker_2], session, after=tracked.last_date)
+                if df.width < 3 or df.is_empty():  # date + 2 tickers
+                    continue
+
+                s1 = df[pair.ticker_1].to_numpy()
+                s2 = df[pair.ticker_2].to_numpy()
+                tracked.signal.seed(s1, s2)
+                tracked.last_date = df["date"][-1]
+                tracked.last_close = {pair.ticker_1: float(s1[-1]), pair.ticker_2: float(s2[-1])}
+
+    def signals(self) -> List[Dict[str, Any]]:
+        """Committed state of every tracked pair (as of its last daily close)."""
+        with self._lock:
+            return [self._describe(t, t.signal.state) for t in self._pairs.values()]
+
+    def on_tick(self, symbol: str, price: float) -> List[Dict[str, Any]]:
+        """
+        Preview the signal of every pair containing symbol at a live price.
+
+        The other leg uses its latest tick, or its last close if none was
+        seen. Nothing is committed: the bar in progress only becomes part of
+        the window when its close is ingested and refresh() runs.
+        """
+        with self._lock:
+            self._ticks[symbol] = price
+            previews = []
+            for t in self._pairs.values():
+                if symbol not in (t.ticker_1, t.ticker_2) or not t.last_close:
+                    continue
+                p1 = self._ticks.get(t.ticker_1, t.last_close[t.ticker_1])
+                p2 = self._ticks.get(t.ticker_2, t.last_close[t.ticker_2])
+                previews.append(self._describe(t, t.signal.preview(p1, p2)))
+            return previews
+
+    @staticmethod
+    def _describe(tracked: _TrackedPair, state: Any) -> Dict[str, Any]:
+        return {
+            "ticker_1": tracked.ticker_1,
+            "ticker_2": tracked.ticker_2,
+            "hedge_ratio": tracked.signal.hedge_ratio,
+            "spread": state.spread,
+            "z_score": state.z_score,
+            "position": state.position,
+            "ready": state.ready,
+            "as_of": tracked.last_date.isoformat() if tracked.last_date else None,
+        }
+
+
+# Shared by the statarb endpoints and the live price stream
+pair_signal_monitor = PairSignalMonitor()
@@ -0,0 +1,61 @@
+"""
+Reader of the engine's binary path files.
+
+run_monte_carlo(export_path=...) streams every simulated path to a
+"STRATAPT" file (layout in backend/core/include/path_export.h): a 64-byte
+header, the exported step indices, then one row of all paths per step.
+read_path_export maps it without loading it, so multi-GB exports open
+instantly and only the slices used are paged in.
+"""
+from __future__ import annotations
+
+import struct
+from dataclasses import dataclass
+
+import numpy as np
+
+MAGIC = b"STRATAPT"
+VERSION = 1
+
+# magic, version, header_size, value_bytes, step_stride,
+# num_paths, num_steps, num_points, values_offset, reserved
+_HEADER = struct.Struct("<8sIIIIQQQQQ")
+
+
+@dataclass(frozen=True)
+class PathExport:
+    """A mapped path file."""
+
+    steps: np.ndarray  # exported step indices (num_points,)
+    values: np.memmap  # prices (num_points, num_paths); .T is one row per path
+    num_steps: int  # steps simulated
+    step_stride: int
+
+    @property
+    def num_paths(self) -> int:
+        return self.values.shape[1]
+
+
+def read_path_export(path: str) -> PathExport:
+    """
+    Map a path file written by the engine.
+
+    Raises:
+        ValueError: If the file is not a path file of a known version
+    """
+    with open(path, "rb") as f:
+        raw = f.read(_HEADER.size)
+    if len(raw) < _HEADER.size:
+        raise ValueError(f"{path} is not a path file")
+
+    (magic, version, header_size, value_bytes, step_stride,
+     num_paths, num_steps, num_points, values_offset, _) = _HEADER.unpack(raw)
+    if magic != MAGIC or header_size != _HEADER.size:
+        raise ValueError(f"{path} is not a path file")
+    if version != VERSION:
+        raise ValueError(f"{path} has unsupported path file version {version}")
+
+    dtype = np.float32 if value_bytes == 4 else np.float64
+    steps = np.fromfile(path, dtype="<i4", count=num_points, offset=header_size)
+    values = np.memmap(path, dtype=dtype, mode="r", offset=values_offset, shape=(num_points, num_paths))
+    return PathExport(steps=steps, values=values, num_steps=num_steps, step_stride=step_stride)
@@ -0,0 +1,162 @@
+"""
+Columnar price panel service.
+
+Keeps a memory-mapped (dates x symbols) snapshot of DailyPrice that
+ingestion rewrites after every sync. Services read aligned series from it
+through the engine's PricePanel (NumPy views into the mapping) instead of
+hydrating ORM rows; while the engine or the snapshot is unavailable they
+fall back to querying the database.
+"""
+from __future__ import annotations
+
+import os
+import threading
+from datetime import date
+from typing import Any, Optional, Sequence
+
+import numpy as np
+import polars as pl
+from sqlmodel import Session, select
+
+from app.core.config import settings
+from app.models.market_data import DailyPrice
+
+# Price fields stored in the panel, in file order
+PANEL_FIELDS = ("adjusted_close", "close")
+
+_EPOCH_ORDINAL = date(1970, 1, 1).toordinal()
+
+
+def _days(d: date) -> int:
+    """Days since 1970-01-01 (the panel date encoding)."""
+    return d.toordinal() - _EPOCH_ORDINAL
+
+
+class PricePanelStore:
+    """Owner of the panel snapshot file and its current mapping."""
+
+    def __init__(self, path: str):
+        self.path = path
+        self._lock = threading.Lock()
+        self._write_lock = threading.Lock()  # one rebuild at a time
+        self._panel: Any = None  # engine PricePanel
+        self._stamp: Optional[tuple] = None
+
+    def rebuild(self, session: Session) -> int:
+        """
+        Rewrite the snapshot from the full DailyPrice table.
+
+        Selects plain columns (no ORM objects) and scatters them into one
+        (fields, symbols, dates) array; the engine writes the file next to
+        the old one and renames it into place, so open mappings keep their
+        snapshot.
+
+        Returns:
+            Number of symbols written
+        """
+        from app.engine import write_price_panel
+
+        if write_price_panel is None:
+            raise ImportError("Engine not available. Run 'python backend/scripts/build_extension.py' to build.")
+
+        with self._write_lock:
+            rows = session.exec(
+                select(DailyPrice.symbol, DailyPrice.trade_date, DailyPrice.adjusted_close, DailyPrice.close)
+            ).all()
+            if not rows:
+                return 0
+
+            df = pl.DataFrame(rows, schema=["symbol", "date", *PANEL_FIELDS], orient="row")
+            dates = df["date"].unique().sort()
+            symbols = df["symbol"].unique().sort()
+
+            date_index = np.searchsorted(dates.to_numpy(), df["date"].to_numpy())
+            symbol_index = np.searchsorted(symbols.to_numpy(), df["symbol"].to_numpy())
+            values = np.full((len(PANEL_FIELDS), len(symbols), len(dates)), np.nan)
+            for f, field in enumerate(PANEL_FIELDS):
+                values[f, symbol_index, date_index] = df[field].cast(pl.Float64).to_numpy()
+
+            os.makedirs(os.path.dirname(os.path.abspath(self.path)), exist_ok=True)
+            write_price_panel(
+                self.path,
+                dates.cast(pl.Int32).to_numpy().astype(np.int64),
+                symbols.to_list(),
+                list(PANEL_FIELDS),
+                values,
+            )
+            return len(symbols)
+
+    def ensure(self, session: Session) -> None:
+        """Build the snapshot if it does not exist yet."""
+        if not os.path.exists(self.path):
+            self.rebuild(session)
+
+    def panel(self) -> Any:
+        """
+        The mapped snapshot, reopened whenever the file was replaced.
+
+        Returns None if the engine or the file is unavailable.
+        """
+        from app.engine import PricePanel
+
+        if PricePanel is None:
+            return None
+        try:
+            st = os.stat(self.path)
+        except OSError:
+            return None
+
+        stamp = (st.st_ino, st.st_mtime_ns, st.st_size)
+        with self._lock:
+            if self._panel is None or stamp != self._stamp:
+                try:
+                    self._panel = PricePanel(self.path)
+                except (RuntimeError, ValueError) as e:
+                    print(f"Price panel unavailable: {e}")
+                    self._panel = None
+                    return None
+                self._stamp = stamp
+            return self._panel
+
+    def frame(
+        self,
+        symbols: Sequence[str],
+        field: str = "adjusted_close",
+        start: Optional[date] = None,
+        end: Optional[date] = None,
+        forward_fill: bool = False,
+    ) -> Optional[pl.DataFrame]:
+        """
+        Wide frame [date, *symbols] of one field over [start, end].
+
+        Rows follow PricePanel.align: an inner join of the symbols' bars,
+        or forward-filled gaps with forward_fill.
+
+        Returns None if the panel is unavailable or lacks any of the
+        symbols (use the database): the snapshot can trail the table, so a
+        missing symbol says nothing about whether it has data.
+        """
+        panel = self.panel()
+        if panel is None:
+            return None
+
+        present = list(dict.fromkeys(symbols))
+        if not present or any(s not in panel for s in present):
+            return None
+
+        aligned = panel.align(
+            present,
+            field,
+            _days(start) if start is not None else None,
+            _days(end) if end is not None else None,
+            forward_fill,
+        )
+        values = aligned.values
+        columns = {"date": pl.Series("date", aligned.dates).cast(pl.Int32).cast(pl.Date)}
+        for j, symbol in enumerate(present):
+            columns[symbol] = pl.Series(symbol, values[:, j])
+        return pl.DataFrame(columns)
+
+
+# Shared by ingestion (writer) and the data-access services (readers)
+price_panel_store = PricePanelStore(settings.price_panel_path)
@@ -0,0 +1,101 @@
+"""
+In-process cache of simulation summaries.
+
+Seeded simulations are deterministic: the same request over the same price
+history gives the same result for any thread count. SimulationCache keeps
+recent summaries so identical dashboard requests skip the engine (and the
+DB fetch and return computation) entirely.
+
+Entries are evicted least-recently-used first, both past a maximum entry
+count and past an approximate memory budget.
+"""
+
+from __future__ import annotations
+
+import sys
+import threading
+from collections import OrderedDict
+from typing import Any, Hashable
+
+# Approximate size of a Python float/int and of a list slot, in bytes
+_NUMBER_BYTES = 24
+_SLOT_BYTES = 8
+
+
+def approximate_size(value: Any) -> int:
+    """Approximate memory held by a JSON-like value (dicts, lists, numbers, strings)."""
+    if isinstance(value, dict):
+        return sys.getsizeof(value) + sum(
+            approximate_size(k) + approximate_size(v) for k, v in value.items()
+        )
+    if isinstance(value, (list, tuple)):
+        if value and all(isinstance(v, (int, float)) for v in value):
+            return sys.getsizeof(value) + len(value) * _NUMBER_BYTES
+        return sys.getsizeof(value) + sum(approximate_size(v) for v in value)
+    if isinstance(value, (int, float)):
+        return _NUMBER_BYTES
+    return sys.getsizeof(value)
+
+
+class SimulationCache:
+    """
+    Thread-safe LRU cache with an entry limit and a memory budget.
+
+    Values are shared between hits and must not be mutated by callers.
+    """
+
+    def __init__(self, max_entries: int, max_bytes: int):
+        self.max_entries = max_entries
+        self.max_bytes = max_bytes
+        self._entries: OrderedDict[Hashable, tuple[Any, int]] = OrderedDict()
+        self._bytes = 0
+        self._hits = 0
+        self._misses = 0
+        self._lock = threading.Lock()
+
+    def get(self, key: Hashable) -> Any | None:
+        """Cached value for key (marked most recently used), or None."""
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is None:
+                self._misses += 1
+                return None
+            self._entries.move_to_end(key)
+            self._hits += 1
+            return entry[0]
+
+    def put(self, key: Hashable, value: Any) -> None:
+        """Store value under key, evicting the least recently used entries as needed."""
+        size = approximate_size(value)
+        if self.max_entries <= 0 or size > self.max_bytes:
+            return
+
+        with self._lock:
+            old = self._entries.pop(key, None)
+            if old is not None:
+                self._bytes -= old[1]
+
+            self._entries[key] = (value, size)
+            self._bytes += size
+
+            while len(self._entries) > self.max_entries or self._bytes > self.max_bytes:
+                _, (_, evicted) = self._entries.popitem(last=False)
+                self._bytes -= evicted
+
+    def clear(self) -> None:
+        """Drop every entry."""
+        with self._lock:
+            self._entries.clear()
+            self._bytes = 0
+
+    def stats(self) -> dict:
+        """Entry count, approximate bytes held and hit/miss counts."""
+        with self._lock:
+            return {
+                "entries": len(self._entries),
+                "bytes": self._bytes,
+                "max_entries": self.max_entries,
+                "max_bytes": self.max_bytes,
+                "hits": self._hits,
+                "misses": self._misses,
+            }
@@ -8,17 +8,22 @@ market data before passing to the C++ Monte Carlo engine.
 from __future__ import annotations
 
 import math
-from dataclasses import dataclass
+import time
+from dataclasses import dataclass, fields
 from datetime import date
 from typing import TYPE_CHECKING
 
 import polars as pl
-from sqlmodel import Session, select
+from sqlmodel import Session, func, select
 
+from app.core.config import settings
 from app.models.market_data import DailyPrice
+from app.services.engine_metrics import engine_metrics
+from app.services.price_panel import price_panel_store
+from app.services.simulation_cache import SimulationCache
 
 if TYPE_CHECKING:
-    from app.engine import SimulationResult
+    from app.engine import ProgressiveSimulation, SimulationResult
 
 
 # ==============================================================================
@@ -34,6 +39,39 @@ TRADING_DAYS_PER_YEAR = 252
 # Daily time increment (as double precision - critical!)
 DAILY_DT = 1.0 / 252.0
 
+# Percentile bands returned for fan charts
+DEFAULT_QUANTILES = (0.01, 0.05, 0.25, 0.50, 0.75, 0.95, 0.99)
+
+# Confidence levels for VaR / CVaR / drawdown (95% and 99% are always included)
+DEFAULT_CONFIDENCE_LEVELS = (0.95, 0.99)
+
+# Paths of the pilot run that sizes a simulation to a target standard error
+PILOT_SIMULATIONS = 2_000
+
+# Upper bound on the path count chosen for a target standard error
+MAX_SIMULATIONS = 100_000
+
+# A progressive simulation sends about this many snapshots...
+PROGRESSIVE_SNAPSHOTS = 20
+
+# ...of at least this many paths each
+MIN_PROGRESSIVE_CHUNK = 10_000
+
+# Engine VarianceReduction value names, by request name
+VARIANCE_REDUCTION_MODES = {
+    "none": "Plain",
+    "antithetic": "Antithetic",
+    "control_variate": "ControlVariate",
+    "sobol": "Sobol",
+}
+
+
+# Summaries of seeded runs, shared by all requests of the process
+simulation_cache = SimulationCache(
+    max_entries=settings.simulation_cache_entries,
+    max_bytes=settings.simulation_cache_mb * 1024 * 1024,
+)
+
 
 # ==============================================================================
 # Data Classes
@@ -64,6 +102,46 @@ class SimulationRequest:
     num_steps: int = 252  # 1 year of trading days
     histogram_bins: int = 50
     seed: int = 0
+    quantiles: tuple[float, ...] = DEFAULT_QUANTILES
+    confidence_levels: tuple[float, ...] = DEFAULT_CONFIDENCE_LEVELS
+    include_final_prices: bool = False
+    variance_reduction: str = "none"  # Key of VARIANCE_REDUCTION_MODES
+    target_standard_error: float | None = None  # Overrides num_simulations
+    output_stride: int = 1  # Aggregate every k-th step plus the final one
+
+
+@dataclass
+class BatchSimulationRequest:
+    """Input request for one simulation per ticker with shared options."""
+
+    tickers: tuple[str, ...]
+    start_date: date
+    end_date: date
+    num_simulations: int = 10_000
+    num_steps: int = 252
+    histogram_bins: int = 50
+    seed: int = 0
+    quantiles: tuple[float, ...] = DEFAULT_QUANTILES
+    confidence_levels: tuple[float, ...] = DEFAULT_CONFIDENCE_LEVELS
+    include_final_prices: bool = False
+    variance_reduction: str = "none"  # Key of VARIANCE_REDUCTION_MODES
+    output_stride: int = 1
+
+
+@dataclass
+class PortfolioSimulationRequest:
+    """Input request for a correlated portfolio simulation."""
+
+    tickers: tuple[str, ...]
+    weights: tuple[float, ...]  # Fraction of initial_value per ticker
+    initial_value: float = 10_000.0
+    num_simulations: int = 10_000
+    num_steps: int = 252
+    histogram_bins: int = 50
+    seed: int = 0
+    quantiles: tuple[float, ...] = DEFAULT_QUANTILES
+    confidence_levels: tuple[float, ...] = DEFAULT_CONFIDENCE_LEVELS
+    include_final_prices: bool = False
 
 
 # ==============================================================================
@@ -78,7 +156,7 @@ def fetch_price_data(
     end_date: date,
 ) -> pl.DataFrame:
     """
-    Fetch daily price data from the database.
+    Fetch daily price data from the price panel (or the database).
 
     Args:
         session: SQLModel database session
@@ -86,10 +164,19 @@ def fetch_price_data(
         start_date: Start date (inclusive)
         end_date: End date (inclusive)
 
+    The panel is only used while it matches data_version() of the window,
+    so results cached under that version never come from a stale snapshot.
+
     Returns:
         Polars DataFrame with columns [trade_date, adjusted_close]
         sorted by date ascending.
     """
+    panel = price_panel_store.frame([ticker], "adjusted_close", start_date, end_date)
+    if panel is not None and _panel_version(panel) == data_version(session, ticker, start_date, end_date):
+        if panel.is_empty():
+            return pl.DataFrame(schema={"trade_date": pl.Date, "adjusted_close": pl.Float64})
+        return panel.rename({"date": "trade_date", ticker: "adjusted_close"})
+
     statement = (
         select(DailyPrice)
         .where(DailyPrice.symbol == ticker)
@@ -250,6 +337,104 @@ def validate_and_prepare_params(
     )
 
 
+def _confidence_levels(request: SimulationRequest | PortfolioSimulationRequest) -> list[float]:
+    """Requested confidence levels plus the 95%/99% levels of the summary."""
+    return sorted(set(request.confidence_levels) | set(DEFAULT_CONFIDENCE_LEVELS))
+
+
+def _variance_reduction(request: SimulationRequest):
+    """Engine VarianceReduction value of a request."""
+    from app.engine import VarianceReduction
+
+    if request.variance_reduction not in VARIANCE_REDUCTION_MODES:
+        raise ValueError(f"Unknown variance reduction: {request.variance_reduction}")
+    return getattr(VarianceReduction, VARIANCE_REDUCTION_MODES[request.variance_reduction])
+
+
+def _path_precision():
+    """Engine PathPrecision of the step rows (settings.engine_float32_paths)."""
+    from app.engine import PathPrecision
+
+    return PathPrecision.Float32 if settings.engine_float32_paths else PathPrecision.Double
+
+
+def _output_options(request: SimulationRequest | BatchSimulationRequest) -> dict:
+    """
+    Engine output_stride and log_space of a request. Log-space generation
+    only exponentiates at aggregated steps, so it pays off once steps are
+    skipped.
+    """
+    return {
+        "output_stride": request.output_stride,
+        "log_space": request.output_stride > 1,
+    }
+
+
+def _simulate(
+    params: SimulationParams,
+    request: SimulationRequest,
+) -> tuple["SimulationResult", int]:
+    """
+    Run the C++ engine on validated parameters.
+
+    With a target standard error, a pilot run of PILOT_SIMULATIONS paths
+    measures the standard error under the requested variance reduction and
+    the path count is scaled to reach the target (standard error ~ 1/sqrt(n)),
+    capped at MAX_SIMULATIONS.
+
+    Returns:
+        Tuple of (SimulationResult, number of paths simulated)
+    """
+    # Import here to fail fast with clear error if not built
+    from app.engine import PathStorage, run_monte_carlo
+
+    if run_monte_carlo is None:
+        raise ImportError(
+            "Monte Carlo engine not available. "
+            "Run 'python backend/scripts/build_extension.py' to build."
+        )
+
+    variance_reduction = _variance_reduction(request)
+
+    def simulate(num_simulations: int, **options) -> "SimulationResult":
+        return run_monte_carlo(
+            s0=params.s0,
+            mu=params.mu,
+            sigma=params.sigma,
+            num_simulations=num_simulations,
+            num_steps=request.num_steps,
+            dt=DAILY_DT,  # Critical: use double precision!
+            seed=request.seed,
+            # Only aggregates are returned, so never hold the full path matrix
+            storage=PathStorage.Streaming,
+            path_precision=_path_precision(),
+            **_output_options(request),
+            # Output is identical for any thread count; the GIL is released
+            num_threads=settings.engine_num_threads,
+            variance_reduction=variance_reduction,
+            **options,
+        )
+
+    num_simulations = request.num_simulations
+    if request.target_standard_error is not None:
+        pilot = simulate(PILOT_SIMULATIONS)
+        ratio = pilot.standard_error / request.target_standard_error
+        num_simulations = min(
+            max(math.ceil(PILOT_SIMULATIONS * ratio * ratio), PILOT_SIMULATIONS),
+            MAX_SIMULATIONS,
+        )
+
+    result = simulate(
+        num_simulations,
+        histogram_bins=request.histogram_bins,
+        quantiles=list(request.quantiles),
+        confidence_levels=_confidence_levels(request),
+        keep_final_prices=request.include_final_prices,
+    )
+
+    return result, num_simulations
+
+
 def run_simulation(
     session: Session,
     request: SimulationRequest,
@@ -270,8 +455,42 @@ def run_simulation(
         ValueError: If data validation fails
         ImportError: If C++ engine is not built
     """
-    # Import here to fail fast with clear error if not built
-    from app.engine import run_monte_carlo
+    params = validate_and_prepare_params(session, request)
+    result, _ = _simulate(params, request)
+    return result
+
+
+def export_simulation_paths(
+    session: Session,
+    request: SimulationRequest,
+    path: str,
+    float32: bool = True,
+    step_stride: int = 1,
+) -> SimulationParams:
+    """
+    Simulate a request and write every path to a binary file.
+
+    The engine streams the rows to path as it generates them (streaming
+    storage, so memory stays O(num_simulations)); read it back with
+    app.services.path_export.read_path_export. The paths are those of
+    run_simulation with the same request.
+
+    Args:
+        session: Database session for fetching price data
+        request: Simulation request (target_standard_error and output_stride
+            are ignored)
+        path: Destination file, replaced once complete
+        float32: Store prices as float32
+        step_stride: Export every k-th step plus the final one
+
+    Returns:
+        The validated parameters the paths were simulated with
+
+    Raises:
+        ValueError: If data validation fails
+        ImportError: If C++ engine is not built
+    """
+    from app.engine import PathPrecision, PathStorage, run_monte_carlo
 
     if run_monte_carlo is None:
         raise ImportError(
@@ -279,22 +498,207 @@ def run_simulation(
             "Run 'python backend/scripts/build_extension.py' to build."
         )
 
-    # Validate and prepare parameters
+    variance_reduction = _variance_reduction(request)
     params = validate_and_prepare_params(session, request)
 
-    # Run simulation using C++ engine
     result = run_monte_carlo(
         s0=params.s0,
         mu=params.mu,
         sigma=params.sigma,
         num_simulations=request.num_simulations,
         num_steps=request.num_steps,
-        dt=DAILY_DT,  # Critical: use double precision!
+        dt=DAILY_DT,
         histogram_bins=request.histogram_bins,
         seed=request.seed,
+        storage=PathStorage.Streaming,
+        # float32 rows are exactly what a float32 file stores
+        path_precision=PathPrecision.Float32 if float32 else PathPrecision.Double,
+        num_threads=settings.engine_num_threads,
+        variance_reduction=variance_reduction,
+        export_path=path,
+        export_float32=float32,
+        export_step_stride=step_stride,
     )
+    engine_metrics.record_run(result)
 
-    return result
+    return params
+
+
+def start_progressive_simulation(
+    session: Session,
+    request: SimulationRequest,
+) -> tuple[SimulationParams, "ProgressiveSimulation"]:
+    """
+    Validate a request and set up a chunked engine run for it.
+
+    The run simulates exactly the paths run_monte_carlo would, but the caller
+    advances it a chunk at a time with ProgressiveSimulation.run() and can
+    take a snapshot summary after each chunk (see get_progressive_summary).
+    Pass a CancellationToken to run() to stop an abandoned run within one
+    block of paths.
+
+    Args:
+        session: Database session
+        request: Simulation request (num_simulations is the total)
+
+    Returns:
+        Tuple of (validated parameters, ProgressiveSimulation)
+
+    Raises:
+        ValueError: If data validation fails
+        ImportError: If C++ engine is not built
+    """
+    from app.engine import ProgressiveSimulation
+
+    if ProgressiveSimulation is None:
+        raise ImportError(
+            "Monte Carlo engine not available. "
+            "Run 'python backend/scripts/build_extension.py' to build."
+        )
+
+    variance_reduction = _variance_reduction(request)
+    params = validate_and_prepare_params(session, request)
+
+    simulation = ProgressiveSimulation(
+        s0=params.s0,
+        mu=params.mu,
+        sigma=params.sigma,
+        num_simulations=request.num_simulations,
+        num_steps=request.num_steps,
+        dt=DAILY_DT,
+        histogram_bins=request.histogram_bins,
+        seed=request.seed,
+        path_precision=_path_precision(),
+        **_output_options(request),
+        num_threads=settings.engine_num_threads,
+        quantiles=list(request.quantiles),
+        confidence_levels=_confidence_levels(request),
+        keep_final_prices=request.include_final_prices,
+        variance_reduction=variance_reduction,
+    )
+
+    return params, simulation
+
+
+def progressive_chunk_size(num_simulations: int) -> int:
+    """Paths per chunk of a progressive run of num_simulations paths."""
+    return max(num_simulations // PROGRESSIVE_SNAPSHOTS, MIN_PROGRESSIVE_CHUNK)
+
+
+def _summarize_results(result: "SimulationResult", include_final_prices: bool) -> dict:
+    """JSON-serializable results section shared by every simulation summary."""
+    # Tail Risk Metrics come out of the engine, one entry per confidence level.
+    # VaR is the loss from the starting value at that level; if the percentile
+    # is above it (gain), VaR is negative (no loss). CVaR is the average loss
+    # beyond it.
+    levels = result.confidence_levels.tolist()
+    var = result.value_at_risk.tolist()
+    cvar = result.expected_shortfall.tolist()
+    i95 = levels.index(0.95)
+    i99 = levels.index(0.99)
+
+    results = {
+        # Engine arrays are NumPy views; tolist() converts in C
+        "steps": result.steps.tolist(),
+        "mean_path": result.mean_path.tolist(),
+        "percentile_05": result.percentile_05.tolist(),
+        "percentile_95": result.percentile_95.tolist(),
+        "percentile_bands": {
+            "quantiles": result.quantiles.tolist(),
+            "paths": result.percentile_bands.tolist(),
+        },
+        "histogram": {
+            "counts": result.histogram_data.tolist(),
+            "edges": result.histogram_edges.tolist(),
+        },
+        "final_price": {
+            "mean": result.final_price_mean,
+            "std": result.final_price_std,
+            "min": result.final_price_min,
+            "max": result.final_price_max,
+            "standard_error": result.standard_error,
+        },
+        "tail_risk": {
+            "var_95": var[i95],
+            "var_99": var[i99],
+            "cvar_95": cvar[i95],
+            "cvar_99": cvar[i99],
+            "confidence_levels": levels,
+            "var": var,
+            "cvar": cvar,
+            "probability_of_loss": result.probability_of_loss,
+            "max_drawdown": {
+                "mean": result.max_drawdown_mean,
+                "quantiles": result.max_drawdown_quantiles.tolist(),
+            },
+        },
+    }
+
+    if include_final_prices:
+        results["final_prices"] = result.final_prices.tolist()
+
+    return results
+
+
+def _parameters(params: SimulationParams, request: SimulationRequest, num_simulations: int) -> dict:
+    """Parameters section shared by the single-ticker summaries."""
+    return {
+        "s0": params.s0,
+        "mu": params.mu,
+        "sigma": params.sigma,
+        "num_simulations": num_simulations,
+        "num_steps": request.num_steps,
+        "variance_reduction": request.variance_reduction,
+        "data_points_used": params.num_data_points,
+        "analysis_period": {
+            "start": params.start_date.isoformat(),
+            "end": params.end_date.isoformat(),
+        },
+    }
+
+
+def data_version(session: Session, ticker: str, start_date: date, end_date: date) -> tuple:
+    """
+    Stamp of the DailyPrice rows a simulation reads: latest trade_date and
+    row count in the window. Changes whenever ingestion adds rows to it.
+    """
+    statement = (
+        select(func.max(DailyPrice.trade_date), func.count())
+        .where(DailyPrice.symbol == ticker)
+        .where(DailyPrice.trade_date >= start_date)
+        .where(DailyPrice.trade_date <= end_date)
+    )
+    latest, count = session.exec(statement).one()
+    return latest, count
+
+
+def _panel_version(panel: pl.DataFrame) -> tuple:
+    """data_version() of the rows of a one-ticker panel frame."""
+    if panel.is_empty():
+        return None, 0
+    return panel["date"].max(), panel.height
+
+
+def _cache_key(session: Session, request: SimulationRequest) -> tuple | None:
+    """Cache key of a seeded request (None for unseeded runs, which are not cached)."""
+    if not request.seed:
+        return None
+    return (
+        request.ticker,
+        request.start_date,
+        request.end_date,
+        request.num_simulations,
+        request.num_steps,
+        request.histogram_bins,
+        request.seed,
+        tuple(request.quantiles),
+        tuple(_confidence_levels(request)),
+        request.include_final_prices,
+        request.variance_reduction,
+        request.target_standard_error,
+        request.output_stride,
+        data_version(session, request.ticker, request.start_date, request.end_date),
+    )
 
 
 def get_simulation_summary(
@@ -310,74 +714,245 @@ def get_simulation_summary(
         session: Database session
         request: Simulation request
 
+    Seeded requests are served from simulation_cache while the price data
+    they read is unchanged. The returned dictionary may be shared with
+    other requests and must not be mutated.
+
     Returns:
         Dictionary with simulation results
     """
+    key = _cache_key(session, request)
+    if key is not None:
+        cached = simulation_cache.get(key)
+        if cached is not None:
+            return cached
+
+    started = time.perf_counter()
     params = validate_and_prepare_params(session, request)
-    result = run_simulation(session, request)
-
-    s0 = params.s0
-    
-    # Calculate Tail Risk Metrics
-    # VaR: Difference between Initial Price and Percentile Price (Positive = Loss)
-    # We use max(0, ...) to ensure meaningful loss (though price can gain, VaR usually focuses on downside)
-    # Actually, VaR is just the loss amount at that confidence level. 
-    # If percentile is > s0 (gain), VaR is negative (no loss).
-    var_95 = s0 - result.final_percentile_05
-    var_99 = s0 - result.final_percentile_01
-
-    # CVaR (Expected Shortfall): Average of prices *below* the VaR threshold
-    # Note: final_prices is sorted in C++? Yes.
-    # But C++ result.final_prices might be just a list copy.
-    # We can filter locally.
-    
-    cutoff_95 = result.final_percentile_05
-    cutoff_99 = result.final_percentile_01
-    
-    # optimization: final_prices is sorted!
-    # But filtering is O(N) anyway, fine for 10k items.
-    
-    tail_losses_95 = [p for p in result.final_prices if p <= cutoff_95]
-    avg_tail_price_95 = sum(tail_losses_95) / len(tail_losses_95) if tail_losses_95 else cutoff_95
-    cvar_95 = s0 - avg_tail_price_95
-
-    tail_losses_99 = [p for p in result.final_prices if p <= cutoff_99]
-    avg_tail_price_99 = sum(tail_losses_99) / len(tail_losses_99) if tail_losses_99 else cutoff_99
-    cvar_99 = s0 - avg_tail_price_99
+    db_fetch_seconds = time.perf_counter() - started
+
+    result, num_simulations = _simulate(params, request)
+
+    started = time.perf_counter()
+    results = _summarize_results(result, request.include_final_prices)
+    engine_metrics.record_run(result, db_fetch_seconds, time.perf_counter() - started)
+
+    summary = {
+        "ticker": params.ticker,
+        "parameters": _parameters(params, request, num_simulations),
+        "results": results,
+    }
+
+    if key is not None:
+        simulation_cache.put(key, summary)
+    return summary
+
+
+def get_batch_simulation_summary(
+    session: Session,
+    request: BatchSimulationRequest,
+) -> dict:
+    """
+    Simulate every ticker of a batch in one engine call.
+
+    Each ticker is validated as its own SimulationRequest, and seeded ones
+    are served from simulation_cache as in get_simulation_summary. The rest
+    go to run_monte_carlo_batch together: one GIL-released call that runs
+    them in parallel on the shared thread pool. Every summary is the one
+    get_simulation_summary returns for that ticker.
+
+    Args:
+        session: Database session
+        request: Batch request
+
+    Returns:
+        Dictionary with one summary per ticker that could be simulated (in
+        request order) and the validation error of each one that could not
+
+    Raises:
+        ImportError: If C++ engine is not built
+    """
+    from app.engine import PathStorage, run_monte_carlo_batch
+
+    if run_monte_carlo_batch is None:
+        raise ImportError(
+            "Monte Carlo engine not available. "
+            "Run 'python backend/scripts/build_extension.py' to build."
+        )
+
+    variance_reduction = _variance_reduction(request)
+    shared = {f.name: getattr(request, f.name) for f in fields(request) if f.name != "tickers"}
+
+    summaries: dict[str, dict] = {}
+    errors: dict[str, str] = {}
+    pending = []  # (request, params, cache key, db fetch seconds)
+    for ticker in dict.fromkeys(request.tickers):
+        member = SimulationRequest(ticker=ticker, **shared)
+        key = _cache_key(session, member)
+        cached = simulation_cache.get(key) if key is not None else None
+        if cached is not None:
+            summaries[ticker] = cached
+            continue
+
+        started = time.perf_counter()
+        try:
+            params = validate_and_prepare_params(session, member)
+        except ValueError as e:
+            errors[ticker] = str(e)
+            continue
+        pending.append((member, params, key, time.perf_counter() - started))
+
+    if pending:
+        results = run_monte_carlo_batch(
+            s0=[params.s0 for _, params, _, _ in pending],
+            mu=[params.mu for _, params, _, _ in pending],
+            sigma=[params.sigma for _, params, _, _ in pending],
+            num_simulations=request.num_simulations,
+            num_steps=request.num_steps,
+            dt=DAILY_DT,
+            histogram_bins=request.histogram_bins,
+            seed=request.seed,
+            storage=PathStorage.Streaming,
+            path_precision=_path_precision(),
+            **_output_options(request),
+            num_threads=settings.engine_num_threads,
+            quantiles=list(request.quantiles),
+            confidence_levels=_confidence_levels(request),
+            keep_final_prices=request.include_final_prices,
+            variance_reduction=variance_reduction,
+        )
+
+        for (member, params, key, db_fetch_seconds), result in zip(pending, results):
+            started = time.perf_counter()
+            summary = {
+                "ticker": params.ticker,
+                "parameters": _parameters(params, member, request.num_simulations),
+                "results": _summarize_results(result, request.include_final_prices),
+            }
+            engine_metrics.record_run(result, db_fetch_seconds, time.perf_counter() - started)
+            if key is not None:
+                simulation_cache.put(key, summary)
+            summaries[params.ticker] = summary
+
+    return {
+        "results": [summaries[t] for t in dict.fromkeys(request.tickers) if t in summaries],
+        "errors": errors,
+    }
+
+
+def get_progressive_summary(
+    params: SimulationParams,
+    request: SimulationRequest,
+    simulation: "ProgressiveSimulation",
+) -> dict:
+    """
+    Summary of a progressive run over the paths completed so far.
+
+    Same shape as get_simulation_summary, plus a progress section. A run
+    with a target standard error is complete once the snapshot reaches it.
+
+    Args:
+        params: Validated parameters from start_progressive_simulation
+        request: Simulation request
+        simulation: The run (at least one chunk completed)
+
+    Returns:
+        Dictionary with the partial simulation results
+    """
+    result = simulation.snapshot()
+    completed = simulation.completed_paths
+    done = simulation.done or (
+        request.target_standard_error is not None
+        and result.standard_error <= request.target_standard_error
+    )
 
     return {
         "ticker": params.ticker,
+        "parameters": _parameters(params, request, completed),
+        "results": _summarize_results(result, request.include_final_prices),
+        "progress": {
+            "completed_paths": completed,
+            "total_paths": simulation.total_paths,
+            "done": done,
+        },
+    }
+
+
+def get_portfolio_simulation_summary(request: PortfolioSimulationRequest) -> dict:
+    """
+    Simulate a portfolio with correlated assets and return a summary.
+
+    Daily log-return means and covariance come from HRPService (the same
+    overlapping DailyPrice history the HRP allocation uses). The C++ engine
+    factors the covariance once and aggregates portfolio value paths
+    directly, so correlation between holdings is reflected in VaR.
+
+    Args:
+        request: Portfolio simulation request
+
+    Returns:
+        Dictionary with the portfolio simulation results
+
+    Raises:
+        ValueError: If inputs or price history are invalid
+        ImportError: If C++ engine is not built
+    """
+    import numpy as np
+
+    from app.engine import PathStorage, run_portfolio_monte_carlo
+    from app.services.hrp_service import HRPService
+
+    if run_portfolio_monte_carlo is None:
+        raise ImportError(
+            "Monte Carlo engine not available. "
+            "Run 'python backend/scripts/build_extension.py' to build."
+        )
+
+    if len(request.tickers) != len(request.weights):
+        raise ValueError("weights must have one entry per ticker")
+    if len(set(request.tickers)) != len(request.tickers):
+        raise ValueError("tickers must be unique")
+
+    tickers, mean, cov = HRPService().get_return_moments(list(request.tickers))
+    missing = set(request.tickers) - set(tickers)
+    if missing:
+        raise ValueError(f"No price data found for {', '.join(sorted(missing))}")
+
+    # Weights in the column order of the moments
+    weight_of = dict(zip(request.tickers, request.weights))
+    weights = [weight_of[t] for t in tickers]
+
+    result = run_portfolio_monte_carlo(
+        mean=mean.tolist(),
+        covariance=np.ascontiguousarray(cov),
+        weights=weights,
+        initial_value=request.initial_value,
+        num_simulations=request.num_simulations,
+        num_steps=request.num_steps,
+        histogram_bins=request.histogram_bins,
+        seed=request.seed,
+        # Only aggregates are returned, so never hold the full path matrix
+        storage=PathStorage.Streaming,
+        num_threads=settings.engine_num_threads,
+        quantiles=list(request.quantiles),
+        confidence_levels=_confidence_levels(request),
+        keep_final_values=request.include_final_prices,
+    )
+
+    started = time.perf_counter()
+    results = _summarize_results(result, request.include_final_prices)
+    engine_metrics.record_run(result, copy_seconds=time.perf_counter() - started)
+
+    return {
+        "tickers": tickers,
+        "weights": weights,
         "parameters": {
-            "s0": params.s0,
-            "mu": params.mu,
-            "sigma": params.sigma,
+            "initial_value": result.mean_path[0].item(),
+            "mu": (mean * TRADING_DAYS_PER_YEAR).tolist(),
+            "sigma": (np.sqrt(np.diag(cov)) * math.sqrt(TRADING_DAYS_PER_YEAR)).tolist(),
+            "correlation": (cov / np.outer(np.sqrt(np.diag(cov)), np.sqrt(np.diag(cov)))).tolist(),
             "num_simulations": request.num_simulations,
             "num_steps": request.num_steps,
-            "data_points_used": params.num_data_points,
-            "analysis_period": {
-                "start": params.start_date.isoformat(),
-                "end": params.end_date.isoformat(),
-            },
-        },
-        "results": {
-            "mean_path": result.mean_path,
-            "percentile_05": result.percentile_05,
-            "percentile_95": result.percentile_95,
-            "histogram": {
-                "counts": result.histogram_data,
-                "edges": result.histogram_edges,
-            },
-            "final_price": {
-                "mean": result.final_price_mean,
-                "std": result.final_price_std,
-                "min": result.final_price_min,
-                "max": result.final_price_max,
-            },
-            "tail_risk": {
-                "var_95": var_95,
-                "var_99": var_99,
-                "cvar_95": cvar_95,
-                "cvar_99": cvar_99,
-            }
         },
+        "results": results,
     }
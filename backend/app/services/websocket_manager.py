@@ -20,6 +20,17 @@ class ConnectionManager:
         if websocket in self.active_connections:
             self.active_connections.remove(websocket)
 
+    async def send(self, websocket: WebSocket, message: dict) -> bool:
+        """
+        Send to one connection; False (and dropped) if the client is gone.
+        """
+        try:
+            await websocket.send_json(message)
+            return True
+        except Exception:
+            self.disconnect(websocket)
+            return False
+
     async def broadcast(self, message: dict):
         for connection in self.active_connections:
             try:
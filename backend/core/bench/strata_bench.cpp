@@ -0,0 +1,244 @@
+/**
+ * @file strata_bench.cpp
+ * @brief Google Benchmark suite of the core engines.
+ *
+ * Build the strata_bench target and run it directly, or build bench_json
+ * to write strata_bench.json into the build directory for comparison
+ * across releases (e.g. with Google Benchmark's tools/compare.py):
+ *
+ *   cmake --build build --target bench_json
+ *   ./build/strata_bench --benchmark_filter=MonteCarlo --benchmark_format=json
+ *
+ * Thread arguments of 0 mean every core, as in the engines.
+ */
+
+#include "american_option.h"
+#include "greeks_engine.h"
+#include "job_scheduler.h"
+#include "monte_carlo.h"
+#include "path_statistics.h"
+#include "thread_pool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using quant::PathStorage;
+
+/// Throughput counters shared by the simulation cases
+void set_path_counters(benchmark::State& state, int num_simulations, int num_steps) {
+    const double path_steps = static_cast<double>(num_simulations) * num_steps;
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(path_steps));
+    state.counters["paths_per_second"] = benchmark::Counter(
+        static_cast<double>(num_simulations), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["threads"] = static_cast<double>(quant::resolve_num_threads(static_cast<int>(state.range(2))));
+}
+
+quant::SimulationConfig gbm_config(const benchmark::State& state, PathStorage storage) {
+    quant::SimulationConfig config;
+    config.s0 = 100.0;
+    config.mu = 0.08;
+    config.sigma = 0.2;
+    config.num_simulations = static_cast<int>(state.range(0));
+    config.num_steps = static_cast<int>(state.range(1));
+    config.num_threads = static_cast<int>(state.range(2));
+    config.seed = 42;
+    config.storage = storage;
+    return config;
+}
+
+/// num_simulations x num_steps x threads, full path storage
+void BM_MonteCarloFull(benchmark::State& state) {
+    const quant::SimulationConfig config = gbm_config(state, PathStorage::Full);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(quant::run_monte_carlo(config));
+    }
+    set_path_counters(state, config.num_simulations, config.num_steps);
+}
+
+/// Same sweep with streaming (per-step) storage
+void BM_MonteCarloStreaming(benchmark::State& state) {
+    const quant::SimulationConfig config = gbm_config(state, PathStorage::Streaming);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(quant::run_monte_carlo(config));
+    }
+    set_path_counters(state, config.num_simulations, config.num_steps);
+}
+
+void simulation_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"sims", "steps", "threads"})
+        ->ArgsProduct({{10'000, 100'000, 1'000'000}, {21, 252}, {1, 0}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
+
+BENCHMARK(BM_MonteCarloFull)->Apply(simulation_args);
+BENCHMARK(BM_MonteCarloStreaming)->Apply(simulation_args);
+
+/**
+ * @brief Random option chain of n contracts.
+ */
+struct OptionChain {
+    explicit OptionChain(std::size_t n)
+        : strike(n), expiry(n), spot(n), rate(n), vol(n), is_call(new bool[n]) {
+        std::mt19937_64 rng(7);
+        std::uniform_real_distribution<double> moneyness(0.7, 1.3);
+        std::uniform_real_distribution<double> years(0.02, 2.0);
+        std::uniform_real_distribution<double> sigma(0.1, 0.8);
+        for (std::size_t i = 0; i < n; ++i) {
+            spot[i] = 100.0;
+            strike[i] = 100.0 * moneyness(rng);
+            expiry[i] = years(rng);
+            rate[i] = 0.04;
+            vol[i] = sigma(rng);
+            is_call[i] = i % 2 == 0;
+        }
+    }
+
+    std::vector<double> strike, expiry, spot, rate, vol;
+    std::unique_ptr<bool[]> is_call;  // bool* input of calculate_greeks_batch
+};
+
+/// Scalar calculate_greeks over a chain, the per-option baseline
+void BM_GreeksScalar(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const OptionChain chain(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) {
+            benchmark::DoNotOptimize(quant::calculate_greeks(
+                chain.strike[i], chain.expiry[i], chain.spot[i], chain.rate[i], chain.vol[i], chain.is_call[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+/// calculate_greeks_batch over chains of increasing size
+void BM_GreeksBatch(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const OptionChain chain(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(quant::calculate_greeks_batch(
+            chain.strike.data(), chain.expiry.data(), chain.spot.data(), chain.rate.data(), chain.vol.data(),
+            chain.is_call.get(), n));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+BENCHMARK(BM_GreeksScalar)->ArgName("options")->RangeMultiplier(16)->Range(64, 262'144);
+BENCHMARK(BM_GreeksBatch)->ArgName("options")->RangeMultiplier(16)->Range(64, 262'144)->UseRealTime();
+
+/// Longstaff-Schwartz prices and Greeks of a chain, paths per option
+void BM_AmericanBatch(benchmark::State& state) {
+    constexpr std::size_t n = 16;
+    const OptionChain chain(n);
+    const std::vector<double> dividend_yield(n, 0.0);
+    quant::LsmConfig config;
+    config.num_simulations = static_cast<int>(state.range(0));
+    config.seed = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(quant::price_american_batch(
+            chain.strike.data(), chain.expiry.data(), chain.spot.data(), chain.rate.data(), chain.vol.data(),
+            dividend_yield.data(), chain.is_call.get(), n, config));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+BENCHMARK(BM_AmericanBatch)->ArgName("paths")->RangeMultiplier(4)->Range(10'000, 160'000)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/// Scheduler overhead: submit jobs of trivial work and wait for all of them
+void BM_SchedulerRoundTrip(benchmark::State& state) {
+    const auto jobs = static_cast<std::size_t>(state.range(0));
+    quant::SchedulerLimits limits;
+    limits.max_queued_interactive = jobs;
+    quant::JobScheduler scheduler(quant::ThreadPool::instance(), limits);
+    std::vector<std::shared_ptr<quant::Job>> handles(jobs);
+    for (auto _ : state) {
+        for (auto& handle : handles) {
+            handle = scheduler.submit([] {}, quant::TaskPriority::Interactive);
+        }
+        for (const auto& handle : handles) {
+            handle->wait();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SchedulerRoundTrip)->ArgName("jobs")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+
+/**
+ * @brief Simulated-looking terminal values and the aggregation setup of a
+ *        run of n paths.
+ */
+struct AggregationFixture {
+    explicit AggregationFixture(int n) : values(static_cast<std::size_t>(n)), scratch(values.size()) {
+        std::mt19937_64 rng(11);
+        std::lognormal_distribution<double> price(4.6, 0.2);
+        for (double& v : values) {
+            v = price(rng);
+        }
+        options.reference = 100.0;
+        options.quantiles = {0.01, 0.05, 0.25, 0.50, 0.75, 0.95, 0.99};
+        options.confidence_levels = {0.95, 0.99};
+        plan = quant::make_quantile_plan(n, options);
+        quant::prepare_result(result, 1, options);
+    }
+
+    std::vector<double> values;
+    std::vector<double> scratch;
+    quant::AggregationOptions options;
+    quant::QuantilePlan plan;
+    quant::SimulationResult result;
+};
+
+/// Percentile stage: mean and the band order statistics of one step
+void BM_AggregateStep(benchmark::State& state) {
+    AggregationFixture f(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        f.scratch = f.values;  // selection reorders its input
+        quant::aggregate_step(f.scratch, 0, f.plan, f.result);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Percentile stage over a PathPrecision::Float32 row
+void BM_AggregateStepFloat32(benchmark::State& state) {
+    AggregationFixture f(static_cast<int>(state.range(0)));
+    const std::vector<float> values(f.values.begin(), f.values.end());
+    std::vector<float> scratch(values.size());
+    for (auto _ : state) {
+        scratch = values;
+        quant::aggregate_step(scratch.data(), static_cast<int>(scratch.size()), 0, f.plan, f.result);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Terminal stage: final statistics, VaR / expected shortfall, histogram
+void BM_AggregateFinalValues(benchmark::State& state) {
+    AggregationFixture f(static_cast<int>(state.range(0)));
+    f.options.histogram_bins = static_cast<int>(state.range(1));
+    quant::prepare_result(f.result, 1, f.options);
+    for (auto _ : state) {
+        f.scratch = f.values;
+        quant::aggregate_final_values(f.scratch, f.options, f.plan, f.result);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_AggregateStep)->ArgName("values")->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_AggregateStepFloat32)->ArgName("values")->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_AggregateFinalValues)
+    ->ArgNames({"values", "bins"})
+    ->ArgsProduct({{10'000, 100'000, 1'000'000}, {50, 200}});
+
+} // namespace
+
+BENCHMARK_MAIN();
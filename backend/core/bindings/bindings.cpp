@@ -2,18 +2,288 @@
  * @file bindings.cpp
  * @brief PyBind11 bindings for the Monte Carlo simulation engine.
  *
- * Exposes the C++ Monte Carlo functionality to Python with automatic
- * type conversion between STL containers and Python lists/arrays.
+ * Exposes the C++ Monte Carlo functionality to Python. Arguments use
+ * automatic STL <-> Python conversion; large result buffers are returned
+ * as zero-copy NumPy views instead.
  */
 
 #include <pybind11/pybind11.h>
-#include <pybind11/stl.h>  // Automatic STL <-> Python conversion
+#include <pybind11/numpy.h> // Zero-copy NumPy views over result buffers
+#include <pybind11/stl.h>   // Automatic STL <-> Python conversion
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
 
 #include "monte_carlo.h"
+#include "american_option.h"
+#include "portfolio_monte_carlo.h"
+#include "progressive_simulation.h"
+#include "rolling_statistics.h"
+#include "cointegration.h"
 #include "greeks_engine.h"
+#include "hrp.h"
+#include "implied_vol.h"
+#include "job_scheduler.h"
+#include "pairs_backtest.h"
+#include "price_panel.h"
+#include "scenario_engine.h"
+#include "simd_kernels.h"
+#include "simulation_workspace.h"
 
 namespace py = pybind11;
 
+namespace {
+
+/**
+ * @brief Read-only NumPy view over memory owned by a Python object.
+ *
+ * The array's base is owner, which keeps the C++ buffer alive for as long
+ * as any view exists. Nothing is copied.
+ */
+template <typename T>
+py::array_t<T> readonly_view(
+    std::vector<py::ssize_t> shape,
+    std::vector<py::ssize_t> strides,
+    const T* data,
+    py::handle owner
+) {
+    py::array_t<T> view(std::move(shape), std::move(strides), data, owner);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
+/**
+ * @brief Getter returning a 1-D view over a std::vector member.
+ */
+template <typename T, typename Class>
+auto array_property(std::vector<T> Class::*field) {
+    return [field](py::object self) {
+        const std::vector<T>& values = self.cast<const Class&>().*field;
+        return readonly_view<T>(
+            {static_cast<py::ssize_t>(values.size())},
+            {static_cast<py::ssize_t>(sizeof(T))},
+            values.data(),
+            self
+        );
+    };
+}
+
+/// Contiguous double input array; NumPy converts other dtypes on the way in
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Contiguous int64 input array (e.g. datetime64[D] viewed as days)
+using Int64Array = py::array_t<std::int64_t, py::array::c_style | py::array::forcecast>;
+
+/**
+ * @brief Pointer to n values of an input array, broadcasting size-1 input.
+ *
+ * Scalars (e.g. one spot for the whole chain) are expanded into storage.
+ */
+const double* broadcast(
+    const DoubleArray& values,
+    py::ssize_t n,
+    std::vector<double>& storage,
+    const char* name
+) {
+    if (values.size() == n) {
+        return values.data();
+    }
+    if (values.size() == 1) {
+        storage.assign(static_cast<std::size_t>(n), *values.data());
+        return storage.data();
+    }
+    throw std::invalid_argument(std::string(name) + " must have one value or one per option");
+}
+
+/// Contiguous bool input array (is_call flags)
+using BoolArray = py::array_t<bool, py::array::c_style | py::array::forcecast>;
+
+/**
+ * @brief broadcast() for flag arrays (std::vector<bool> has no data()).
+ */
+const bool* broadcast(
+    const BoolArray& values,
+    py::ssize_t n,
+    std::unique_ptr<bool[]>& storage,
+    const char* name
+) {
+    if (values.size() == n) {
+        return values.data();
+    }
+    if (values.size() == 1) {
+        storage.reset(new bool[static_cast<std::size_t>(n)]);
+        std::fill(storage.get(), storage.get() + n, *values.data());
+        return storage.get();
+    }
+    throw std::invalid_argument(std::string(name) + " must have one value or one per option");
+}
+
+/**
+ * @brief Getter returning a scenario tensor as a (positions, spot, vol) view.
+ */
+auto scenario_property(std::vector<double> quant::ScenarioResult::*field) {
+    return [field](py::object self) {
+        const quant::ScenarioResult& r = self.cast<const quant::ScenarioResult&>();
+        const std::vector<double>& values = r.*field;
+        const py::ssize_t num_positions = values.empty() ? 0 : r.num_positions;
+        const py::ssize_t d = static_cast<py::ssize_t>(sizeof(double));
+        return readonly_view<double>(
+            {num_positions, r.num_spot, r.num_vol},
+            {r.num_spot * r.num_vol * d, r.num_vol * d, d},
+            values.data(),
+            self
+        );
+    };
+}
+
+/**
+ * @brief Getter returning a book tensor as a (spot, vol) view.
+ */
+auto book_property(std::vector<double> quant::ScenarioResult::*field) {
+    return [field](py::object self) {
+        const quant::ScenarioResult& r = self.cast<const quant::ScenarioResult&>();
+        const py::ssize_t d = static_cast<py::ssize_t>(sizeof(double));
+        return readonly_view<double>(
+            {r.num_spot, r.num_vol},
+            {r.num_vol * d, d},
+            (r.*field).data(),
+            self
+        );
+    };
+}
+
+/**
+ * @brief Index of a panel symbol or field by name.
+ *
+ * @throws std::invalid_argument if the panel does not have it
+ */
+int panel_index(const quant::PricePanel& panel, const std::string& name, bool field) {
+    const int index = field ? panel.field_index(name) : panel.symbol_index(name);
+    if (index < 0) {
+        throw std::invalid_argument(std::string(field ? "field" : "symbol") + " not in price panel: " + name);
+    }
+    return index;
+}
+
+/**
+ * @brief Getter returning a pairs grid metric as an (entry, exit) view.
+ */
+template <typename T>
+auto pairs_grid_property(std::vector<T> quant::PairsGridResult::*field) {
+    return [field](py::object self) {
+        const quant::PairsGridResult& r = self.cast<const quant::PairsGridResult&>();
+        const py::ssize_t d = static_cast<py::ssize_t>(sizeof(T));
+        return readonly_view<T>(
+            {r.num_entry, r.num_exit},
+            {r.num_exit * d, d},
+            (r.*field).data(),
+            self
+        );
+    };
+}
+
+/**
+ * @brief PairsSeries over three equal-length input arrays.
+ */
+quant::PairsSeries pairs_series(const DoubleArray& z_score, const DoubleArray& spread, const DoubleArray& capital) {
+    if (spread.size() != z_score.size() || capital.size() != z_score.size()) {
+        throw std::invalid_argument("z_score, spread and capital must have the same length");
+    }
+    return {z_score.data(), spread.data(), capital.data(), static_cast<std::size_t>(z_score.size())};
+}
+
+/**
+ * @brief SimulationConfig from the keyword arguments shared by
+ *        run_monte_carlo, run_monte_carlo_batch and ProgressiveSimulation.
+ */
+quant::SimulationConfig simulation_config(
+    double s0,
+    double mu,
+    double sigma,
+    int num_simulations,
+    int num_steps,
+    double dt,
+    int histogram_bins,
+    uint64_t seed,
+    quant::PathStorage storage,
+    int num_threads,
+    const std::vector<double>& quantiles,
+    const std::vector<double>& confidence_levels,
+    bool keep_final_prices,
+    quant::VarianceReduction variance_reduction,
+    quant::ProcessModel model,
+    const quant::HestonParams& heston,
+    const quant::MertonParams& merton,
+    const quant::GarchParams& garch
+) {
+    quant::SimulationConfig config;
+    config.s0 = s0;
+    config.mu = mu;
+    config.sigma = sigma;
+    config.num_simulations = num_simulations;
+    config.num_steps = num_steps;
+    config.dt = dt;
+    config.histogram_bins = histogram_bins;
+    config.seed = seed;
+    config.storage = storage;
+    config.num_threads = num_threads;
+    config.quantiles = quantiles;
+    config.confidence_levels = confidence_levels;
+    config.keep_final_prices = keep_final_prices;
+    config.variance_reduction = variance_reduction;
+    config.model = model;
+    config.heston = heston;
+    config.merton = merton;
+    config.garch = garch;
+    return config;
+}
+
+/**
+ * @brief Python side of one scheduler job: its callable and outcome.
+ *
+ * Shared by the job's function (run on a pool worker) and the EngineJob
+ * handle; whichever lets go last may not hold the GIL, so the destructor
+ * takes it.
+ */
+struct PyJobState {
+    py::object fn;
+    py::object result;
+    py::object error;  // exception instance raised by fn
+
+    ~PyJobState() {
+        py::gil_scoped_acquire gil;
+        fn = py::object();
+        result = py::object();
+        error = py::object();
+    }
+};
+
+/// Handle returned by submit_job()
+struct EngineJob {
+    std::shared_ptr<quant::Job> job;
+    std::shared_ptr<PyJobState> state;
+};
+
+/// Python callable owned by a C++ callback, released with the GIL
+struct PyCallback {
+    explicit PyCallback(py::object f) : fn(std::move(f)) {}
+
+    ~PyCallback() {
+        py::gil_scoped_acquire gil;
+        fn = py::object();
+    }
+
+    py::object fn;
+};
+
+} // namespace
+
 PYBIND11_MODULE(monte_carlo_engine, m) {
     m.doc() = R"pbdoc(
         Monte Carlo Simulation Engine
@@ -35,48 +305,293 @@ PYBIND11_MODULE(monte_carlo_engine, m) {
             >>> print(f"Expected final price: {result.final_price_mean:.2f}")
     )pbdoc";
 
+    // Bind SimulationTimings struct
+    py::class_<quant::SimulationTimings>(m, "SimulationTimings",
+        R"pbdoc(
+            Wall time per phase of one simulation and its buffer sizes.
+
+            All zero, with enabled False, unless the engine was built with
+            STRATA_ENGINE_TIMINGS.
+
+            Attributes:
+                enabled: Whether the engine records timings
+                setup_seconds: Seed, quantile plan and buffer allocation
+                path_seconds: Shock generation and path stepping
+                step_stats_seconds: Per-step mean and percentile bands
+                final_stats_seconds: Terminal statistics, tail risk and
+                    drawdowns
+                histogram_seconds: Histogram of final values (part of
+                    final_stats_seconds)
+                export_seconds: Writing exported paths
+                total_seconds: Whole run
+                bytes_allocated: Bytes of the engine's working buffers
+                paths_per_second: num_simulations / total_seconds
+        )pbdoc")
+        .def_readonly("enabled", &quant::SimulationTimings::enabled)
+        .def_readonly("setup_seconds", &quant::SimulationTimings::setup_seconds)
+        .def_readonly("path_seconds", &quant::SimulationTimings::path_seconds)
+        .def_readonly("step_stats_seconds", &quant::SimulationTimings::step_stats_seconds)
+        .def_readonly("final_stats_seconds", &quant::SimulationTimings::final_stats_seconds)
+        .def_readonly("histogram_seconds", &quant::SimulationTimings::histogram_seconds)
+        .def_readonly("export_seconds", &quant::SimulationTimings::export_seconds)
+        .def_readonly("total_seconds", &quant::SimulationTimings::total_seconds)
+        .def_readonly("bytes_allocated", &quant::SimulationTimings::bytes_allocated)
+        .def_readonly("paths_per_second", &quant::SimulationTimings::paths_per_second)
+        .def("__repr__", [](const quant::SimulationTimings& t) {
+            return "<SimulationTimings total=" + std::to_string(t.total_seconds) +
+                   "s paths_per_second=" + std::to_string(t.paths_per_second) + ">";
+        });
+
     // Bind SimulationResult struct
     py::class_<quant::SimulationResult>(m, "SimulationResult",
         R"pbdoc(
             Aggregated results from Monte Carlo simulation.
 
+            Array attributes are read-only NumPy views over engine-owned
+            memory (no copy); they keep the result alive while referenced.
+
             Attributes:
+                steps: Step index of each point of mean_path, the
+                    percentiles and the bands (every output_stride-th step
+                    and the last one)
                 mean_path: Average price path across all simulations
                 percentile_05: 5th percentile path (95% CI lower bound)
                 percentile_95: 95th percentile path (95% CI upper bound)
+                quantiles: Quantiles of the percentile bands
+                percentile_bands: One path per quantile
+                    (len(quantiles) x len(steps))
                 histogram_data: Histogram counts of final prices
                 histogram_edges: Bin edges for the histogram
-                final_price_mean: Mean of final prices
+                final_price_mean: Mean of final prices (control-variate
+                    estimate under VarianceReduction.ControlVariate)
                 final_price_std: Standard deviation of final prices
                 final_price_min: Minimum final price
                 final_price_max: Maximum final price
+                standard_error: Standard error of final_price_mean under
+                    the variance-reduction mode used
+                final_prices: Unordered final price of every path
+                    (empty unless keep_final_prices was set)
+                confidence_levels: Confidence levels of the risk metrics
+                value_at_risk: VaR per confidence level (s0 minus the
+                    (1 - c) quantile of final prices; positive = loss)
+                expected_shortfall: CVaR per confidence level
+                probability_of_loss: Fraction of paths ending below s0
+                max_drawdown_mean: Mean per-path maximum drawdown
+                    (fraction of running peak)
+                max_drawdown_quantiles: c quantile of the maximum
+                    drawdown per confidence level
+                timings: SimulationTimings of the run
         )pbdoc")
         .def(py::init<>())
-        .def_readwrite("mean_path", &quant::SimulationResult::mean_path)
-        .def_readwrite("percentile_05", &quant::SimulationResult::percentile_05)
-        .def_readwrite("percentile_95", &quant::SimulationResult::percentile_95)
-        .def_readwrite("histogram_data", &quant::SimulationResult::histogram_data)
-        .def_readwrite("histogram_edges", &quant::SimulationResult::histogram_edges)
+        .def_property_readonly("steps", array_property(&quant::SimulationResult::steps))
+        .def_property_readonly("mean_path", array_property(&quant::SimulationResult::mean_path))
+        .def_property_readonly("percentile_05", array_property(&quant::SimulationResult::percentile_05))
+        .def_property_readonly("percentile_95", array_property(&quant::SimulationResult::percentile_95))
+        .def_property_readonly("quantiles", array_property(&quant::SimulationResult::quantiles))
+        .def_property_readonly("percentile_bands", [](py::object self) {
+            // 2-D view over the flat row-major [quantile][point] matrix
+            const auto& r = self.cast<const quant::SimulationResult&>();
+            const py::ssize_t rows = static_cast<py::ssize_t>(r.quantiles.size());
+            const py::ssize_t cols = static_cast<py::ssize_t>(r.mean_path.size());
+            return readonly_view<double>(
+                {rows, cols},
+                {cols * static_cast<py::ssize_t>(sizeof(double)), static_cast<py::ssize_t>(sizeof(double))},
+                r.percentile_bands.data(),
+                self
+            );
+        })
+        .def_property_readonly("histogram_data", array_property(&quant::SimulationResult::histogram_data))
+        .def_property_readonly("histogram_edges", array_property(&quant::SimulationResult::histogram_edges))
         .def_readwrite("final_price_mean", &quant::SimulationResult::final_price_mean)
         .def_readwrite("final_price_std", &quant::SimulationResult::final_price_std)
         .def_readwrite("final_price_min", &quant::SimulationResult::final_price_min)
         .def_readwrite("final_price_max", &quant::SimulationResult::final_price_max)
-        .def_readwrite("final_prices", &quant::SimulationResult::final_prices)
+        .def_readwrite("standard_error", &quant::SimulationResult::standard_error)
+        .def_property_readonly("final_prices", array_property(&quant::SimulationResult::final_prices))
         .def_readwrite("final_percentile_05", &quant::SimulationResult::final_percentile_05)
         .def_readwrite("final_percentile_01", &quant::SimulationResult::final_percentile_01)
+        .def_property_readonly("confidence_levels", array_property(&quant::SimulationResult::confidence_levels))
+        .def_property_readonly("value_at_risk", array_property(&quant::SimulationResult::value_at_risk))
+        .def_property_readonly("expected_shortfall", array_property(&quant::SimulationResult::expected_shortfall))
+        .def_readwrite("probability_of_loss", &quant::SimulationResult::probability_of_loss)
+        .def_readwrite("max_drawdown_mean", &quant::SimulationResult::max_drawdown_mean)
+        .def_property_readonly("max_drawdown_quantiles", array_property(&quant::SimulationResult::max_drawdown_quantiles))
+        .def_readonly("timings", &quant::SimulationResult::timings)
         .def("__repr__", [](const quant::SimulationResult& r) {
             return "<SimulationResult mean_final=" + std::to_string(r.final_price_mean) +
                    " std=" + std::to_string(r.final_price_std) + ">";
         });
 
+    // Bind PathStorage enum
+    py::enum_<quant::PathStorage>(m, "PathStorage",
+        R"pbdoc(
+            How simulated paths are held in memory.
+
+            Values:
+                Full: Keep the whole (num_steps + 1) x num_simulations matrix
+                Streaming: Aggregate step by step, O(num_simulations) memory
+        )pbdoc")
+        .value("Full", quant::PathStorage::Full)
+        .value("Streaming", quant::PathStorage::Streaming);
+
+    // Bind PathPrecision enum
+    py::enum_<quant::PathPrecision>(m, "PathPrecision",
+        R"pbdoc(
+            Precision of the step rows behind mean_path and the percentile
+            bands.
+
+            Values:
+                Double: float64 rows, exact statistics
+                Float32: float32 rows, half the path memory; per-step
+                    statistics within a relative 2^-24 (about 6e-8) of
+                    Double, terminal statistics bit-identical
+        )pbdoc")
+        .value("Double", quant::PathPrecision::Double)
+        .value("Float32", quant::PathPrecision::Float32);
+
+    // Bind VarianceReduction enum
+    py::enum_<quant::VarianceReduction>(m, "VarianceReduction",
+        R"pbdoc(
+            How the normal shocks driving the paths are drawn.
+
+            Values:
+                Plain: Independent pseudo-random shocks (VarianceReduction::None
+                    in C++; None is reserved in Python)
+                Antithetic: Paths in pairs with shocks z and -z
+                ControlVariate: Mean corrected with each path's summed
+                    shock (known mean 0)
+                Sobol: Randomized Sobol points through a Brownian bridge,
+                    16 digitally shifted replicates
+        )pbdoc")
+        .value("Plain", quant::VarianceReduction::None)
+        .value("Antithetic", quant::VarianceReduction::Antithetic)
+        .value("ControlVariate", quant::VarianceReduction::ControlVariate)
+        .value("Sobol", quant::VarianceReduction::Sobol);
+
+    // Bind ProcessModel enum; the tag picks the compiled simulate<Process>
+    py::enum_<quant::ProcessModel>(m, "ProcessModel",
+        R"pbdoc(
+            Stochastic process driving the price paths. In every model mu
+            is the expected return, E[S(T)] = s0 * exp(mu * T).
+
+            Values:
+                GBM: Geometric Brownian motion with volatility sigma
+                Heston: Stochastic variance (HestonParams); sigma is unused
+                Merton: GBM plus log-normal jumps (MertonParams)
+                GARCH: GARCH(1,1) per-step variance (GarchParams)
+        )pbdoc")
+        .value("GBM", quant::ProcessModel::GBM)
+        .value("Heston", quant::ProcessModel::Heston)
+        .value("Merton", quant::ProcessModel::Merton)
+        .value("GARCH", quant::ProcessModel::GARCH);
+
+    py::class_<quant::HestonParams>(m, "HestonParams",
+        R"pbdoc(
+            Heston parameters: dv = kappa (theta - v) dt + xi sqrt(v) dW_v,
+            corr(dW_S, dW_v) = rho. Variances are annualized.
+        )pbdoc")
+        .def(py::init([](double v0, double kappa, double theta, double xi, double rho) {
+                 return quant::HestonParams{v0, kappa, theta, xi, rho};
+             }),
+             py::arg("v0") = 0.04, py::arg("kappa") = 2.0, py::arg("theta") = 0.04,
+             py::arg("xi") = 0.3, py::arg("rho") = -0.7)
+        .def_readwrite("v0", &quant::HestonParams::v0)
+        .def_readwrite("kappa", &quant::HestonParams::kappa)
+        .def_readwrite("theta", &quant::HestonParams::theta)
+        .def_readwrite("xi", &quant::HestonParams::xi)
+        .def_readwrite("rho", &quant::HestonParams::rho);
+
+    py::class_<quant::MertonParams>(m, "MertonParams",
+        R"pbdoc(
+            Merton jump parameters: jumps per year, and the mean and
+            standard deviation of the log jump size.
+        )pbdoc")
+        .def(py::init([](double intensity, double jump_mean, double jump_std) {
+                 return quant::MertonParams{intensity, jump_mean, jump_std};
+             }),
+             py::arg("intensity") = 0.5, py::arg("jump_mean") = -0.05, py::arg("jump_std") = 0.1)
+        .def_readwrite("intensity", &quant::MertonParams::intensity)
+        .def_readwrite("jump_mean", &quant::MertonParams::jump_mean)
+        .def_readwrite("jump_std", &quant::MertonParams::jump_std);
+
+    py::class_<quant::GarchParams>(m, "GarchParams",
+        R"pbdoc(
+            GARCH(1,1) weights (alpha + beta < 1) and the annualized
+            long-run variance (0 = sigma^2). Paths start at variance sigma^2.
+        )pbdoc")
+        .def(py::init([](double alpha, double beta, double long_run_variance) {
+                 return quant::GarchParams{alpha, beta, long_run_variance};
+             }),
+             py::arg("alpha") = 0.08, py::arg("beta") = 0.9, py::arg("long_run_variance") = 0.0)
+        .def_readwrite("alpha", &quant::GarchParams::alpha)
+        .def_readwrite("beta", &quant::GarchParams::beta)
+        .def_readwrite("long_run_variance", &quant::GarchParams::long_run_variance);
+
+    // Bind SimulationWorkspace (arena reused across runs)
+    py::class_<quant::SimulationWorkspace>(m, "SimulationWorkspace",
+        R"pbdoc(
+            Reusable scratch arena for run_monte_carlo.
+
+            A run takes its path buffers and per-path scratch from one
+            contiguous, 64-byte aligned buffer; the next run regrows it to
+            what the last one used, so repeating similar runs allocates
+            nothing once warm. Without a workspace, run_monte_carlo uses one
+            per thread. A workspace serves one run at a time; a concurrent
+            run on it raises RuntimeError.
+
+            Args:
+                retain_bytes: Largest buffer kept between runs
+                    (default: 256 MiB)
+
+            Attributes:
+                capacity: Bytes of the buffer
+                high_water: Most bytes any run has taken
+                overflow_allocations: Buffers the last run needed beyond
+                    the workspace (0 when warm)
+                retain_bytes: Largest buffer kept between runs
+        )pbdoc")
+        .def(py::init<std::size_t>(), py::arg("retain_bytes") = quant::DEFAULT_WORKSPACE_RETAIN_BYTES)
+        .def_property_readonly("capacity", &quant::SimulationWorkspace::capacity)
+        .def_property_readonly("high_water", &quant::SimulationWorkspace::high_water)
+        .def_property_readonly("overflow_allocations", &quant::SimulationWorkspace::overflow_allocations)
+        .def_property("retain_bytes", &quant::SimulationWorkspace::retain_bytes,
+                      &quant::SimulationWorkspace::set_retain_bytes)
+        .def("reserve", &quant::SimulationWorkspace::reserve, py::arg("bytes"),
+             "Grow the buffer to at least bytes now.")
+        .def("release", &quant::SimulationWorkspace::release, "Free the buffer.");
+
     // Bind run_monte_carlo function with keyword arguments
-    m.def("run_monte_carlo", &quant::run_monte_carlo,
+    m.def("run_monte_carlo",
+        [](double s0, double mu, double sigma, int num_simulations, int num_steps,
+           double dt, int histogram_bins, uint64_t seed, quant::PathStorage storage,
+           quant::PathPrecision path_precision, int output_stride, bool log_space, int num_threads,
+           const std::vector<double>& quantiles, const std::vector<double>& confidence_levels,
+           bool keep_final_prices,
+           quant::VarianceReduction variance_reduction, quant::ProcessModel model,
+           const quant::HestonParams& heston, const quant::MertonParams& merton,
+           const quant::GarchParams& garch, quant::SimulationWorkspace* workspace,
+           const std::optional<std::string>& export_path, bool export_float32, int export_step_stride) {
+            quant::SimulationConfig config = simulation_config(
+                s0, mu, sigma, num_simulations, num_steps, dt, histogram_bins, seed, storage,
+                num_threads, quantiles, confidence_levels, keep_final_prices, variance_reduction,
+                model, heston, merton, garch);
+            config.path_precision = path_precision;
+            config.output_stride = output_stride;
+            config.log_space = log_space;
+            if (export_path) {
+                config.export_paths = {*export_path, export_float32, export_step_stride};
+            }
+            return quant::run_monte_carlo(config, workspace);
+        },
         R"pbdoc(
             Run Monte Carlo simulation using Geometric Brownian Motion.
 
-            Simulates price paths using the GBM model:
+            Simulates price paths using the GBM model by default:
                 S(t+dt) = S(t) * exp((mu - 0.5*sigma^2)*dt + sigma*sqrt(dt)*Z)
 
+            model selects Heston, Merton jump-diffusion or GARCH(1,1) paths
+            instead; each model runs its own compiled step loop.
+
             Args:
                 s0: Initial price (spot price)
                 mu: Annualized drift (expected return)
@@ -86,6 +601,51 @@ PYBIND11_MODULE(monte_carlo_engine, m) {
                 dt: Time increment (e.g., 1.0/252.0 for daily)
                 histogram_bins: Number of histogram bins (default: 50)
                 seed: Random seed, 0 for random (default: 0)
+                storage: PathStorage.Full or PathStorage.Streaming
+                    (default: Full). Streaming never materializes the
+                    path matrix and needs O(num_simulations) memory.
+                path_precision: PathPrecision.Double or
+                    PathPrecision.Float32 (default: Double). Float32 keeps
+                    the step rows in float32: mean_path and the bands move
+                    by at most a relative 2^-24, everything else is
+                    unchanged.
+                output_stride: Aggregate every k-th step and the last
+                    one (default: 1); result.steps lists them. Final
+                    prices and drawdowns still follow every step.
+                log_space: Accumulate log prices and exponentiate only at
+                    aggregated steps (default: False). Equal to the
+                    default up to rounding; with output_stride > 1 most
+                    per-step exponentials are skipped.
+                num_threads: Worker threads, 0 for all cores (default: 0).
+                    Output for a given seed does not depend on it.
+                quantiles: Quantiles in [0, 1] for percentile_bands
+                    (default: [0.05, 0.95]). All bands share one
+                    selection pass per step.
+                confidence_levels: Levels in (0, 1) for VaR, expected
+                    shortfall and drawdown quantiles (default: [0.95, 0.99])
+                keep_final_prices: Also return every final price in
+                    final_prices (default: False)
+                variance_reduction: Shock scheme, a VarianceReduction
+                    (default: Plain). standard_error uses the matching
+                    estimator.
+                model: Price process, a ProcessModel (default: GBM)
+                heston: HestonParams, used when model is Heston
+                merton: MertonParams, used when model is Merton
+                garch: GarchParams, used when model is GARCH
+                workspace: SimulationWorkspace to draw scratch buffers from
+                    (default: None, the calling thread's)
+                export_path: Also write every path to this file while
+                    simulating (default: None). Rows are one exported step
+                    of all paths (see read_path_export in
+                    app/services/path_export.py); the file appears
+                    complete or not at all. Streaming storage writes as
+                    each block of steps finishes.
+                export_float32: Store exported values as float32
+                    (default: True)
+                export_step_stride: Export every k-th step plus the
+                    final one (default: 1)
+
+            The GIL is released while the simulation runs.
 
             Returns:
                 SimulationResult with aggregated statistics
@@ -107,7 +667,263 @@ PYBIND11_MODULE(monte_carlo_engine, m) {
         py::arg("num_steps"),
         py::arg("dt"),
         py::arg("histogram_bins") = 50,
-        py::arg("seed") = 0
+        py::arg("seed") = 0,
+        py::arg("storage") = quant::PathStorage::Full,
+        py::arg("path_precision") = quant::PathPrecision::Double,
+        py::arg("output_stride") = 1,
+        py::arg("log_space") = false,
+        py::arg("num_threads") = 0,
+        py::arg("quantiles") = std::vector<double>{0.05, 0.95},
+        py::arg("confidence_levels") = std::vector<double>{0.95, 0.99},
+        py::arg("keep_final_prices") = false,
+        py::arg("variance_reduction") = quant::VarianceReduction::None,
+        py::arg("model") = quant::ProcessModel::GBM,
+        py::arg("heston") = quant::HestonParams(),
+        py::arg("merton") = quant::MertonParams(),
+        py::arg("garch") = quant::GarchParams(),
+        py::arg("workspace") = static_cast<quant::SimulationWorkspace*>(nullptr),
+        py::arg("export_path") = std::nullopt,
+        py::arg("export_float32") = true,
+        py::arg("export_step_stride") = 1,
+        py::call_guard<py::gil_scoped_release>()
+    );
+
+    // Bind run_monte_carlo_batch: one call for K tickers sharing every option
+    m.def("run_monte_carlo_batch",
+        [](const std::vector<double>& s0, const std::vector<double>& mu, const std::vector<double>& sigma,
+           int num_simulations, int num_steps, double dt, int histogram_bins, uint64_t seed,
+           quant::PathStorage storage, quant::PathPrecision path_precision, int output_stride,
+           bool log_space, int num_threads, const std::vector<double>& quantiles,
+           const std::vector<double>& confidence_levels,
+           bool keep_final_prices, quant::VarianceReduction variance_reduction, quant::ProcessModel model,
+           const quant::HestonParams& heston, const quant::MertonParams& merton,
+           const quant::GarchParams& garch, quant::SimulationWorkspace* workspace) {
+            if (mu.size() != s0.size() || sigma.size() != s0.size()) {
+                throw std::invalid_argument("s0, mu and sigma must have the same length");
+            }
+            std::vector<quant::BatchMember> members(s0.size());
+            for (size_t k = 0; k < members.size(); ++k) {
+                members[k] = {s0[k], mu[k], sigma[k]};
+            }
+            quant::SimulationConfig config = simulation_config(
+                0.0, 0.0, 0.0, num_simulations, num_steps, dt, histogram_bins, seed, storage,
+                num_threads, quantiles, confidence_levels, keep_final_prices, variance_reduction,
+                model, heston, merton, garch);
+            config.path_precision = path_precision;
+            config.output_stride = output_stride;
+            config.log_space = log_space;
+            return quant::run_monte_carlo_batch(config, members, workspace);
+        },
+        R"pbdoc(
+            Run one simulation per (s0, mu, sigma) in a single call.
+
+            Every other argument is shared and means what it does in
+            run_monte_carlo; result k is identical to run_monte_carlo with
+            s0[k], mu[k] and sigma[k]. The members run in parallel on the
+            thread pool, with the GIL released throughout, and invalid
+            members fail the call before anything runs.
+
+            Args:
+                s0: Initial price of each member
+                mu: Annualized drift of each member
+                sigma: Annualized volatility of each member
+
+            Returns:
+                list of SimulationResult, one per member
+        )pbdoc",
+        py::arg("s0"),
+        py::arg("mu"),
+        py::arg("sigma"),
+        py::arg("num_simulations"),
+        py::arg("num_steps"),
+        py::arg("dt"),
+        py::arg("histogram_bins") = 50,
+        py::arg("seed") = 0,
+        py::arg("storage") = quant::PathStorage::Full,
+        py::arg("path_precision") = quant::PathPrecision::Double,
+        py::arg("output_stride") = 1,
+        py::arg("log_space") = false,
+        py::arg("num_threads") = 0,
+        py::arg("quantiles") = std::vector<double>{0.05, 0.95},
+        py::arg("confidence_levels") = std::vector<double>{0.95, 0.99},
+        py::arg("keep_final_prices") = false,
+        py::arg("variance_reduction") = quant::VarianceReduction::None,
+        py::arg("model") = quant::ProcessModel::GBM,
+        py::arg("heston") = quant::HestonParams(),
+        py::arg("merton") = quant::MertonParams(),
+        py::arg("garch") = quant::GarchParams(),
+        py::arg("workspace") = static_cast<quant::SimulationWorkspace*>(nullptr),
+        py::call_guard<py::gil_scoped_release>()
+    );
+
+    // Bind CancellationToken; shared with a run through its Python object
+    py::class_<quant::CancellationToken>(m, "CancellationToken",
+        R"pbdoc(
+            Cancellation flag for ProgressiveSimulation.run().
+
+            cancel() may be called from any thread (e.g. the event loop)
+            while a chunk runs with the GIL released; the engine stops at
+            its next block of paths.
+        )pbdoc")
+        .def(py::init<>())
+        .def("cancel", &quant::CancellationToken::cancel)
+        .def_property_readonly("cancelled", &quant::CancellationToken::cancelled);
+
+    // Bind ProgressiveSimulation (chunked run with snapshots)
+    py::class_<quant::ProgressiveSimulation>(m, "ProgressiveSimulation",
+        R"pbdoc(
+            Monte Carlo run of num_simulations paths, simulated in chunks.
+
+            The paths are exactly those of run_monte_carlo with the same
+            arguments, however the run is split. Snapshots are exact for
+            terminal statistics, tail risk, drawdowns, standard error and
+            the mean path; percentile bands are the path-weighted average
+            of each chunk's bands. Paths are always aggregated in
+            streaming mode.
+
+            Example:
+                >>> sim = ProgressiveSimulation(s0=100.0, mu=0.08, sigma=0.2,
+                ...     num_simulations=1_000_000, num_steps=252, dt=1/252)
+                >>> while not sim.done:
+                ...     sim.run(50_000)
+                ...     partial = sim.snapshot()
+        )pbdoc")
+        .def(py::init([](double s0, double mu, double sigma, int num_simulations, int num_steps,
+                         double dt, int histogram_bins, uint64_t seed,
+                         quant::PathPrecision path_precision, int output_stride, bool log_space,
+                         int num_threads,
+                         const std::vector<double>& quantiles,
+                         const std::vector<double>& confidence_levels, bool keep_final_prices,
+                         quant::VarianceReduction variance_reduction, quant::ProcessModel model,
+                         const quant::HestonParams& heston, const quant::MertonParams& merton,
+                         const quant::GarchParams& garch) {
+                 quant::SimulationConfig config = simulation_config(
+                     s0, mu, sigma, num_simulations, num_steps, dt, histogram_bins, seed,
+                     quant::PathStorage::Streaming, num_threads, quantiles, confidence_levels,
+                     keep_final_prices, variance_reduction, model, heston, merton, garch);
+                 config.path_precision = path_precision;
+                 config.output_stride = output_stride;
+                 config.log_space = log_space;
+                 return new quant::ProgressiveSimulation(config);
+             }),
+            py::arg("s0"),
+            py::arg("mu"),
+            py::arg("sigma"),
+            py::arg("num_simulations"),
+            py::arg("num_steps"),
+            py::arg("dt"),
+            py::arg("histogram_bins") = 50,
+            py::arg("seed") = 0,
+            py::arg("path_precision") = quant::PathPrecision::Double,
+            py::arg("output_stride") = 1,
+            py::arg("log_space") = false,
+            py::arg("num_threads") = 0,
+            py::arg("quantiles") = std::vector<double>{0.05, 0.95},
+            py::arg("confidence_levels") = std::vector<double>{0.95, 0.99},
+            py::arg("keep_final_prices") = false,
+            py::arg("variance_reduction") = quant::VarianceReduction::None,
+            py::arg("model") = quant::ProcessModel::GBM,
+            py::arg("heston") = quant::HestonParams(),
+            py::arg("merton") = quant::MertonParams(),
+            py::arg("garch") = quant::GarchParams())
+        .def("run", &quant::ProgressiveSimulation::run,
+            R"pbdoc(
+                Simulate up to num_paths more paths (rounded up to whole
+                64-path tiles, cut at the total).
+
+                The GIL is released while the chunk runs. A chunk stopped
+                through cancel is discarded.
+
+                Returns:
+                    Paths added (0 when cancelled or already complete)
+            )pbdoc",
+            py::arg("num_paths"),
+            py::arg("cancel") = nullptr,
+            py::call_guard<py::gil_scoped_release>())
+        .def("snapshot", &quant::ProgressiveSimulation::snapshot,
+            "SimulationResult over the completed paths",
+            py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("completed_paths", &quant::ProgressiveSimulation::completed_paths)
+        .def_property_readonly("total_paths", &quant::ProgressiveSimulation::total_paths)
+        .def_property_readonly("done", &quant::ProgressiveSimulation::done);
+
+    // Bind run_portfolio_monte_carlo over a mean vector and covariance matrix
+    m.def("run_portfolio_monte_carlo",
+        [](std::vector<double> mean, const DoubleArray& covariance, std::vector<double> weights,
+           double initial_value, int num_simulations, int num_steps, int histogram_bins,
+           uint64_t seed, quant::PathStorage storage, int num_threads,
+           const std::vector<double>& quantiles, const std::vector<double>& confidence_levels,
+           bool keep_final_values) {
+            const py::ssize_t n = static_cast<py::ssize_t>(mean.size());
+            if (covariance.ndim() != 2 || covariance.shape(0) != n || covariance.shape(1) != n) {
+                throw std::invalid_argument("covariance must be a num_assets x num_assets matrix");
+            }
+
+            quant::PortfolioConfig config;
+            config.mean = std::move(mean);
+            config.covariance.assign(covariance.data(), covariance.data() + covariance.size());
+            config.weights = std::move(weights);
+            config.initial_value = initial_value;
+            config.num_simulations = num_simulations;
+            config.num_steps = num_steps;
+            config.histogram_bins = histogram_bins;
+            config.seed = seed;
+            config.storage = storage;
+            config.num_threads = num_threads;
+            config.quantiles = quantiles;
+            config.confidence_levels = confidence_levels;
+            config.keep_final_values = keep_final_values;
+
+            py::gil_scoped_release release;
+            return quant::run_portfolio_monte_carlo(config);
+        },
+        R"pbdoc(
+            Run a correlated multi-asset Monte Carlo on portfolio value.
+
+            Each step, asset log prices move by mean + L z with
+            L = cholesky(covariance) and z independent standard normals;
+            each path's value is initial_value * sum(weights * S(t) / S(0)).
+            Only portfolio values are aggregated (no per-asset paths).
+
+            Args:
+                mean: Mean log return per step of each asset
+                covariance: Covariance of per-step log returns
+                    (num_assets x num_assets, positive semi-definite)
+                weights: Fraction of initial_value held in each asset
+                initial_value: Portfolio value at t = 0 (default: 1.0)
+                num_simulations: Number of simulation paths
+                num_steps: Number of time steps per path
+                histogram_bins: Number of histogram bins (default: 50)
+                seed: Random seed, 0 for random (default: 0)
+                storage: PathStorage.Full or PathStorage.Streaming
+                    (default: Full)
+                num_threads: Worker threads, 0 for all cores (default: 0)
+                quantiles: Quantiles in [0, 1] for percentile_bands
+                    (default: [0.05, 0.95])
+                confidence_levels: Levels in (0, 1) for VaR, expected
+                    shortfall and drawdown quantiles (default: [0.95, 0.99])
+                keep_final_values: Also return every final value in
+                    final_prices (default: False)
+
+            The GIL is released while the simulation runs.
+
+            Returns:
+                SimulationResult over portfolio values; VaR and the
+                probability of loss are measured from the value at t = 0
+        )pbdoc",
+        py::arg("mean"),
+        py::arg("covariance"),
+        py::arg("weights"),
+        py::arg("initial_value") = 1.0,
+        py::arg("num_simulations") = 10000,
+        py::arg("num_steps") = 252,
+        py::arg("histogram_bins") = 50,
+        py::arg("seed") = 0,
+        py::arg("storage") = quant::PathStorage::Full,
+        py::arg("num_threads") = 0,
+        py::arg("quantiles") = std::vector<double>{0.05, 0.95},
+        py::arg("confidence_levels") = std::vector<double>{0.95, 0.99},
+        py::arg("keep_final_values") = false
     );
 
     // Bind GreeksResult struct
@@ -154,6 +970,988 @@ PYBIND11_MODULE(monte_carlo_engine, m) {
         py::arg("is_call") = true
     );
 
+    // Bind GreeksBatch struct
+    py::class_<quant::GreeksBatch>(m, "GreeksBatch",
+        R"pbdoc(
+            Black-Scholes Greeks of an option chain, one array per Greek.
+
+            Arrays are read-only NumPy views (no copy), units as in
+            GreeksResult.
+
+            Attributes:
+                delta, gamma, vega, theta, rho
+        )pbdoc")
+        .def_property_readonly("delta", array_property(&quant::GreeksBatch::delta))
+        .def_property_readonly("gamma", array_property(&quant::GreeksBatch::gamma))
+        .def_property_readonly("vega", array_property(&quant::GreeksBatch::vega))
+        .def_property_readonly("theta", array_property(&quant::GreeksBatch::theta))
+        .def_property_readonly("rho", array_property(&quant::GreeksBatch::rho))
+        .def("__len__", [](const quant::GreeksBatch& g) { return g.delta.size(); });
+
+    // Bind calculate_greeks_batch over NumPy arrays
+    m.def("calculate_greeks_batch",
+        [](const DoubleArray& strike, const DoubleArray& time_to_expiry, const DoubleArray& spot,
+           const DoubleArray& risk_free_rate, const DoubleArray& volatility,
+           const BoolArray& is_call) {
+            const py::ssize_t n = std::max({strike.size(), time_to_expiry.size(), spot.size(),
+                                            risk_free_rate.size(), volatility.size(), is_call.size()});
+
+            std::vector<double> k, t, s, r, v;
+            const double* k_ptr = broadcast(strike, n, k, "strike");
+            const double* t_ptr = broadcast(time_to_expiry, n, t, "time_to_expiry");
+            const double* s_ptr = broadcast(spot, n, s, "spot");
+            const double* r_ptr = broadcast(risk_free_rate, n, r, "risk_free_rate");
+            const double* v_ptr = broadcast(volatility, n, v, "volatility");
+
+            std::unique_ptr<bool[]> c;
+            const bool* c_ptr = broadcast(is_call, n, c, "is_call");
+
+            py::gil_scoped_release release;
+            return quant::calculate_greeks_batch(k_ptr, t_ptr, s_ptr, r_ptr, v_ptr, c_ptr,
+                                                 static_cast<std::size_t>(n));
+        },
+        R"pbdoc(
+            Calculate Black-Scholes Greeks for a whole option chain.
+
+            Takes array-likes (size-1 inputs are broadcast, e.g. one spot
+            and rate for every strike). Shared terms are computed once per
+            option and the GIL is released during the computation.
+
+            Args:
+                strike: Strike prices
+                time_to_expiry: Times to expiry in years
+                spot: Current spot prices
+                risk_free_rate: Risk-free interest rates
+                volatility: Implied volatilities
+                is_call: True for Call, False for Put (default: True)
+
+            Returns:
+                GreeksBatch with one NumPy array per Greek
+        )pbdoc",
+        py::arg("strike"),
+        py::arg("time_to_expiry"),
+        py::arg("spot"),
+        py::arg("risk_free_rate"),
+        py::arg("volatility"),
+        py::arg("is_call") = true
+    );
+
+    // Bind IvStatus enum
+    py::enum_<quant::IvStatus>(m, "IvStatus",
+        R"pbdoc(
+            Outcome of the implied-volatility search for one option.
+            ImpliedVolBatch.status holds these as uint8 values.
+
+            Values:
+                Converged: Volatility step below the tolerance
+                MaxIterations: Iteration cap hit (best estimate returned)
+                OutOfBounds: Price violates the no-arbitrage bounds
+                InvalidInput: Non-positive strike/spot/expiry or bad price
+        )pbdoc")
+        .value("Converged", quant::IvStatus::Converged)
+        .value("MaxIterations", quant::IvStatus::MaxIterations)
+        .value("OutOfBounds", quant::IvStatus::OutOfBounds)
+        .value("InvalidInput", quant::IvStatus::InvalidInput);
+
+    // Bind ImpliedVolBatch struct
+    py::class_<quant::ImpliedVolBatch>(m, "ImpliedVolBatch",
+        R"pbdoc(
+            Implied volatilities of an option chain (read-only NumPy views).
+
+            Attributes:
+                volatility: Implied volatility per option (NaN if unsolved)
+                iterations: Newton/bisection steps taken per option
+                status: IvStatus value per option (uint8)
+        )pbdoc")
+        .def_property_readonly("volatility", array_property(&quant::ImpliedVolBatch::volatility))
+        .def_property_readonly("iterations", array_property(&quant::ImpliedVolBatch::iterations))
+        .def_property_readonly("status", array_property(&quant::ImpliedVolBatch::status))
+        .def("__len__", [](const quant::ImpliedVolBatch& b) { return b.volatility.size(); });
+
+    // Bind implied_volatility_batch over NumPy arrays
+    m.def("implied_volatility_batch",
+        [](const DoubleArray& price, const DoubleArray& strike, const DoubleArray& time_to_expiry,
+           const DoubleArray& spot, const DoubleArray& risk_free_rate, const BoolArray& is_call,
+           double tolerance, int max_iterations) {
+            const py::ssize_t n = std::max({price.size(), strike.size(), time_to_expiry.size(),
+                                            spot.size(), risk_free_rate.size(), is_call.size()});
+
+            std::vector<double> p, k, t, s, r;
+            std::unique_ptr<bool[]> c;
+            const double* p_ptr = broadcast(price, n, p, "price");
+            const double* k_ptr = broadcast(strike, n, k, "strike");
+            const double* t_ptr = broadcast(time_to_expiry, n, t, "time_to_expiry");
+            const double* s_ptr = broadcast(spot, n, s, "spot");
+            const double* r_ptr = broadcast(risk_free_rate, n, r, "risk_free_rate");
+            const bool* c_ptr = broadcast(is_call, n, c, "is_call");
+
+            py::gil_scoped_release release;
+            return quant::implied_volatility_batch(p_ptr, k_ptr, t_ptr, s_ptr, r_ptr, c_ptr,
+                                                   static_cast<std::size_t>(n), tolerance,
+                                                   max_iterations);
+        },
+        R"pbdoc(
+            Back out Black-Scholes implied volatility for a whole chain.
+
+            Safeguarded Newton-Raphson from a closed-form initial guess,
+            falling back to bisection inside a shrinking bracket. Size-1
+            inputs are broadcast; the GIL is released while solving.
+
+            Args:
+                price: Option prices (e.g. bid/ask mids)
+                strike: Strike prices
+                time_to_expiry: Times to expiry in years
+                spot: Current spot prices
+                risk_free_rate: Risk-free interest rates
+                is_call: True for Call, False for Put (default: True)
+                tolerance: Convergence threshold on volatility (default: 1e-8)
+                max_iterations: Iteration cap per option (default: 100)
+
+            Returns:
+                ImpliedVolBatch with volatility, iterations and status arrays
+        )pbdoc",
+        py::arg("price"),
+        py::arg("strike"),
+        py::arg("time_to_expiry"),
+        py::arg("spot"),
+        py::arg("risk_free_rate"),
+        py::arg("is_call") = true,
+        py::arg("tolerance") = 1e-8,
+        py::arg("max_iterations") = 100
+    );
+
+    // Bind black_scholes_price function
+    m.def("black_scholes_price", &quant::black_scholes_price,
+        R"pbdoc(
+            Black-Scholes price of a European option.
+
+            Args:
+                strike: Strike price
+                time_to_expiry: Time to expiry in years
+                spot: Current spot price
+                risk_free_rate: Risk-free interest rate
+                volatility: Volatility
+                is_call: True for Call, False for Put (default: True)
+        )pbdoc",
+        py::arg("strike"),
+        py::arg("time_to_expiry"),
+        py::arg("spot"),
+        py::arg("risk_free_rate"),
+        py::arg("volatility"),
+        py::arg("is_call") = true
+    );
+
+    // Bind AmericanOptionBatch struct
+    py::class_<quant::AmericanOptionBatch>(m, "AmericanOptionBatch",
+        R"pbdoc(
+            Longstaff-Schwartz prices and Greeks of an option chain.
+
+            Arrays are read-only NumPy views (no copy), Greeks in the units
+            of GreeksResult.
+
+            Attributes:
+                price: American (Bermudan) price per option
+                standard_error: Monte Carlo standard error of price
+                delta, gamma, vega, theta, rho
+        )pbdoc")
+        .def_property_readonly("price", array_property(&quant::AmericanOptionBatch::price))
+        .def_property_readonly("standard_error", array_property(&quant::AmericanOptionBatch::standard_error))
+        .def_property_readonly("delta", array_property(&quant::AmericanOptionBatch::delta))
+        .def_property_readonly("gamma", array_property(&quant::AmericanOptionBatch::gamma))
+        .def_property_readonly("vega", array_property(&quant::AmericanOptionBatch::vega))
+        .def_property_readonly("theta", array_property(&quant::AmericanOptionBatch::theta))
+        .def_property_readonly("rho", array_property(&quant::AmericanOptionBatch::rho))
+        .def("__len__", [](const quant::AmericanOptionBatch& b) { return b.price.size(); });
+
+    // Bind price_american_batch over NumPy arrays
+    m.def("price_american_batch",
+        [](const DoubleArray& strike, const DoubleArray& time_to_expiry, const DoubleArray& spot,
+           const DoubleArray& risk_free_rate, const DoubleArray& volatility,
+           const DoubleArray& dividend_yield, const BoolArray& is_call, int num_simulations,
+           int exercise_dates, int basis_degree, uint64_t seed, int num_threads,
+           quant::VarianceReduction variance_reduction, quant::SimulationWorkspace* workspace) {
+            const py::ssize_t n = std::max({strike.size(), time_to_expiry.size(), spot.size(),
+                                            risk_free_rate.size(), volatility.size(),
+                                            dividend_yield.size(), is_call.size()});
+
+            std::vector<double> k, t, s, r, v, q;
+            std::unique_ptr<bool[]> c;
+            const double* k_ptr = broadcast(strike, n, k, "strike");
+            const double* t_ptr = broadcast(time_to_expiry, n, t, "time_to_expiry");
+            const double* s_ptr = broadcast(spot, n, s, "spot");
+            const double* r_ptr = broadcast(risk_free_rate, n, r, "risk_free_rate");
+            const double* v_ptr = broadcast(volatility, n, v, "volatility");
+            const double* q_ptr = broadcast(dividend_yield, n, q, "dividend_yield");
+            const bool* c_ptr = broadcast(is_call, n, c, "is_call");
+
+            quant::LsmConfig config;
+            config.num_simulations = num_simulations;
+            config.exercise_dates = exercise_dates;
+            config.basis_degree = basis_degree;
+            config.seed = seed;
+            config.num_threads = num_threads;
+            config.variance_reduction = variance_reduction;
+
+            py::gil_scoped_release release;
+            return quant::price_american_batch(k_ptr, t_ptr, s_ptr, r_ptr, v_ptr, q_ptr, c_ptr,
+                                               static_cast<std::size_t>(n), config, workspace);
+        },
+        R"pbdoc(
+            Price American options on a whole chain by Longstaff-Schwartz.
+
+            GBM paths of each option are sampled at exercise_dates equally
+            spaced dates; working back from expiry, the discounted cash
+            flow of in-the-money paths is regressed on a polynomial in S/K
+            (QR least squares) to decide exercise. Greeks are pathwise
+            (delta, vega, rho) and likelihood-ratio (gamma) under the
+            fitted exercise policy; theta comes from the Black-Scholes
+            equation. Size-1 inputs are broadcast, every option uses the
+            same shocks, and the GIL is released while pricing.
+
+            Args:
+                strike: Strike prices
+                time_to_expiry: Times to expiry in years
+                spot: Current spot prices
+                risk_free_rate: Risk-free interest rates
+                volatility: Volatilities
+                dividend_yield: Continuous dividend yields (default: 0.0)
+                is_call: True for Call, False for Put (default: True)
+                num_simulations: Paths per option (default: 50000)
+                exercise_dates: Exercise dates up to expiry (default: 50)
+                basis_degree: Regression polynomial degree, 1-6 (default: 3)
+                seed: Random seed, 0 for random (default: 0)
+                num_threads: Worker threads, 0 for all cores (default: 0).
+                    Output for a given seed does not depend on it.
+                variance_reduction: VarianceReduction mode of the paths
+                    (default: None)
+                workspace: SimulationWorkspace for the path matrix
+                    (default: the calling thread's)
+
+            Returns:
+                AmericanOptionBatch with price, standard_error and Greeks
+        )pbdoc",
+        py::arg("strike"),
+        py::arg("time_to_expiry"),
+        py::arg("spot"),
+        py::arg("risk_free_rate"),
+        py::arg("volatility"),
+        py::arg("dividend_yield") = 0.0,
+        py::arg("is_call") = true,
+        py::arg("num_simulations") = 50000,
+        py::arg("exercise_dates") = 50,
+        py::arg("basis_degree") = 3,
+        py::arg("seed") = 0,
+        py::arg("num_threads") = 0,
+        py::arg("variance_reduction") = quant::VarianceReduction::None,
+        py::arg("workspace") = static_cast<quant::SimulationWorkspace*>(nullptr)
+    );
+
+    // Bind ScenarioResult struct
+    py::class_<quant::ScenarioResult>(m, "ScenarioResult",
+        R"pbdoc(
+            Prices and Greeks of a book over a spot x vol shock grid.
+
+            Arrays are read-only NumPy views (no copy), units as in
+            GreeksResult. Per-position arrays are empty (0 positions) when
+            per_position=False.
+
+            Attributes:
+                num_positions, num_spot, num_vol: Grid dimensions
+                price, delta, gamma, vega, theta, rho: (position, spot, vol)
+                book_price, book_delta, book_gamma, book_vega, book_theta,
+                book_rho: Quantity-weighted totals, (spot, vol)
+        )pbdoc")
+        .def_readonly("num_positions", &quant::ScenarioResult::num_positions)
+        .def_readonly("num_spot", &quant::ScenarioResult::num_spot)
+        .def_readonly("num_vol", &quant::ScenarioResult::num_vol)
+        .def_property_readonly("price", scenario_property(&quant::ScenarioResult::price))
+        .def_property_readonly("delta", scenario_property(&quant::ScenarioResult::delta))
+        .def_property_readonly("gamma", scenario_property(&quant::ScenarioResult::gamma))
+        .def_property_readonly("vega", scenario_property(&quant::ScenarioResult::vega))
+        .def_property_readonly("theta", scenario_property(&quant::ScenarioResult::theta))
+        .def_property_readonly("rho", scenario_property(&quant::ScenarioResult::rho))
+        .def_property_readonly("book_price", book_property(&quant::ScenarioResult::book_price))
+        .def_property_readonly("book_delta", book_property(&quant::ScenarioResult::book_delta))
+        .def_property_readonly("book_gamma", book_property(&quant::ScenarioResult::book_gamma))
+        .def_property_readonly("book_vega", book_property(&quant::ScenarioResult::book_vega))
+        .def_property_readonly("book_theta", book_property(&quant::ScenarioResult::book_theta))
+        .def_property_readonly("book_rho", book_property(&quant::ScenarioResult::book_rho));
+
+    // Bind run_scenario_grid over NumPy arrays
+    m.def("run_scenario_grid",
+        [](const DoubleArray& strike, const DoubleArray& time_to_expiry, const DoubleArray& volatility,
+           double spot, double risk_free_rate, std::vector<double> spot_shocks,
+           std::vector<double> vol_shocks, const BoolArray& is_call, const DoubleArray& quantity,
+           bool per_position, int num_threads) {
+            const py::ssize_t n = std::max({strike.size(), time_to_expiry.size(), volatility.size(),
+                                            is_call.size(), quantity.size()});
+
+            std::vector<double> k, t, v, q;
+            std::unique_ptr<bool[]> c;
+            const double* k_ptr = broadcast(strike, n, k, "strike");
+            const double* t_ptr = broadcast(time_to_expiry, n, t, "time_to_expiry");
+            const double* v_ptr = broadcast(volatility, n, v, "volatility");
+            const double* q_ptr = broadcast(quantity, n, q, "quantity");
+            const bool* c_ptr = broadcast(is_call, n, c, "is_call");
+
+            std::vector<quant::OptionPosition> positions(static_cast<std::size_t>(n));
+            for (py::ssize_t i = 0; i < n; ++i) {
+                positions[i] = {k_ptr[i], t_ptr[i], v_ptr[i], q_ptr[i], c_ptr[i]};
+            }
+
+            quant::ScenarioGrid grid;
+            grid.spot_shocks = std::move(spot_shocks);
+            grid.vol_shocks = std::move(vol_shocks);
+
+            py::gil_scoped_release release;
+            return quant::run_scenario_grid(positions, spot, risk_free_rate, grid,
+                                            per_position, num_threads);
+        },
+        R"pbdoc(
+            Reprice a book of options over a spot x vol shock grid.
+
+            Every position is priced under every (spot shock, vol shock)
+            pair. Size-1 position inputs are broadcast; the GIL is released
+            during the computation.
+
+            Args:
+                strike: Strike per position
+                time_to_expiry: Time to expiry in years per position
+                volatility: Unshocked implied volatility per position
+                spot: Current spot price
+                risk_free_rate: Risk-free interest rate
+                spot_shocks: Relative spot shocks (spot * (1 + shock))
+                vol_shocks: Absolute vol shocks, volatility + shock
+                    (default: [0.0])
+                is_call: True for Call, False for Put (default: True)
+                quantity: Signed contracts per position (default: 1)
+                per_position: Also return per-position arrays (default: True)
+                num_threads: Worker threads, 0 = all cores (default: 0)
+
+            Returns:
+                ScenarioResult with per-position and book arrays
+        )pbdoc",
+        py::arg("strike"),
+        py::arg("time_to_expiry"),
+        py::arg("volatility"),
+        py::arg("spot"),
+        py::arg("risk_free_rate"),
+        py::arg("spot_shocks"),
+        py::arg("vol_shocks") = std::vector<double>{0.0},
+        py::arg("is_call") = true,
+        py::arg("quantity") = 1.0,
+        py::arg("per_position") = true,
+        py::arg("num_threads") = 0
+    );
+
+    // Bind pairs backtest results
+    py::class_<quant::PairsMetrics>(m, "PairsMetrics",
+        "Performance of one pairs backtest over its daily returns")
+        .def_readonly("total_return", &quant::PairsMetrics::total_return)
+        .def_readonly("sharpe_ratio", &quant::PairsMetrics::sharpe_ratio)
+        .def_readonly("max_drawdown", &quant::PairsMetrics::max_drawdown)
+        .def_readonly("win_rate", &quant::PairsMetrics::win_rate)
+        .def_readonly("trades", &quant::PairsMetrics::trades);
+
+    py::class_<quant::PairsBacktestResult>(m, "PairsBacktestResult",
+        R"pbdoc(
+            One pairs backtest: metrics, the daily position (-1, 0, +1) and
+            the equity and drawdown curves (one entry per return, i.e. from
+            the second day on).
+        )pbdoc")
+        .def_readonly("metrics", &quant::PairsBacktestResult::metrics)
+        .def_property_readonly("position", array_property(&quant::PairsBacktestResult::position))
+        .def_property_readonly("equity_curve", array_property(&quant::PairsBacktestResult::equity_curve))
+        .def_property_readonly("drawdown", array_property(&quant::PairsBacktestResult::drawdown));
+
+    py::class_<quant::PairsGridResult>(m, "PairsGridResult",
+        "Pairs backtest metrics as (entry_z, exit_z) arrays")
+        .def_readonly("num_entry", &quant::PairsGridResult::num_entry)
+        .def_readonly("num_exit", &quant::PairsGridResult::num_exit)
+        .def_property_readonly("total_return", pairs_grid_property(&quant::PairsGridResult::total_return))
+        .def_property_readonly("sharpe_ratio", pairs_grid_property(&quant::PairsGridResult::sharpe_ratio))
+        .def_property_readonly("max_drawdown", pairs_grid_property(&quant::PairsGridResult::max_drawdown))
+        .def_property_readonly("win_rate", pairs_grid_property(&quant::PairsGridResult::win_rate))
+        .def_property_readonly("trades", pairs_grid_property(&quant::PairsGridResult::trades));
+
+    // Bind run_pairs_backtest over NumPy arrays
+    m.def("run_pairs_backtest",
+        [](const DoubleArray& z_score, const DoubleArray& spread, const DoubleArray& capital,
+           double entry_z, double exit_z, double stop_loss_z) {
+            const quant::PairsSeries series = pairs_series(z_score, spread, capital);
+            py::gil_scoped_release release;
+            return quant::run_pairs_backtest(series, {entry_z, exit_z, stop_loss_z});
+        },
+        R"pbdoc(
+            Backtest a z-score pairs strategy and return its curves.
+
+            Long the spread below -entry_z, short above +entry_z; flat once
+            the z-score is back inside +-exit_z or beyond +-stop_loss_z.
+            The position of day i - 1 earns (spread[i] - spread[i - 1]) /
+            capital[i].
+
+            Args:
+                z_score: Daily z-score of the spread
+                spread: Daily spread, price_1 - hedge_ratio * price_2
+                capital: Daily capital, price_1 + hedge_ratio * price_2
+                entry_z, exit_z, stop_loss_z: Thresholds
+
+            Returns:
+                PairsBacktestResult
+        )pbdoc",
+        py::arg("z_score"),
+        py::arg("spread"),
+        py::arg("capital"),
+        py::arg("entry_z"),
+        py::arg("exit_z"),
+        py::arg("stop_loss_z")
+    );
+
+    // Bind run_pairs_grid over NumPy arrays
+    m.def("run_pairs_grid",
+        [](const DoubleArray& z_score, const DoubleArray& spread, const DoubleArray& capital,
+           const std::vector<double>& entry_z, const std::vector<double>& exit_z,
+           double stop_loss_z, int num_threads) {
+            const quant::PairsSeries series = pairs_series(z_score, spread, capital);
+            py::gil_scoped_release release;
+            return quant::run_pairs_grid(series, entry_z, exit_z, stop_loss_z, num_threads);
+        },
+        R"pbdoc(
+            Pairs backtest metrics for every (entry_z, exit_z) pair.
+
+            The series are passed once; every cell is evaluated in one pass
+            without building curves, and cells run in parallel with the
+            GIL released. Use run_pairs_backtest for the curves of the
+            chosen cell.
+
+            Args:
+                z_score, spread, capital: As for run_pairs_backtest
+                entry_z: Entry thresholds (rows)
+                exit_z: Exit thresholds (columns)
+                stop_loss_z: Stop-loss threshold of every cell
+                num_threads: Worker threads, 0 = all cores (default: 0)
+
+            Returns:
+                PairsGridResult with (len(entry_z), len(exit_z)) arrays
+        )pbdoc",
+        py::arg("z_score"),
+        py::arg("spread"),
+        py::arg("capital"),
+        py::arg("entry_z"),
+        py::arg("exit_z"),
+        py::arg("stop_loss_z"),
+        py::arg("num_threads") = 0
+    );
+
+    // Bind RollingStatistics (O(1) windowed mean / std)
+    py::class_<quant::RollingStatistics>(m, "RollingStatistics",
+        R"pbdoc(
+            Mean and sample standard deviation (ddof = 1) of the last
+            `window` values, updated in O(1) per push from a ring buffer.
+        )pbdoc")
+        .def(py::init<int>(), py::arg("window"))
+        .def("push", &quant::RollingStatistics::push, py::arg("value"))
+        .def("reset", &quant::RollingStatistics::reset)
+        .def("z_score", &quant::RollingStatistics::z_score, py::arg("value"))
+        .def("preview_z_score", &quant::RollingStatistics::preview_z_score,
+             "z-score of value against the window push(value) would give, without pushing it",
+             py::arg("value"))
+        .def_property_readonly("window", &quant::RollingStatistics::window)
+        .def_property_readonly("count", &quant::RollingStatistics::count)
+        .def_property_readonly("ready", &quant::RollingStatistics::ready)
+        .def_property_readonly("mean", &quant::RollingStatistics::mean)
+        .def_property_readonly("variance", &quant::RollingStatistics::variance)
+        .def_property_readonly("std_dev", &quant::RollingStatistics::std_dev);
+
+    // Bind PairSignalState struct
+    py::class_<quant::PairSignalState>(m, "PairSignalState",
+        "Spread, rolling z-score and position (-1, 0, +1) of a pair after a bar")
+        .def_readonly("spread", &quant::PairSignalState::spread)
+        .def_readonly("z_score", &quant::PairSignalState::z_score)
+        .def_readonly("position", &quant::PairSignalState::position)
+        .def_readonly("ready", &quant::PairSignalState::ready);
+
+    // Bind PairSignal (live pair z-score and signal)
+    py::class_<quant::PairSignal>(m, "PairSignal",
+        R"pbdoc(
+            Rolling spread z-score and entry/exit state of one pair,
+            updated in O(1) per bar.
+
+            The z-scores and positions equal those of run_pairs_backtest on
+            the same history. seed() replays history once; update() commits
+            each new bar and preview() evaluates a tick of the bar in
+            progress without committing it.
+        )pbdoc")
+        .def(py::init([](double hedge_ratio, int window, double entry_z, double exit_z, double stop_loss_z) {
+                 return new quant::PairSignal(hedge_ratio, window, {entry_z, exit_z, stop_loss_z});
+             }),
+             py::arg("hedge_ratio"), py::arg("window"), py::arg("entry_z") = 2.0,
+             py::arg("exit_z") = 0.0, py::arg("stop_loss_z") = 4.0)
+        .def("seed",
+            [](quant::PairSignal& self, const DoubleArray& price_1, const DoubleArray& price_2) {
+                if (price_1.size() != price_2.size()) {
+                    throw std::invalid_argument("price_1 and price_2 must have the same length");
+                }
+                self.seed(price_1.data(), price_2.data(), static_cast<std::size_t>(price_1.size()));
+            },
+            "Replay historical bars (oldest first)",
+            py::arg("price_1"), py::arg("price_2"))
+        .def("update", &quant::PairSignal::update, "Commit one bar", py::arg("price_1"), py::arg("price_2"))
+        .def("preview", &quant::PairSignal::preview,
+             "State update() would give, without committing the bar",
+             py::arg("price_1"), py::arg("price_2"))
+        .def_property_readonly("state", &quant::PairSignal::state)
+        .def_property_readonly("hedge_ratio", &quant::PairSignal::hedge_ratio)
+        .def_property_readonly("window", [](const quant::PairSignal& self) { return self.statistics().window(); });
+
+    // Bind CointegrationPair struct
+    py::class_<quant::CointegrationPair>(m, "CointegrationPair",
+        R"pbdoc(
+            A pair that passed the cointegration screen. first and second
+            are column indices of the price matrix; the spread is
+            price[first] - hedge_ratio * price[second].
+        )pbdoc")
+        .def_readonly("first", &quant::CointegrationPair::first)
+        .def_readonly("second", &quant::CointegrationPair::second)
+        .def_readonly("correlation", &quant::CointegrationPair::correlation)
+        .def_readonly("hedge_ratio", &quant::CointegrationPair::hedge_ratio)
+        .def_readonly("adf_statistic", &quant::CointegrationPair::adf_statistic)
+        .def_readonly("p_value", &quant::CointegrationPair::p_value)
+        .def_readonly("lags", &quant::CointegrationPair::lags)
+        .def_readonly("half_life", &quant::CointegrationPair::half_life)
+        .def_readonly("spread_mean", &quant::CointegrationPair::spread_mean)
+        .def_readonly("spread_std", &quant::CointegrationPair::spread_std)
+        .def_readonly("last_z_score", &quant::CointegrationPair::last_z_score)
+        .def("__repr__", [](const quant::CointegrationPair& p) {
+            return "<CointegrationPair (" + std::to_string(p.first) + ", " + std::to_string(p.second)
+                 + ") p_value=" + std::to_string(p.p_value) + ">";
+        });
+
+    // Bind screen_cointegrated_pairs over a NumPy price matrix
+    m.def("screen_cointegrated_pairs",
+        [](const DoubleArray& prices, double max_p_value, double min_abs_correlation,
+           int max_lag, int num_threads) {
+            if (prices.ndim() != 2) {
+                throw std::invalid_argument("prices must be a 2-D (observations, assets) array");
+            }
+            quant::CointegrationOptions options;
+            options.max_p_value = max_p_value;
+            options.min_abs_correlation = min_abs_correlation;
+            options.max_lag = max_lag;
+            options.num_threads = num_threads;
+
+            py::gil_scoped_release release;
+            return quant::screen_cointegrated_pairs(
+                prices.data(), static_cast<std::size_t>(prices.shape(0)),
+                static_cast<std::size_t>(prices.shape(1)), options);
+        },
+        R"pbdoc(
+            Engle-Granger test of every column pair (i < j) of a price matrix.
+
+            Each pair regresses column i on column j (hedge ratio), runs an
+            ADF test on the residual with the lag count chosen by AIC (as
+            statsmodels coint) and fits the Ornstein-Uhlenbeck half-life.
+            Pairs whose price correlation is below min_abs_correlation are
+            skipped before the test. Pairs run in parallel with the GIL
+            released.
+
+            Args:
+                prices: (observations, assets) aligned prices, at least 20 rows
+                max_p_value: Keep pairs with a p-value up to this (default: 0.05)
+                min_abs_correlation: Correlation pre-filter, 0 = test all
+                    pairs (default: 0.5)
+                max_lag: Most ADF lags, -1 = 12 (n/100)^(1/4) (default: -1)
+                num_threads: Worker threads, 0 = all cores (default: 0)
+
+            Returns:
+                List of CointegrationPair sorted by (first, second)
+        )pbdoc",
+        py::arg("prices"),
+        py::arg("max_p_value") = 0.05,
+        py::arg("min_abs_correlation") = 0.5,
+        py::arg("max_lag") = -1,
+        py::arg("num_threads") = 0
+    );
+
+    m.def("engle_granger_p_value", &quant::engle_granger_p_value,
+        "MacKinnon approximate p-value of a two-variable Engle-Granger ADF statistic",
+        py::arg("adf_statistic"));
+
+    // Bind HrpAllocation struct
+    py::class_<quant::HrpAllocation>(m, "HrpAllocation",
+        R"pbdoc(
+            Hierarchical Risk Parity weights. weights are in the column order
+            of the returns matrix; order is the quasi-diagonal column order
+            and linkage the single-linkage dendrogram as a read-only
+            (assets - 1, 4) view in scipy.cluster.hierarchy layout.
+        )pbdoc")
+        .def_property_readonly("weights", array_property(&quant::HrpAllocation::weights))
+        .def_property_readonly("order", array_property(&quant::HrpAllocation::order))
+        .def_property_readonly("linkage", [](py::object self) {
+            const quant::HrpAllocation& r = self.cast<const quant::HrpAllocation&>();
+            const py::ssize_t d = static_cast<py::ssize_t>(sizeof(double));
+            return readonly_view<double>(
+                {static_cast<py::ssize_t>(r.linkage.size() / 4), 4},
+                {4 * d, d},
+                r.linkage.data(),
+                self
+            );
+        });
+
+    // Bind hrp_allocation over a NumPy returns matrix
+    m.def("hrp_allocation",
+        [](const DoubleArray& returns, int num_threads) {
+            if (returns.ndim() != 2) {
+                throw std::invalid_argument("returns must be a 2-D (observations, assets) array");
+            }
+            py::gil_scoped_release release;
+            return quant::hrp_allocation(
+                returns.data(), static_cast<std::size_t>(returns.shape(0)),
+                static_cast<std::size_t>(returns.shape(1)), num_threads);
+        },
+        R"pbdoc(
+            Hierarchical Risk Parity allocation of a returns matrix.
+
+            Clusters the columns by the correlation distance
+            sqrt((1 - rho) / 2) with single linkage, orders them along the
+            dendrogram and bisects the ordered list recursively with
+            inverse-variance cluster risk. Runs with the GIL released.
+
+            Args:
+                returns: (observations, assets) returns, at least 2 rows
+                num_threads: Worker threads, 0 = all cores (default: 0)
+
+            Returns:
+                HrpAllocation
+        )pbdoc",
+        py::arg("returns"),
+        py::arg("num_threads") = 0
+    );
+
+    // Bind AlignedPanel struct
+    py::class_<quant::AlignedPanel>(m, "AlignedPanel",
+        R"pbdoc(
+            Panel rows aligned across symbols. dates is an int64 day
+            array (view it as datetime64[D]) and values a read-only
+            (dates, symbols) view, both ready to pass to the engines.
+        )pbdoc")
+        .def_readonly("num_symbols", &quant::AlignedPanel::num_symbols)
+        .def_property_readonly("dates", array_property(&quant::AlignedPanel::dates))
+        .def_property_readonly("values", [](py::object self) {
+            const quant::AlignedPanel& r = self.cast<const quant::AlignedPanel&>();
+            const py::ssize_t d = static_cast<py::ssize_t>(sizeof(double));
+            const py::ssize_t k = static_cast<py::ssize_t>(r.num_symbols);
+            return readonly_view<double>(
+                {static_cast<py::ssize_t>(r.dates.size()), k},
+                {k * d, d},
+                r.values.data(),
+                self
+            );
+        });
+
+    // Bind PricePanel class (memory-mapped, read-only)
+    py::class_<quant::PricePanel>(m, "PricePanel",
+        R"pbdoc(
+            Memory-mapped columnar daily price panel (dates x symbols).
+
+            Every array returned is a read-only view into the mapping,
+            which stays open while any view exists. A panel keeps seeing
+            the snapshot it opened after the file is rewritten.
+        )pbdoc")
+        .def(py::init<const std::string&>(), py::arg("path"))
+        .def_property_readonly("num_dates", &quant::PricePanel::num_dates)
+        .def_property_readonly("symbols", &quant::PricePanel::symbols)
+        .def_property_readonly("fields", &quant::PricePanel::fields)
+        .def_property_readonly("dates", [](py::object self) {
+            const quant::PricePanel& p = self.cast<const quant::PricePanel&>();
+            return readonly_view<std::int64_t>(
+                {static_cast<py::ssize_t>(p.num_dates())},
+                {static_cast<py::ssize_t>(sizeof(std::int64_t))},
+                p.dates(),
+                self
+            );
+        }, "Trading dates as int64 days since 1970-01-01")
+        .def("__contains__", [](const quant::PricePanel& p, const std::string& symbol) {
+            return p.symbol_index(symbol) >= 0;
+        })
+        .def("column", [](py::object self, const std::string& symbol, const std::string& field) {
+            const quant::PricePanel& p = self.cast<const quant::PricePanel&>();
+            return readonly_view<double>(
+                {static_cast<py::ssize_t>(p.num_dates())},
+                {static_cast<py::ssize_t>(sizeof(double))},
+                p.column(panel_index(p, field, true), panel_index(p, symbol, false)),
+                self
+            );
+        },
+            "Series of one symbol over all panel dates (NaN where it has no bar)",
+            py::arg("symbol"), py::arg("field") = "adjusted_close")
+        .def("validity", [](py::object self, const std::string& symbol) {
+            const quant::PricePanel& p = self.cast<const quant::PricePanel&>();
+            return readonly_view<std::uint64_t>(
+                {static_cast<py::ssize_t>((p.num_dates() + 63) / 64)},
+                {static_cast<py::ssize_t>(sizeof(std::uint64_t))},
+                p.validity(panel_index(p, symbol, false)),
+                self
+            );
+        },
+            "Validity bitmap of a symbol (bit t of word t // 64 set if it has a bar on date t)",
+            py::arg("symbol"))
+        .def("align",
+            [](const quant::PricePanel& p, const std::vector<std::string>& symbols, const std::string& field,
+               std::optional<std::int64_t> first, std::optional<std::int64_t> last, bool forward_fill) {
+                std::vector<int> indices;
+                indices.reserve(symbols.size());
+                for (const std::string& symbol : symbols) {
+                    indices.push_back(panel_index(p, symbol, false));
+                }
+                const int f = panel_index(p, field, true);
+
+                py::gil_scoped_release release;
+                return p.align(
+                    f, indices,
+                    first.value_or(std::numeric_limits<std::int64_t>::min()),
+                    last.value_or(std::numeric_limits<std::int64_t>::max()),
+                    forward_fill);
+            },
+            R"pbdoc(
+                Gather one field of several symbols into a (dates, symbols)
+                matrix over [first, last] (int64 days, inclusive).
+
+                Dates where none of the symbols trades are skipped. Without
+                forward_fill only dates where every symbol has a bar are
+                kept; with it, gaps repeat the last value and the rows
+                before every symbol has started are dropped.
+
+                Returns:
+                    AlignedPanel
+            )pbdoc",
+            py::arg("symbols"),
+            py::arg("field") = "adjusted_close",
+            py::arg("first") = py::none(),
+            py::arg("last") = py::none(),
+            py::arg("forward_fill") = false);
+
+    m.def("write_price_panel",
+        [](const std::string& path, const Int64Array& dates, const std::vector<std::string>& symbols,
+           const std::vector<std::string>& fields, const DoubleArray& values) {
+            if (dates.ndim() != 1) {
+                throw std::invalid_argument("dates must be a 1-D array");
+            }
+            const py::ssize_t num_dates = dates.shape(0);
+            if (values.ndim() != 3 || values.shape(0) != static_cast<py::ssize_t>(fields.size())
+                || values.shape(1) != static_cast<py::ssize_t>(symbols.size()) || values.shape(2) != num_dates) {
+                throw std::invalid_argument("values must have shape (fields, symbols, dates)");
+            }
+            std::vector<quant::PanelDate> days(dates.data(), dates.data() + num_dates);
+
+            py::gil_scoped_release release;
+            quant::write_price_panel(path, days, symbols, fields, values.data());
+        },
+        R"pbdoc(
+            Write a price panel file, atomically replacing path.
+
+            Args:
+                path: Output file
+                dates: Increasing int64 days since 1970-01-01
+                symbols: Symbol names (any order, at most 31 characters)
+                fields: Price field names (e.g. ["adjusted_close", "close"])
+                values: (fields, symbols, dates) prices, NaN where a symbol
+                    has no bar; a bar is valid when every field is finite
+        )pbdoc",
+        py::arg("path"),
+        py::arg("dates"),
+        py::arg("symbols"),
+        py::arg("fields"),
+        py::arg("values")
+    );
+
+    // Bind the job scheduler: engine calls queued on the native workers
+    py::register_exception<quant::SchedulerOverloaded>(m, "SchedulerOverloaded", PyExc_RuntimeError);
+
+    py::enum_<quant::TaskPriority>(m, "TaskPriority",
+        R"pbdoc(
+            Scheduling class of a submitted job.
+
+            Values:
+                Interactive: Request servicing; starts before any queued
+                    Batch job and always has a worker kept free for it
+                Batch: Bulk work (multi-ticker runs, exports, pair screens)
+        )pbdoc")
+        .value("Interactive", quant::TaskPriority::Interactive)
+        .value("Batch", quant::TaskPriority::Batch);
+
+    py::class_<EngineJob>(m, "EngineJob",
+        R"pbdoc(
+            Handle of a job returned by submit_job().
+
+            add_done_callback() is how an event loop awaits it: the callback
+            runs on the worker that finished the job (or right away if it is
+            done), so it should only hand over to the loop, e.g. through
+            loop.call_soon_threadsafe.
+        )pbdoc")
+        .def("result", [](const EngineJob& self) -> py::object {
+            {
+                py::gil_scoped_release release;
+                self.job->wait();
+            }
+            if (self.job->state() == quant::Job::State::Cancelled) {
+                py::object cancelled = py::module_::import("concurrent.futures").attr("CancelledError");
+                PyErr_SetString(cancelled.ptr(), "engine job was cancelled");
+                throw py::error_already_set();
+            }
+            if (self.state->error) {
+                PyErr_SetObject(reinterpret_cast<PyObject*>(Py_TYPE(self.state->error.ptr())),
+                                self.state->error.ptr());
+                throw py::error_already_set();
+            }
+            if (std::exception_ptr error = self.job->error()) {
+                std::rethrow_exception(error);
+            }
+            return self.state->result;
+        },
+            R"pbdoc(
+                Wait for the job (GIL released) and return what its callable
+                returned, or raise what it raised.
+
+                Raises:
+                    concurrent.futures.CancelledError: If it was cancelled
+            )pbdoc")
+        .def("done", [](const EngineJob& self) { return self.job->done(); },
+            "Whether the job has finished or was cancelled")
+        .def("cancelled", [](const EngineJob& self) {
+            return self.job->state() == quant::Job::State::Cancelled;
+        })
+        .def("cancel", [](const EngineJob& self) { return self.job->cancel(); },
+            "Withdraw the job if it has not started; returns whether it was withdrawn")
+        .def("add_done_callback", [](const EngineJob& self, py::function fn) {
+            auto callback = std::make_shared<PyCallback>(std::move(fn));
+            self.job->on_done([callback] {
+                py::gil_scoped_acquire gil;
+                try {
+                    callback->fn();
+                } catch (py::error_already_set& e) {
+                    e.discard_as_unraisable("EngineJob done callback");
+                }
+            });
+        },
+            "Call fn() once the job is done or cancelled",
+            py::arg("fn"))
+        .def_property_readonly("priority", [](const EngineJob& self) { return self.job->priority(); })
+        .def_property_readonly("queued_seconds", [](const EngineJob& self) { return self.job->queued_seconds(); },
+            "Seconds from submission to start")
+        .def_property_readonly("run_seconds", [](const EngineJob& self) { return self.job->run_seconds(); },
+            "Seconds spent running");
+
+    m.def("submit_job",
+        [](py::function fn, quant::TaskPriority priority) {
+            auto state = std::make_shared<PyJobState>();
+            state->fn = std::move(fn);
+            std::shared_ptr<quant::Job> job = quant::JobScheduler::instance().submit(
+                [state] {
+                    py::gil_scoped_acquire gil;
+                    try {
+                        state->result = state->fn();
+                    } catch (py::error_already_set& e) {
+                        state->error = e.value();
+                    }
+                    state->fn = py::object();
+                },
+                priority);
+            return EngineJob{std::move(job), std::move(state)};
+        },
+        R"pbdoc(
+            Run fn() as a job on the engine's worker pool.
+
+            The pool has one worker per physical core, shared with every
+            engine's own parallel loops. At most one job runs per worker;
+            others wait in their priority class's queue, Interactive ones
+            first. fn should be a whole engine call (it holds its worker
+            until it returns) and must not wait for another job.
+
+            Args:
+                fn: Callable taking no arguments (bind them with
+                    functools.partial)
+                priority: TaskPriority of the job
+
+            Returns:
+                EngineJob
+
+            Raises:
+                SchedulerOverloaded: If the class's queue is full
+        )pbdoc",
+        py::arg("fn"),
+        py::arg("priority") = quant::TaskPriority::Interactive
+    );
+
+    py::class_<quant::SchedulerStats>(m, "SchedulerStats",
+        R"pbdoc(
+            Counters of one priority class of the job scheduler.
+
+            Attributes:
+                queued, running: Jobs waiting for / holding a worker now
+                submitted, completed, failed, rejected, cancelled: Totals
+                wait_seconds_total, wait_seconds_max: Submission to start
+                run_seconds_total, run_seconds_max: Start to finish
+        )pbdoc")
+        .def_readonly("queued", &quant::SchedulerStats::queued)
+        .def_readonly("running", &quant::SchedulerStats::running)
+        .def_readonly("submitted", &quant::SchedulerStats::submitted)
+        .def_readonly("completed", &quant::SchedulerStats::completed)
+        .def_readonly("failed", &quant::SchedulerStats::failed)
+        .def_readonly("rejected", &quant::SchedulerStats::rejected)
+        .def_readonly("cancelled", &quant::SchedulerStats::cancelled)
+        .def_readonly("wait_seconds_total", &quant::SchedulerStats::wait_seconds_total)
+        .def_readonly("wait_seconds_max", &quant::SchedulerStats::wait_seconds_max)
+        .def_readonly("run_seconds_total", &quant::SchedulerStats::run_seconds_total)
+        .def_readonly("run_seconds_max", &quant::SchedulerStats::run_seconds_max);
+
+    m.def("scheduler_stats",
+        [](quant::TaskPriority priority) { return quant::JobScheduler::instance().stats(priority); },
+        "SchedulerStats of one priority class",
+        py::arg("priority"));
+
+    m.def("scheduler_slots", []() { return quant::JobScheduler::instance().slots(); },
+        "Jobs the scheduler runs at once");
+
+    m.def("configure_scheduler",
+        [](std::size_t max_queued_interactive, std::size_t max_queued_batch, unsigned max_running) {
+            quant::SchedulerLimits limits;
+            limits.max_queued_interactive = max_queued_interactive;
+            limits.max_queued_batch = max_queued_batch;
+            limits.max_running = max_running;
+            quant::JobScheduler::instance().set_limits(limits);
+        },
+        R"pbdoc(
+            Set the queue bounds of the job scheduler.
+
+            Args:
+                max_queued_interactive: Interactive jobs allowed to wait
+                    before submit_job() raises SchedulerOverloaded
+                max_queued_batch: Same for Batch jobs
+                max_running: Jobs running at once (0 = one per worker)
+        )pbdoc",
+        py::arg("max_queued_interactive") = quant::SchedulerLimits{}.max_queued_interactive,
+        py::arg("max_queued_batch") = quant::SchedulerLimits{}.max_queued_batch,
+        py::arg("max_running") = 0u
+    );
+
+    m.def("physical_core_count", &quant::physical_core_count,
+        "Physical cores of this machine (the size of the worker pool)");
+
+    // Queued jobs must not outlive the interpreter; running ones finish first
+    py::module_::import("atexit").attr("register")(py::cpp_function([]() {
+        quant::JobScheduler::instance().cancel_pending();
+        py::gil_scoped_release release;
+        quant::JobScheduler::instance().wait_idle();
+    }));
+
+    // SIMD kernel selected at runtime
+    m.def("simd_isa", []() { return std::string(quant::simd_kernels().isa); },
+        R"pbdoc(
+            Instruction set of the GBM kernels picked for this CPU
+            ("generic", "avx2", "avx512" or "neon").
+        )pbdoc");
+
     // Version info
     m.attr("__version__") = "0.2.0";
 }
@@ -0,0 +1,124 @@
+/**
+ * @file american_option.h
+ * @brief Longstaff-Schwartz Monte Carlo pricer for American and Bermudan
+ *        options on whole chains.
+ *
+ * Each option's GBM paths come from the single-asset path engine
+ * (simulate_paths), sampled at its exercise dates. Working back from
+ * expiry, the discounted cash flow of the in-the-money paths is regressed
+ * on a polynomial in moneyness S/K at every date (least squares through a
+ * Givens QR factor, never the normal equations), and a path exercises
+ * where its intrinsic value beats the fitted continuation value. The price
+ * is the average discounted cash flow under that exercise policy.
+ *
+ * Greeks differentiate each path's discounted cash flow with its exercise
+ * date held fixed (pathwise delta, vega and rho); gamma adds the
+ * likelihood-ratio weight of the first step to the pathwise delta, and
+ * theta follows from the Black-Scholes equation, which the price satisfies
+ * wherever immediate exercise is not optimal.
+ */
+
+#ifndef AMERICAN_OPTION_H
+#define AMERICAN_OPTION_H
+
+#include "monte_carlo.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace quant {
+
+/// Highest polynomial degree of the continuation-value regression
+constexpr int MAX_BASIS_DEGREE = 6;
+
+/**
+ * @brief Settings shared by every option of a chain.
+ */
+struct LsmConfig {
+    /// Paths per option
+    int num_simulations = 50000;
+
+    /// Equally spaced exercise dates in (0, T], the last one at expiry; the
+    /// option may also be exercised at t = 0. Many dates approximate
+    /// American exercise, few give a Bermudan option.
+    int exercise_dates = 50;
+
+    /// Degree of the polynomial in S/K fitted to continuation values
+    int basis_degree = 3;
+
+    /// Random seed (0 = use the clock). Every option of a chain draws the
+    /// same shocks, so prices and Greeks are smooth across strikes.
+    uint64_t seed = 0;
+
+    /// Worker threads for path generation and regression (0 = all cores)
+    int num_threads = 0;
+
+    /// Shock scheme of the paths; the price's standard error follows it
+    VarianceReduction variance_reduction = VarianceReduction::None;
+};
+
+/**
+ * @brief Prices and Greeks of a chain, structure-of-arrays layout.
+ *
+ * Element i of every vector belongs to option i. Greeks have the units of
+ * GreeksResult (vega and rho per 1%, theta per calendar day).
+ */
+struct AmericanOptionBatch {
+    std::vector<double> price;
+
+    /// Monte Carlo standard error of price (0 where exercising at t = 0
+    /// is optimal)
+    std::vector<double> standard_error;
+
+    std::vector<double> delta;
+    std::vector<double> gamma;
+    std::vector<double> vega;
+    std::vector<double> theta;
+    std::vector<double> rho;
+};
+
+/**
+ * @brief Price American (or Bermudan) options and their Greeks with
+ *        Longstaff-Schwartz least-squares Monte Carlo.
+ *
+ * Options are priced one after another; each one's path generation and
+ * regressions run on the shared ThreadPool in fixed blocks of paths, so
+ * results for a given seed do not depend on the thread count. Expired or
+ * degenerate options (non-positive expiry, volatility, strike or spot) get
+ * their intrinsic value and expiry delta, as in calculate_greeks().
+ *
+ * The exercise policy is fitted on the same paths it is applied to, which
+ * biases prices slightly upwards; the bias shrinks with num_simulations.
+ *
+ * @param strike          Strike prices (K)
+ * @param time_to_expiry  Times to expiry in years (T)
+ * @param spot            Spot prices (S)
+ * @param risk_free_rate  Risk-free interest rates (r)
+ * @param volatility      Volatilities (sigma)
+ * @param dividend_yield  Continuous dividend yields (q)
+ * @param is_call         True for Call, False for Put
+ * @param n               Number of options (length of every input array)
+ * @param config          Simulation settings shared by the chain
+ * @param workspace       Arena for the path matrix (nullptr = the calling
+ *                        thread's)
+ *
+ * @throws std::invalid_argument for num_simulations < 2,
+ *         exercise_dates < 1 or basis_degree outside [1, MAX_BASIS_DEGREE]
+ */
+AmericanOptionBatch price_american_batch(
+    const double* strike,
+    const double* time_to_expiry,
+    const double* spot,
+    const double* risk_free_rate,
+    const double* volatility,
+    const double* dividend_yield,
+    const bool* is_call,
+    std::size_t n,
+    const LsmConfig& config,
+    SimulationWorkspace* workspace = nullptr
+);
+
+} // namespace quant
+
+#endif // AMERICAN_OPTION_H
@@ -0,0 +1,95 @@
+/**
+ * @file cointegration.h
+ * @brief All-pairs Engle-Granger cointegration screen of a price panel.
+ *
+ * For every ordered pair (i, j), i < j, of a universe the screen regresses
+ * asset i on asset j with a constant (the hedge ratio), runs an augmented
+ * Dickey-Fuller test on the residual spread and fits its Ornstein-Uhlenbeck
+ * half-life. It follows statsmodels coint(): no trend in the ADF
+ * regression, the lag count chosen by AIC up to 12 (n / 100)^(1/4), and a
+ * MacKinnon (1994) approximate p-value for two variables.
+ */
+
+#ifndef COINTEGRATION_H
+#define COINTEGRATION_H
+
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Screen settings.
+ */
+struct CointegrationOptions {
+    /// Pairs with a larger ADF p-value are dropped
+    double max_p_value = 0.05;
+
+    /// Pairs whose price levels correlate less than this (in absolute
+    /// value) are dropped before the ADF test (0 = test every pair)
+    double min_abs_correlation = 0.5;
+
+    /// Most lagged differences in the ADF regression (-1 = 12 (n/100)^(1/4))
+    int max_lag = -1;
+
+    /// Worker threads (0 = all cores)
+    int num_threads = 0;
+};
+
+/**
+ * @brief A pair that passed the screen; assets are column indices.
+ *
+ * The spread is price[first] - hedge_ratio * price[second].
+ */
+struct CointegrationPair {
+    int first = 0;
+    int second = 0;
+
+    double correlation = 0.0;    // of the price levels
+    double hedge_ratio = 0.0;    // OLS slope of first on second
+    double adf_statistic = 0.0;  // t-statistic of the ADF level term
+    double p_value = 1.0;        // MacKinnon approximate p-value
+    int lags = 0;                // lagged differences chosen by AIC
+    double half_life = 0.0;      // in observations (9999 if not mean reverting)
+    double spread_mean = 0.0;
+    double spread_std = 0.0;     // population standard deviation
+    double last_z_score = 0.0;   // (last spread - mean) / std
+};
+
+/**
+ * @brief MacKinnon (1994) approximate p-value of an Engle-Granger ADF
+ *        statistic for two variables with a constant.
+ */
+double engle_granger_p_value(double adf_statistic);
+
+/**
+ * @brief Test every pair of a price panel and keep the cointegrated ones.
+ *
+ * Column means, norms and the full correlation matrix come first (one
+ * pass per pair, in parallel by row); the hedge ratio of a pair follows
+ * from them. Pairs passing the correlation filter then get the ADF test:
+ * the AIC search fits every lag count on a common sample from one Gram
+ * matrix of all candidate regressors, whose leading blocks are the
+ * smaller models. Blocks of pairs run on the shared ThreadPool, and the
+ * result is in (first, second) order whatever the thread count.
+ *
+ * @param prices     Row-major num_obs x num_assets matrix of aligned prices
+ * @param num_obs    Observations (rows)
+ * @param num_assets Assets (columns)
+ * @param options    Screen settings
+ *
+ * @return Passing pairs, sorted by (first, second)
+ *
+ * @throws std::invalid_argument for fewer than 20 observations or
+ *         negative settings.
+ */
+std::vector<CointegrationPair> screen_cointegrated_pairs(
+    const double* prices,
+    std::size_t num_obs,
+    std::size_t num_assets,
+    const CointegrationOptions& options = CointegrationOptions()
+);
+
+} // namespace quant
+
+#endif // COINTEGRATION_H
@@ -0,0 +1,111 @@
+/**
+ * @file engine_timings.h
+ * @brief Per-run phase timers and counters of the simulation engines.
+ *
+ * Built with QUANT_ENGINE_TIMINGS=1 (the CMake option
+ * STRATA_ENGINE_TIMINGS), the engines fill SimulationResult::timings with
+ * steady-clock wall time per phase and the size of their working buffers.
+ * Otherwise PhaseTimer and count_bytes compile to nothing and the struct
+ * stays zero with enabled false.
+ */
+
+#ifndef ENGINE_TIMINGS_H
+#define ENGINE_TIMINGS_H
+
+#include <chrono>
+#include <cstddef>
+
+#ifndef QUANT_ENGINE_TIMINGS
+#define QUANT_ENGINE_TIMINGS 0
+#endif
+
+namespace quant {
+
+/**
+ * @brief Where the wall time of one simulation went.
+ *
+ * Phases are measured on the calling thread around parallel sections, so
+ * they add up to (about) total_seconds rather than to CPU time.
+ */
+struct SimulationTimings {
+    /// Whether the engine was built with timings
+    bool enabled = QUANT_ENGINE_TIMINGS != 0;
+
+    /// Seed, quantile plan, shock generator and buffer allocation
+    double setup_seconds = 0.0;
+
+    /// Shock generation and process steps of every path
+    double path_seconds = 0.0;
+
+    /// Per-step mean and order statistics (percentile bands)
+    double step_stats_seconds = 0.0;
+
+    /// Terminal statistics, tail risk, drawdowns and mean estimate
+    double final_stats_seconds = 0.0;
+
+    /// Histogram of final values (part of final_stats_seconds)
+    double histogram_seconds = 0.0;
+
+    /// Writing exported paths (see PathExportOptions)
+    double export_seconds = 0.0;
+
+    double total_seconds = 0.0;
+
+    /// Bytes of the engine's working buffers (path matrix or step rows,
+    /// per-path prices, drawdowns and process state)
+    std::size_t bytes_allocated = 0;
+
+    /// num_simulations / total_seconds
+    double paths_per_second = 0.0;
+};
+
+/**
+ * @brief Adds the wall time of its scope (or until stop()) to a phase.
+ */
+class PhaseTimer {
+public:
+#if QUANT_ENGINE_TIMINGS
+    explicit PhaseTimer(double& seconds) : seconds_(&seconds), start_(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() { stop(); }
+
+    void stop() {
+        if (seconds_ != nullptr) {
+            *seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+            seconds_ = nullptr;
+        }
+    }
+
+private:
+    double* seconds_;
+    std::chrono::steady_clock::time_point start_;
+#else
+    explicit PhaseTimer(double&) {}
+
+    void stop() {}
+#endif
+
+public:
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+};
+
+/// Record a working buffer of the run
+inline void count_bytes([[maybe_unused]] SimulationTimings& timings, [[maybe_unused]] std::size_t bytes) {
+#if QUANT_ENGINE_TIMINGS
+    timings.bytes_allocated += bytes;
+#endif
+}
+
+/// Derive the rates once total_seconds is final
+inline void finish_timings([[maybe_unused]] SimulationTimings& timings, [[maybe_unused]] int num_paths) {
+#if QUANT_ENGINE_TIMINGS
+    if (timings.total_seconds > 0.0) {
+        timings.paths_per_second = num_paths / timings.total_seconds;
+    }
+#endif
+}
+
+} // namespace quant
+
+#endif // ENGINE_TIMINGS_H
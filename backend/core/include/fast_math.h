@@ -0,0 +1,321 @@
+/**
+ * @file fast_math.h
+ * @brief Branch-free elementary and normal-distribution functions.
+ *
+ * Plain scalar code with no libm calls or data-dependent branches, so the
+ * compiler can vectorize loops that use it with whatever instruction set
+ * the including object is built for. These are the scalar variants; the
+ * array variants in SimdKernels (simd_kernels.h) run the same code built
+ * for the best ISA of the CPU.
+ *
+ * Maximum errors (measured against quad precision over the stated range):
+ *
+ *   exp          2.2e-16 relative    x in [-708, 709]
+ *   log          4.8e-16 relative    normal positive x
+ *   sincos_2pi   7e-16 absolute      u in [0, 1]
+ *   normal_pdf   4.8e-16 relative    |x| <= 37.5
+ *   normal_cdf   4.9e-15 relative    x in [-37.5, 0]
+ *                4.6e-16 absolute    all x (generic build)
+ *                1.3e-15 absolute    all x (FMA builds: AVX2, AVX-512)
+ *   normal_quantile
+ *                5.3e-16 relative    p in [1e-290, 1)
+ *
+ * Including translation units must be compiled without -fassociative-math
+ * (CMake adds -fno-associative-math): the two-constant range reductions
+ * and the exact square below rely on evaluation order.
+ *
+ * Everything here has internal linkage: each per-ISA kernel object gets its
+ * own copy, so the linker can never substitute an AVX-512 build of one of
+ * these functions into the generic kernel.
+ */
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace quant {
+namespace fmath {
+namespace {
+
+constexpr double LN2_HI = 6.93147180369123816490e-01;
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double LOG2E = 1.44269504088896338700e+00;
+constexpr double SQRT2 = 1.41421356237309504880e+00;
+constexpr double TWO_PI = 6.28318530717958647692e+00;
+constexpr double INV_SQRT2 = 7.07106781186547524401e-01;
+constexpr double INV_SQRT_2PI = 3.98942280401432677940e-01;
+
+inline double from_bits(uint64_t bits) {
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+inline uint64_t to_bits(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief exp(x): 2^k * P(r) with |r| <= ln2/2, degree-13 Taylor polynomial.
+ *
+ * Inputs are clamped to [-708, 709] (no overflow to inf).
+ */
+inline double exp(double x) {
+    x = x < -708.0 ? -708.0 : (x > 709.0 ? 709.0 : x);
+
+    // Round to nearest through int32 conversion (vectorizes without AVX-512DQ)
+    const double t = x * LOG2E;
+    const int32_t k = static_cast<int32_t>(t + (t >= 0.0 ? 0.5 : -0.5));
+    const double n = static_cast<double>(k);
+    const double r = (x - n * LN2_HI) - n * LN2_LO;
+
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    const uint64_t scale = static_cast<uint64_t>(static_cast<int64_t>(k) + 1023) << 52;
+    return p * from_bits(scale);
+}
+
+/**
+ * @brief log(x) for normal, positive x: e*ln2 + 2*atanh(f), f = (m-1)/(m+1).
+ *
+ * m is the mantissa folded into [sqrt(2)/2, sqrt(2)), so |f| <= 0.1716 and
+ * the odd series to f^21 is accurate to well below one ulp.
+ */
+inline double log(double x) {
+    const uint64_t bits = to_bits(x);
+    int32_t e = static_cast<int32_t>(bits >> 52) - 1023;
+    double m = from_bits((bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+
+    const bool fold = m > SQRT2;
+    m = fold ? m * 0.5 : m;
+    e = fold ? e + 1 : e;
+
+    const double f = (m - 1.0) / (m + 1.0);
+    const double s = f * f;
+
+    double p = 1.0 / 21.0;
+    p = p * s + 1.0 / 19.0;
+    p = p * s + 1.0 / 17.0;
+    p = p * s + 1.0 / 15.0;
+    p = p * s + 1.0 / 13.0;
+    p = p * s + 1.0 / 11.0;
+    p = p * s + 1.0 / 9.0;
+    p = p * s + 1.0 / 7.0;
+    p = p * s + 1.0 / 5.0;
+    p = p * s + 1.0 / 3.0;
+    p = p * s + 1.0;
+
+    const double n = static_cast<double>(e);
+    return n * LN2_HI + (2.0 * f * p + n * LN2_LO);
+}
+
+/**
+ * @brief exp(-x^2 / 2) without the rounding error of x^2.
+ *
+ * x^2 is split into hi + lo exactly (Veltkamp/Dekker), so the result keeps
+ * exp()'s relative accuracy even in the tails where x^2 is large.
+ */
+inline double exp_neg_half_square(double x) {
+    x = x < -40.0 ? -40.0 : (x > 40.0 ? 40.0 : x);
+
+    const double split = 134217729.0 * x; // 2^27 + 1
+    const double x_hi = split - (split - x);
+    const double x_lo = x - x_hi;
+    const double hi = x * x;
+    const double lo = ((x_hi * x_hi - hi) + 2.0 * x_hi * x_lo) + x_lo * x_lo;
+
+    return exp(-0.5 * hi) * (1.0 - 0.5 * lo);
+}
+
+/// One step of Clenshaw's recurrence for a Chebyshev series. (c - b2) does
+/// not depend on the previous step, so the critical path is one FMA per step.
+inline void clenshaw_step(double& b1, double& b2, double y2, double c) {
+    const double b0 = y2 * b1 + (c - b2);
+    b2 = b1;
+    b1 = b0;
+}
+
+/**
+ * @brief Scaled complementary error function erfc(z) * exp(z^2), z >= 0.
+ *
+ * Chebyshev series in y = (z - 4) / (z + 4), which maps [0, inf) onto
+ * [-1, 1) and keeps the 1/(z sqrt(pi)) tail smooth; 24 terms, evaluated
+ * with Clenshaw's recurrence (written out so loops over it vectorize).
+ */
+inline double erfcx(double z) {
+    const double y = (z - 4.0) / (z + 4.0);
+    const double y2 = 2.0 * y;
+
+    double b1 = 0.0;
+    double b2 = 0.0;
+    clenshaw_step(b1, b2, y2, -3.69287512932721499610e-17);
+    clenshaw_step(b1, b2, y2, 5.72841468125684977742e-17);
+    clenshaw_step(b1, b2, y2, 1.02499601950092351678e-15);
+    clenshaw_step(b1, b2, y2, -2.60316463431754324479e-15);
+    clenshaw_step(b1, b2, y2, -2.82325095027981509497e-14);
+    clenshaw_step(b1, b2, y2, 1.25504925801082610142e-13);
+    clenshaw_step(b1, b2, y2, 6.86923043856799337893e-13);
+    clenshaw_step(b1, b2, y2, -5.88939473381726269446e-12);
+    clenshaw_step(b1, b2, y2, -7.81490917402809596870e-12);
+    clenshaw_step(b1, b2, y2, 2.45937349894966839996e-10);
+    clenshaw_step(b1, b2, y2, -6.85848914944545030838e-10);
+    clenshaw_step(b1, b2, y2, -6.88311076336284637743e-09);
+    clenshaw_step(b1, b2, y2, 6.92783051874894925305e-08);
+    clenshaw_step(b1, b2, y2, -1.46283564847275779843e-07);
+    clenshaw_step(b1, b2, y2, -2.31782349994685336800e-06);
+    clenshaw_step(b1, b2, y2, 3.06854311309895152585e-05);
+    clenshaw_step(b1, b2, y2, -2.24697942187730493733e-04);
+    clenshaw_step(b1, b2, y2, 1.22785153726067553344e-03);
+    clenshaw_step(b1, b2, y2, -5.44908706645900757724e-03);
+    clenshaw_step(b1, b2, y2, 2.03672565767448645991e-02);
+    clenshaw_step(b1, b2, y2, -6.52375244973489914709e-02);
+    clenshaw_step(b1, b2, y2, 1.80272565687710564629e-01);
+    clenshaw_step(b1, b2, y2, -4.29086441255805366896e-01);
+    return y * b1 - b2 + 2.98101793693657603668e-01;
+}
+
+/**
+ * @brief Standard normal density phi(x).
+ */
+inline double normal_pdf(double x) {
+    return INV_SQRT_2PI * exp_neg_half_square(x);
+}
+
+/**
+ * @brief Standard normal distribution Phi(x).
+ *
+ * Phi(x) = erfc(-x / sqrt(2)) / 2 from the lower tail; the upper half uses
+ * Phi(x) = 1 - Phi(-x), so it is accurate in absolute terms there.
+ */
+inline double normal_cdf(double x) {
+    const double tail = 0.5 * exp_neg_half_square(x) * erfcx(std::fabs(x) * INV_SQRT2);
+    return x < 0.0 ? tail : 1.0 - tail;
+}
+
+/**
+ * @brief Inverse standard normal distribution Phi^-1(p), p in (0, 1).
+ *
+ * Acklam's rational approximation (relative error 1.2e-9), selected
+ * without branches between the central and tail regions, then one Halley
+ * step on the lower-tail equation Phi(y) = min(p, 1 - p), where
+ * normal_cdf() is accurate in relative terms.
+ */
+inline double normal_quantile(double p) {
+    const double lower = p < 0.5 ? p : 1.0 - p;
+
+    // Central region |p - 0.5| <= 0.47575
+    const double q = p - 0.5;
+    const double r = q * q;
+    const double num_c = (((((-3.969683028665376e+01 * r + 2.209460984245205e+02) * r
+                          - 2.759285104469687e+02) * r + 1.383577518672690e+02) * r
+                          - 3.066479806614716e+01) * r + 2.506628277459239e+00) * q;
+    const double den_c = ((((-5.447609879822406e+01 * r + 1.615858368580409e+02) * r
+                          - 1.556989798598866e+02) * r + 6.680131188771972e+01) * r
+                          - 1.328068155288572e+01) * r + 1.0;
+
+    // Tails, as the (negative) lower-tail quantile of min(p, 1 - p)
+    const double t = std::sqrt(-2.0 * log(lower));
+    const double num_t = ((((-7.784894002430293e-03 * t - 3.223964580411365e-01) * t
+                          - 2.400758277161838e+00) * t - 2.549732539343734e+00) * t
+                          + 4.374664141464968e+00) * t + 2.938163982698783e+00;
+    const double den_t = (((7.784695709041462e-03 * t + 3.224671290700398e-01) * t
+                          + 2.445134137142996e+00) * t + 3.754408661907416e+00) * t + 1.0;
+
+    const double central = num_c / den_c;
+    const double tail = num_t / den_t;
+
+    // Lower-tail estimate y <= 0 with Phi(y) = lower
+    double y = lower < 0.02425 ? tail : -std::fabs(central);
+
+    // Residual Phi(y) - lower. Near the median Phi(y) - 1/2 comes from its
+    // Taylor series and lower - 1/2 = -|q| exactly, so the residual keeps
+    // its relative accuracy as y -> 0.
+    const double h = -0.5 * y * y;
+    double series = 1.0 / 1307674368000.0 / 31.0;
+    series = series * h + 1.0 / 87178291200.0 / 29.0;
+    series = series * h + 1.0 / 6227020800.0 / 27.0;
+    series = series * h + 1.0 / 479001600.0 / 25.0;
+    series = series * h + 1.0 / 39916800.0 / 23.0;
+    series = series * h + 1.0 / 3628800.0 / 21.0;
+    series = series * h + 1.0 / 362880.0 / 19.0;
+    series = series * h + 1.0 / 40320.0 / 17.0;
+    series = series * h + 1.0 / 5040.0 / 15.0;
+    series = series * h + 1.0 / 720.0 / 13.0;
+    series = series * h + 1.0 / 120.0 / 11.0;
+    series = series * h + 1.0 / 24.0 / 9.0;
+    series = series * h + 1.0 / 6.0 / 7.0;
+    series = series * h + 1.0 / 2.0 / 5.0;
+    series = series * h + 1.0 / 3.0;
+    series = series * h + 1.0;
+    const double near_median = INV_SQRT_2PI * y * series + std::fabs(q);
+    const double e = y > -1.0 ? near_median : normal_cdf(y) - lower;
+
+    // Halley step
+    const double u = e / normal_pdf(y);
+    y -= u / (1.0 + 0.5 * y * u);
+
+    return p < 0.5 ? y : -y;
+}
+
+/**
+ * @brief sin(2*pi*u) and cos(2*pi*u) for u in [0, 1].
+ *
+ * Quadrant reduction is exact because u is a binary fraction; the reduced
+ * angle lies in [-pi/4, pi/4] where the Taylor series below converge to
+ * double precision.
+ */
+inline void sincos_2pi(double u, double& s, double& c) {
+    const int32_t q = static_cast<int32_t>(u * 4.0 + 0.5);
+    const double r = (u - 0.25 * static_cast<double>(q)) * TWO_PI;
+    const double r2 = r * r;
+
+    double ps = -1.0 / 1307674368000.0;
+    ps = ps * r2 + 1.0 / 6227020800.0;
+    ps = ps * r2 - 1.0 / 39916800.0;
+    ps = ps * r2 + 1.0 / 362880.0;
+    ps = ps * r2 - 1.0 / 5040.0;
+    ps = ps * r2 + 1.0 / 120.0;
+    ps = ps * r2 - 1.0 / 6.0;
+    const double sin_r = r + r * r2 * ps;
+
+    double pc = 1.0 / 20922789888000.0;
+    pc = pc * r2 - 1.0 / 87178291200.0;
+    pc = pc * r2 + 1.0 / 479001600.0;
+    pc = pc * r2 - 1.0 / 3628800.0;
+    pc = pc * r2 + 1.0 / 40320.0;
+    pc = pc * r2 - 1.0 / 720.0;
+    pc = pc * r2 + 1.0 / 24.0;
+    pc = pc * r2 - 0.5;
+    const double cos_r = 1.0 + r2 * pc;
+
+    // Rotate by q quarter turns
+    const int32_t quadrant = q & 3;
+    const double sx = (quadrant & 1) ? cos_r : sin_r;
+    const double cx = (quadrant & 1) ? sin_r : cos_r;
+    s = (quadrant & 2) ? -sx : sx;
+    c = ((quadrant + 1) & 2) ? -cx : cx;
+}
+
+} // namespace
+} // namespace fmath
+} // namespace quant
+
+#endif // FAST_MATH_H
@@ -6,10 +6,33 @@
 #ifndef GREEKS_ENGINE_H
 #define GREEKS_ENGINE_H
 
+#include "fast_math.h"
+
+#include <cstddef>
 #include <vector>
 
 namespace quant {
 
+/**
+ * @brief Standard Normal Probability Density Function (PDF)
+ *
+ * Branch-free fast_math.h kernel (4.8e-16 relative error).
+ */
+inline double normal_pdf(double x) {
+    return fmath::normal_pdf(x);
+}
+
+/**
+ * @brief Standard Normal Cumulative Distribution Function (CDF)
+ *
+ * Branch-free fast_math.h kernel in place of std::erfc: at most 1.3e-15
+ * absolute error in the FMA (AVX2/AVX-512) builds, 4.6e-16 in the generic
+ * one, and 4.9e-15 relative in the lower tail.
+ */
+inline double normal_cdf(double x) {
+    return fmath::normal_cdf(x);
+}
+
 /**
  * @brief Container for calculated Greeks.
  */
@@ -42,6 +65,48 @@ GreeksResult calculate_greeks(
     bool is_call = true
 );
 
+/**
+ * @brief Greeks of a batch of options, structure-of-arrays layout.
+ *
+ * Element i of every vector belongs to option i of the batch. Units match
+ * GreeksResult.
+ */
+struct GreeksBatch {
+    std::vector<double> delta;
+    std::vector<double> gamma;
+    std::vector<double> vega;
+    std::vector<double> theta;
+    std::vector<double> rho;
+};
+
+/**
+ * @brief Calculate Black-Scholes Greeks for a whole option chain.
+ *
+ * Same results as calling calculate_greeks() per option, but sqrt(T),
+ * e^(-rT) and d1/d2 are computed once per option in a branch-free loop
+ * (expired or degenerate options are masked, not branched on), and large
+ * batches are split across the shared ThreadPool.
+ *
+ * @param strike          Strike prices (K)
+ * @param time_to_expiry  Times to expiry in years (T)
+ * @param spot            Spot prices (S)
+ * @param risk_free_rate  Risk-free interest rates (r)
+ * @param volatility      Implied volatilities (sigma)
+ * @param is_call         True for Call, False for Put
+ * @param n               Number of options (length of every input array)
+ *
+ * @return GreeksBatch with n entries per Greek
+ */
+GreeksBatch calculate_greeks_batch(
+    const double* strike,
+    const double* time_to_expiry,
+    const double* spot,
+    const double* risk_free_rate,
+    const double* volatility,
+    const bool* is_call,
+    std::size_t n
+);
+
 } // namespace quant
 
 #endif // GREEKS_ENGINE_H
@@ -0,0 +1,67 @@
+/**
+ * @file hrp.h
+ * @brief Hierarchical Risk Parity (Lopez de Prado, 2016) portfolio weights.
+ *
+ * The allocation clusters assets by the correlation distance
+ * d_ij = sqrt((1 - rho_ij) / 2) with single linkage, orders them by the
+ * leaves of the dendrogram (quasi-diagonalization) and splits the ordered
+ * list in halves recursively, giving each half a weight share inversely
+ * proportional to its inverse-variance portfolio variance.
+ */
+
+#ifndef HRP_H
+#define HRP_H
+
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief HRP weights of a universe; assets are column indices.
+ */
+struct HrpAllocation {
+    /// Weight per asset in column order (non-negative, sums to 1)
+    std::vector<double> weights;
+
+    /// Columns in quasi-diagonal (dendrogram leaf) order
+    std::vector<int> order;
+
+    /**
+     * @brief Single-linkage dendrogram in scipy.cluster.hierarchy layout:
+     *        (num_assets - 1) rows of (cluster_a, cluster_b, distance, size)
+     *        with cluster_a < cluster_b, row-major. Row k forms cluster
+     *        num_assets + k.
+     */
+    std::vector<double> linkage;
+};
+
+/**
+ * @brief HRP allocation of a returns panel.
+ *
+ * The sample covariance (ddof = 1) is computed in cache-sized tiles of
+ * asset pairs and observations, tiles running in parallel on the shared
+ * ThreadPool. Single linkage is built from the O(n^2) Prim minimum
+ * spanning tree of the distance matrix, and the bisection walks index
+ * ranges of the reordered covariance iteratively, so the cost is O(T n^2)
+ * for the covariance and O(n^2) for the rest. Results do not depend on
+ * the thread count.
+ *
+ * @param returns     Row-major num_obs x num_assets matrix of returns
+ * @param num_obs     Observations (rows)
+ * @param num_assets  Assets (columns)
+ * @param num_threads Worker threads (0 = all cores)
+ *
+ * @throws std::invalid_argument for fewer than 2 observations, no assets
+ *         or an asset with zero variance.
+ */
+HrpAllocation hrp_allocation(
+    const double* returns,
+    std::size_t num_obs,
+    std::size_t num_assets,
+    int num_threads = 0
+);
+
+} // namespace quant
+
+#endif // HRP_H
@@ -0,0 +1,102 @@
+/**
+ * @file implied_vol.h
+ * @brief Black-Scholes implied-volatility solver for whole option chains.
+ */
+
+#ifndef IMPLIED_VOL_H
+#define IMPLIED_VOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Outcome of the implied-volatility search for one option.
+ */
+enum class IvStatus : uint8_t {
+    /// Volatility step fell below the tolerance
+    Converged = 0,
+
+    /// Still not converged after max_iterations
+    MaxIterations = 1,
+
+    /// Price outside the no-arbitrage bounds (intrinsic value, spot/strike):
+    /// no volatility reproduces it
+    OutOfBounds = 2,
+
+    /// Non-positive strike, spot, expiry or a non-finite price
+    InvalidInput = 3
+};
+
+/**
+ * @brief Implied volatilities of a batch of options, structure-of-arrays.
+ *
+ * volatility[i] is NaN unless status[i] is Converged or MaxIterations
+ * (the latter holds the best estimate found).
+ */
+struct ImpliedVolBatch {
+    std::vector<double> volatility;
+    std::vector<int> iterations;
+    std::vector<uint8_t> status; // IvStatus values
+};
+
+/**
+ * @brief Black-Scholes price of a European option.
+ *
+ * @param strike          Option strike price (K)
+ * @param time_to_expiry  Time to expiry in years (T)
+ * @param spot            Current spot price (S)
+ * @param risk_free_rate  Risk-free interest rate (r)
+ * @param volatility      Volatility (sigma)
+ * @param is_call         True for Call, False for Put
+ */
+double black_scholes_price(
+    double strike,
+    double time_to_expiry,
+    double spot,
+    double risk_free_rate,
+    double volatility,
+    bool is_call = true
+);
+
+/**
+ * @brief Back out Black-Scholes implied volatility for a whole chain.
+ *
+ * Puts are mapped to calls through put-call parity. Each option starts
+ * from the closed-form Corrado-Miller estimate and takes Newton steps on
+ * the call price; every iterate also tightens a [lo, hi] bracket, and a
+ * step that would leave the bracket (or has vanishing vega) is replaced by
+ * bisection, so deep in/out-of-the-money rows still converge.
+ *
+ * Options are solved 64 at a time with all lanes stepping together, and
+ * blocks of options run on the shared ThreadPool.
+ *
+ * @param price          Option prices (e.g. bid/ask mids)
+ * @param strike         Strike prices (K)
+ * @param time_to_expiry Times to expiry in years (T)
+ * @param spot           Spot prices (S)
+ * @param risk_free_rate Risk-free interest rates (r)
+ * @param is_call        True for Call, False for Put
+ * @param n              Number of options (length of every input array)
+ * @param tolerance      Convergence threshold on the volatility step
+ * @param max_iterations Iteration cap per option
+ *
+ * @return ImpliedVolBatch with one volatility / status per option
+ */
+ImpliedVolBatch implied_volatility_batch(
+    const double* price,
+    const double* strike,
+    const double* time_to_expiry,
+    const double* spot,
+    const double* risk_free_rate,
+    const bool* is_call,
+    std::size_t n,
+    double tolerance = 1e-8,
+    int max_iterations = 100
+);
+
+} // namespace quant
+
+#endif // IMPLIED_VOL_H
@@ -0,0 +1,229 @@
+/**
+ * @file job_scheduler.h
+ * @brief Admission-controlled job queue in front of the worker pool.
+ *
+ * A job is one whole engine call (a simulation, a chain of Greeks, a pair
+ * screen), submitted by a service thread and run on a ThreadPool worker.
+ * The scheduler bounds how many jobs run at once (one per worker) and how
+ * many may wait per priority class, so a burst of heavy requests is
+ * rejected up front instead of piling up behind light ones:
+ *
+ *   - queued Interactive jobs always start before queued Batch jobs;
+ *   - Batch jobs never hold the last free worker, which stays available
+ *     to Interactive work;
+ *   - submit() throws SchedulerOverloaded once a class's queue is full.
+ *
+ * Jobs of either class still split into parallel_for blocks inside the
+ * engine; their helpers inherit the job's priority (see PriorityScope).
+ */
+
+#ifndef JOB_SCHEDULER_H
+#define JOB_SCHEDULER_H
+
+#include "thread_pool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace quant {
+
+class JobScheduler;
+
+/**
+ * @brief Thrown by JobScheduler::submit() when a priority class's queue
+ *        is full.
+ */
+class SchedulerOverloaded : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Handle of one submitted job, shared by the submitter and the
+ *        scheduler.
+ */
+class Job {
+public:
+    enum class State { Queued, Running, Done, Cancelled };
+
+    Job(std::function<void()> fn, TaskPriority priority, JobScheduler* scheduler);
+
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+
+    TaskPriority priority() const { return priority_; }
+
+    State state() const;
+
+    /// Whether the job has finished or was cancelled
+    bool done() const;
+
+    /// Block until done()
+    void wait() const;
+
+    /**
+     * @brief Withdraw the job if it has not started yet.
+     *
+     * @return true if the job was cancelled (it will never run); false if
+     *         it is already running or done
+     */
+    bool cancel();
+
+    /**
+     * @brief Call callback once the job is done (or cancelled).
+     *
+     * Runs on the thread that finishes the job, or right away on the
+     * calling thread if it already is done. callback must not throw.
+     */
+    void on_done(std::function<void()> callback);
+
+    /// Exception thrown by the job's function (null if none)
+    std::exception_ptr error() const;
+
+    /// Seconds between submission and start (so far, while queued)
+    double queued_seconds() const;
+
+    /// Seconds spent running (so far, while running)
+    double run_seconds() const;
+
+private:
+    friend class JobScheduler;
+
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    void finish(State state);
+
+    std::function<void()> fn_;
+    const TaskPriority priority_;
+    JobScheduler* const scheduler_;
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+    State state_ = State::Queued;
+    std::exception_ptr error_;
+    std::vector<std::function<void()>> callbacks_;
+
+    const Clock::time_point submitted_;
+    Clock::time_point started_;
+    Clock::time_point finished_;
+};
+
+/**
+ * @brief Queue bounds of a JobScheduler.
+ */
+struct SchedulerLimits {
+    /// Jobs running at once (0 = one per pool worker)
+    unsigned max_running = 0;
+
+    /// Interactive jobs allowed to wait for a worker before submit() rejects
+    std::size_t max_queued_interactive = 64;
+
+    /// Batch jobs allowed to wait for a worker before submit() rejects
+    std::size_t max_queued_batch = 16;
+};
+
+/**
+ * @brief Counters of one priority class.
+ *
+ * Wait times run from submission to start; totals and maxima cover the
+ * jobs that started (wait) or finished (run) so far.
+ */
+struct SchedulerStats {
+    std::size_t queued = 0;
+    std::size_t running = 0;
+    std::uint64_t submitted = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t rejected = 0;
+    std::uint64_t cancelled = 0;
+    double wait_seconds_total = 0.0;
+    double wait_seconds_max = 0.0;
+    double run_seconds_total = 0.0;
+    double run_seconds_max = 0.0;
+};
+
+/**
+ * @brief Priority job queue with admission control over a ThreadPool.
+ *
+ * Batch jobs may take every slot but one (all of them when there is only
+ * one). The destructor cancels queued jobs and waits for running ones.
+ *
+ * Thread-safe. A job must not wait for another job of the same scheduler:
+ * with every slot taken by waiters nothing could run.
+ */
+class JobScheduler {
+public:
+    explicit JobScheduler(ThreadPool& pool, const SchedulerLimits& limits = {});
+    ~JobScheduler();
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    /**
+     * @brief Queue fn as a job; it starts as soon as a slot of its class
+     *        is free.
+     *
+     * An exception thrown by fn is kept in Job::error().
+     *
+     * @throws SchedulerOverloaded if the job's class already has its
+     *         maximum of queued jobs
+     */
+    std::shared_ptr<Job> submit(std::function<void()> fn, TaskPriority priority);
+
+    /// Replace the limits; jobs already queued are kept
+    void set_limits(const SchedulerLimits& limits);
+
+    SchedulerLimits limits() const;
+
+    /// Jobs that may run at once
+    unsigned slots() const;
+
+    /// Snapshot of one class's counters
+    SchedulerStats stats(TaskPriority priority) const;
+
+    /// Cancel every queued job (e.g. at shutdown); returns how many
+    std::size_t cancel_pending();
+
+    /// Block until no job is queued or running
+    void wait_idle();
+
+    /// Process-wide scheduler over ThreadPool::instance()
+    static JobScheduler& instance();
+
+private:
+    friend class Job;
+
+    unsigned slots_locked() const;
+    bool can_start_locked(TaskPriority priority) const;
+    void start_locked(const std::shared_ptr<Job>& job);
+    void dispatch_locked();
+
+    /// Job::cancel() of a job still queued here
+    bool cancel(Job& job);
+
+    /// Job finished running (state Done)
+    void finished(Job& job);
+
+    ThreadPool& pool_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable idle_cv_;
+    SchedulerLimits limits_;
+    std::deque<std::shared_ptr<Job>> queued_[NUM_TASK_PRIORITIES];
+    SchedulerStats stats_[NUM_TASK_PRIORITIES];
+    unsigned running_total_ = 0;
+};
+
+} // namespace quant
+
+#endif // JOB_SCHEDULER_H
@@ -9,11 +9,16 @@
 #ifndef MONTE_CARLO_H
 #define MONTE_CARLO_H
 
+#include "engine_timings.h"
+#include "path_export.h"
+
 #include <vector>
 #include <cstdint>
 
 namespace quant {
 
+class SimulationWorkspace;
+
 /**
  * @brief Aggregated results from Monte Carlo simulation.
  *
@@ -22,7 +27,12 @@ namespace quant {
  * and risk analysis.
  */
 struct SimulationResult {
-    /// Average price path across all simulations (length = num_steps + 1)
+    /// Step index of each point of the per-step arrays below: 0 ..
+    /// num_steps, or every output_stride-th step plus the final one
+    std::vector<int> steps;
+
+    /// Average price path across all simulations (one value per entry of
+    /// steps, num_steps + 1 unless decimated)
     std::vector<double> mean_path;
 
     /// 5th percentile path - 95% confidence interval lower bound
@@ -31,22 +41,254 @@ struct SimulationResult {
     /// 95th percentile path - 95% confidence interval upper bound
     std::vector<double> percentile_95;
 
+    /// Quantiles of the percentile bands, as requested
+    std::vector<double> quantiles;
+
+    /// Percentile band matrix, row-major [quantile][point]
+    /// (size = quantiles.size() * steps.size())
+    std::vector<double> percentile_bands;
+
     /// Histogram of final prices (length = histogram_bins)
     std::vector<int> histogram_data;
 
     /// Histogram bin edges (length = histogram_bins + 1)
     std::vector<double> histogram_edges;
 
-    /// Summary statistics for final prices
+    /// Summary statistics for final prices. Under
+    /// VarianceReduction::ControlVariate the mean is the control-variate
+    /// estimate.
     double final_price_mean;
     double final_price_std;
     double final_price_min;
     double final_price_max;
 
+    /// Standard error of final_price_mean under the variance-reduction
+    /// mode used (see VarianceReduction)
+    double standard_error;
+
     /// Tail Risk Metrics
-    std::vector<double> final_prices; // Expose full distribution for CVaR calc
+    std::vector<double> final_prices; // Full distribution, only if requested (unordered)
     double final_percentile_05;       // For 95% VaR
     double final_percentile_01;       // For 99% VaR
+
+    /// Confidence levels of the risk metrics below, as requested
+    std::vector<double> confidence_levels;
+
+    /// Value at Risk per confidence level: s0 minus the (1 - c) quantile
+    /// of final prices (positive = loss)
+    std::vector<double> value_at_risk;
+
+    /// Expected shortfall (CVaR) per confidence level: s0 minus the mean
+    /// final price at or below the VaR quantile
+    std::vector<double> expected_shortfall;
+
+    /// Fraction of paths that finish below s0
+    double probability_of_loss;
+
+    /// Maximum drawdown of each path, as a fraction of its running peak:
+    /// mean over paths, and the c quantile per confidence level
+    double max_drawdown_mean;
+    std::vector<double> max_drawdown_quantiles;
+
+    /// Phase timings of the run (zero unless built with timings)
+    SimulationTimings timings;
+};
+
+/**
+ * @brief How simulated paths are held in memory while aggregating.
+ */
+enum class PathStorage {
+    /// Materialize the full (num_steps + 1) x num_simulations path matrix.
+    Full,
+
+    /// Advance all paths one block of steps at a time and aggregate each
+    /// step as it is produced. Peak memory is O(num_simulations) instead of
+    /// O(num_steps * num_simulations).
+    Streaming
+};
+
+/**
+ * @brief Precision of the per-step path rows the aggregators read.
+ *
+ * Prices are always advanced, tracked for drawdowns and finalized in
+ * double; the precision only applies to the rows behind the mean path and
+ * percentile bands (and an export, see PathExportOptions).
+ */
+enum class PathPrecision {
+    /// float64 rows: the statistics are exact
+    Double,
+
+    /// float32 rows: half the memory and write bandwidth of the path
+    /// matrix (and a float32 export needs no conversion). Each row value
+    /// is the double price rounded to nearest, and rounding is monotonic,
+    /// so mean_path, percentile_05/95 and percentile_bands are within a
+    /// relative 2^-24 (about 6e-8) of the Double results (prices must stay
+    /// within float range, about 1e-38 to 3e38). Terminal statistics, tail
+    /// risk, drawdowns and the standard error are bit-identical.
+    Float32
+};
+
+/**
+ * @brief How the normal shocks driving the paths are drawn.
+ *
+ * Every mode gives unbiased estimates; SimulationResult::standard_error
+ * uses the matching estimator.
+ */
+enum class VarianceReduction {
+    /// Independent pseudo-random normals per path and step
+    None,
+
+    /// Paths 2k and 2k + 1 use the shocks z and -z. Standard error from
+    /// the spread of pair means.
+    Antithetic,
+
+    /// Pseudo-random paths; the final price mean is corrected with the
+    /// path's summed shock W (known mean 0) as a control variate,
+    /// mean(S_T) - b * mean(W) with the regression coefficient b.
+    ControlVariate,
+
+    /// Randomized quasi-Monte Carlo: the coarse shape of each path comes
+    /// from a Sobol point through a Brownian bridge (terminal value first)
+    /// on up to 16 knots (SOBOL_MAX_DIMS), and pseudo-random bridges fill in
+    /// the steps between knots. Paths form 16 interleaved replicates with
+    /// independent random digital shifts; the standard error comes from
+    /// the spread of replicate means.
+    Sobol
+};
+
+/**
+ * @brief Stochastic process driving the price paths.
+ *
+ * In every model mu is the expected return: E[S(T)] = s0 * exp(mu * T).
+ */
+enum class ProcessModel {
+    /// Geometric Brownian motion with constant volatility sigma
+    GBM,
+
+    /// Heston stochastic variance (see HestonParams); sigma is unused
+    Heston,
+
+    /// Merton jump diffusion: GBM plus log-normal jumps at Poisson times
+    /// (see MertonParams)
+    Merton,
+
+    /// GARCH(1,1) variance of the per-step log returns (see GarchParams)
+    GARCH
+};
+
+/**
+ * @brief Heston model: dv = kappa (theta - v) dt + xi sqrt(v) dW_v with
+ *        corr(dW_S, dW_v) = rho. Simulated with full-truncation Euler.
+ */
+struct HestonParams {
+    /// Initial variance (annualized)
+    double v0 = 0.04;
+
+    /// Mean-reversion speed per year
+    double kappa = 2.0;
+
+    /// Long-run variance (annualized)
+    double theta = 0.04;
+
+    /// Volatility of variance
+    double xi = 0.3;
+
+    /// Correlation of price and variance shocks, in [-1, 1]
+    double rho = -0.7;
+};
+
+/**
+ * @brief Merton jump diffusion: at rate intensity the log price jumps by
+ *        N(jump_mean, jump_std^2). The drift is compensated for the jumps.
+ */
+struct MertonParams {
+    /// Expected jumps per year
+    double intensity = 0.5;
+
+    /// Mean of the log jump size
+    double jump_mean = -0.05;
+
+    /// Standard deviation of the log jump size
+    double jump_std = 0.1;
+};
+
+/**
+ * @brief GARCH(1,1) on the per-step log-return variance:
+ *        h(t+1) = omega + alpha * eps(t)^2 + beta * h(t), starting from
+ *        h = sigma^2 * dt, with omega set by the long-run variance.
+ */
+struct GarchParams {
+    /// Weight of the last squared shock
+    double alpha = 0.08;
+
+    /// Weight of the last variance; alpha + beta must be below 1
+    double beta = 0.9;
+
+    /// Long-run variance (annualized); 0 = sigma^2
+    double long_run_variance = 0.0;
+};
+
+/**
+ * @brief Full parameter set for a Monte Carlo run.
+ *
+ * Mirrors the arguments of the positional run_monte_carlo() overload and
+ * adds engine options that do not change the model being simulated.
+ */
+struct SimulationConfig {
+    double s0 = 100.0;
+    double mu = 0.0;
+    double sigma = 0.0;
+    int num_simulations = 10000;
+    int num_steps = 252;
+    double dt = 1.0 / 252.0;
+    int histogram_bins = 50;
+    uint64_t seed = 0;
+
+    /// Path storage strategy (see PathStorage)
+    PathStorage storage = PathStorage::Full;
+
+    /// Precision of the step rows (see PathPrecision)
+    PathPrecision path_precision = PathPrecision::Double;
+
+    /// Aggregate every output_stride-th step plus the final one into the
+    /// per-step results (see SimulationResult::steps); drawdowns and final
+    /// prices still follow every step
+    int output_stride = 1;
+
+    /// Carry log prices, adding each step's log return, and exponentiate
+    /// only at the aggregated steps and once per path at the end, instead
+    /// of once per path and step. Equal to the default up to rounding; the
+    /// exponentials saved grow with output_stride.
+    bool log_space = false;
+
+    /// Worker threads to use (0 = all cores). Does not affect the output.
+    int num_threads = 0;
+
+    /// Quantiles in [0, 1] reported in SimulationResult::percentile_bands.
+    /// All of them come out of one selection pass per step.
+    std::vector<double> quantiles = {0.05, 0.95};
+
+    /// Confidence levels in (0, 1) for VaR, expected shortfall and the
+    /// drawdown quantiles
+    std::vector<double> confidence_levels = {0.95, 0.99};
+
+    /// Copy every final price into SimulationResult::final_prices
+    bool keep_final_prices = false;
+
+    /// Shock generation scheme (see VarianceReduction). Applies to the
+    /// price shocks; the extra factors of Heston and Merton are always
+    /// pseudo-random.
+    VarianceReduction variance_reduction = VarianceReduction::None;
+
+    /// Price process and the parameters of the non-GBM models
+    ProcessModel model = ProcessModel::GBM;
+    HestonParams heston;
+    MertonParams merton;
+    GarchParams garch;
+
+    /// Write every path to a file while simulating (see path_export.h);
+    /// disabled while export_paths.path is empty
+    PathExportOptions export_paths;
 };
 
 /**
@@ -66,10 +308,13 @@ struct SimulationResult {
  * @param histogram_bins  Number of bins for final price histogram
  * @param seed            Random seed for reproducibility (0 = random seed)
  *
- * @return SimulationResult containing aggregated statistics
+ * @return SimulationResult containing aggregated statistics (including
+ *         final_prices, and the default confidence levels)
  *
- * @note Uses std::mt19937_64 for high-quality random number generation.
- * @note All time steps must use double precision to avoid zero-output bugs.
+ * @note Uses a counter-based Philox4x32-10 stream per path (see rng.h), so a
+ *       given seed gives identical output for any thread count.
+ * @note All time steps must use double precision to avoid zero-output bugs
+ *       (PathPrecision::Float32 only narrows the stored step rows).
  */
 SimulationResult run_monte_carlo(
     double s0,
@@ -82,6 +327,67 @@ SimulationResult run_monte_carlo(
     uint64_t seed = 0
 );
 
+/**
+ * @brief Run Monte Carlo simulation from a SimulationConfig.
+ *
+ * Dispatches once on config.model and config.storage to a
+ * simulate<Process, Aggregator> instantiation (see path_simulation.h), so
+ * every model runs its own specialized step loop.
+ *
+ * @param config    Model parameters and engine options
+ * @param workspace Arena for the path buffers and per-path scratch; null
+ *                  uses the calling thread's (see simulation_workspace.h)
+ *
+ * @return SimulationResult containing aggregated statistics
+ *
+ * @throws std::invalid_argument for invalid model parameters, quantiles
+ *         or confidence levels, output_stride < 1, or a path export with
+ *         output_stride > 1.
+ * @throws std::runtime_error if workspace is in use by another run
+ *
+ * @note Paths are split into fixed-size blocks that run on the shared
+ *       ThreadPool. Output for a given seed is bit-identical across thread
+ *       counts and across storage modes.
+ */
+SimulationResult run_monte_carlo(const SimulationConfig& config, SimulationWorkspace* workspace = nullptr);
+
+/**
+ * @brief Model parameters that differ between the members of a batch.
+ */
+struct BatchMember {
+    double s0 = 100.0;
+    double mu = 0.0;
+    double sigma = 0.0;
+};
+
+/**
+ * @brief Run one simulation per member, sharing every other option.
+ *
+ * Member k runs config with its s0, mu and sigma replaced by members[k],
+ * so results[k] is bit-identical to the corresponding run_monte_carlo()
+ * call. Members run in parallel on the ThreadPool, each spreading its own
+ * path blocks over it too, so a batch of small members keeps every core
+ * busy. Each thread runs its members on one workspace, so warm workspaces
+ * make a batch allocation-free apart from its results.
+ *
+ * @param config    Options shared by every member (config.s0, mu and sigma
+ *                  are ignored)
+ * @param members   Per-member model parameters
+ * @param workspace Arena of the members run on the calling thread; null
+ *                  uses the calling thread's (pool workers use their own)
+ *
+ * @return One SimulationResult per member, in order
+ *
+ * @throws std::invalid_argument if any member or option is invalid
+ *         (checked before anything runs) or config exports paths
+ * @throws std::runtime_error if workspace is in use by another run
+ */
+std::vector<SimulationResult> run_monte_carlo_batch(
+    const SimulationConfig& config,
+    const std::vector<BatchMember>& members,
+    SimulationWorkspace* workspace = nullptr
+);
+
 } // namespace quant
 
 #endif // MONTE_CARLO_H
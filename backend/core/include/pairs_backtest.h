@@ -0,0 +1,124 @@
+/**
+ * @file pairs_backtest.h
+ * @brief Z-score pairs-trading backtest and its (entry, exit) grid sweep.
+ *
+ * The strategy is long the spread below -entry_z and short above +entry_z,
+ * and flat again once the z-score reverts inside +-exit_z or runs past
+ * +-stop_loss_z. The position of day i - 1 earns the spread change of day
+ * i, relative to the capital invested on day i.
+ */
+
+#ifndef PAIRS_BACKTEST_H
+#define PAIRS_BACKTEST_H
+
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Daily input series of a pair, one value per aligned trading day.
+ */
+struct PairsSeries {
+    const double* z_score = nullptr; // z-score of the spread
+    const double* spread = nullptr;  // price_1 - hedge_ratio * price_2
+    const double* capital = nullptr; // price_1 + hedge_ratio * price_2
+    std::size_t length = 0;
+};
+
+/**
+ * @brief Z-score thresholds of one strategy run.
+ */
+struct PairsThresholds {
+    double entry_z = 2.0;
+    double exit_z = 0.0;
+    double stop_loss_z = 4.0;
+};
+
+/**
+ * @brief Position (-1, 0, +1) after observing z, given the current one.
+ */
+inline int next_pairs_position(int position, double z, const PairsThresholds& t) {
+    if (position == 0) {
+        if (z < -t.entry_z) {
+            return 1;   // long spread
+        }
+        if (z > t.entry_z) {
+            return -1;  // short spread
+        }
+    } else if (position == 1) {
+        if (z > -t.exit_z || z < -t.stop_loss_z) {
+            return 0;   // reverted (profit) or stopped out
+        }
+    } else if (z < t.exit_z || z > t.stop_loss_z) {
+        return 0;
+    }
+    return position;
+}
+
+/**
+ * @brief Performance of one run over the length - 1 daily returns.
+ */
+struct PairsMetrics {
+    double total_return = 0.0;
+    double sharpe_ratio = 0.0;  // annualized (252 days), population std
+    double max_drawdown = 0.0;  // most negative (equity - peak) / peak
+    double win_rate = 0.0;      // winning days / days with a non-zero return
+    int trades = 0;             // days with a non-zero return
+};
+
+/**
+ * @brief One run with its curves.
+ */
+struct PairsBacktestResult {
+    PairsMetrics metrics;
+    std::vector<int> position;       // per day (length): -1, 0 or +1
+    std::vector<double> equity_curve; // per return (length - 1)
+    std::vector<double> drawdown;    // per return (length - 1)
+};
+
+/**
+ * @brief Metrics of every (entry_z, exit_z) pair, row-major
+ *        [entry][exit] (size = num_entry * num_exit).
+ */
+struct PairsGridResult {
+    int num_entry = 0;
+    int num_exit = 0;
+
+    std::vector<double> total_return;
+    std::vector<double> sharpe_ratio;
+    std::vector<double> max_drawdown;
+    std::vector<double> win_rate;
+    std::vector<int> trades;
+};
+
+/**
+ * @brief Backtest one set of thresholds and keep its curves.
+ *
+ * @throws std::invalid_argument if a series is missing.
+ */
+PairsBacktestResult run_pairs_backtest(const PairsSeries& series, const PairsThresholds& thresholds);
+
+/**
+ * @brief Metrics over an entry_z x exit_z grid at a fixed stop loss.
+ *
+ * Every cell runs the signal state machine and accumulates its metrics in
+ * one pass over the series, without materializing curves; cells run in
+ * parallel on the shared ThreadPool and results do not depend on the
+ * thread count.
+ *
+ * @param num_threads Worker threads (0 = all cores)
+ *
+ * @throws std::invalid_argument if a series is missing.
+ */
+PairsGridResult run_pairs_grid(
+    const PairsSeries& series,
+    const std::vector<double>& entry_z,
+    const std::vector<double>& exit_z,
+    double stop_loss_z,
+    int num_threads = 0
+);
+
+} // namespace quant
+
+#endif // PAIRS_BACKTEST_H
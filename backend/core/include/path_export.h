@@ -0,0 +1,121 @@
+/**
+ * @file path_export.h
+ * @brief Streaming binary export of simulated price paths.
+ *
+ * Rows of a path file are written while the engine runs, one per exported
+ * step, straight from its step buffers; nothing is held beyond the
+ * engine's own working set, however large the export.
+ *
+ * Layout (little-endian, every section 64-byte aligned):
+ *   header   64 bytes (magic "STRATAPT", version, value size, counts,
+ *            offset of the values)
+ *   steps    num_points int32 step indices, increasing, ending at
+ *            num_steps
+ *   values   num_points rows of num_paths float32 or float64; row r holds
+ *            the price of every path at step steps[r]
+ *
+ * In NumPy the values are np.memmap(path, dtype, "r", values_offset,
+ * (num_points, num_paths)); .T gives one row per path.
+ */
+
+#ifndef PATH_EXPORT_H
+#define PATH_EXPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Where and how run_monte_carlo writes its paths.
+ */
+struct PathExportOptions {
+    /// Destination file; empty disables the export
+    std::string path;
+
+    /// Store values as float32 (else float64)
+    bool float32 = true;
+
+    /// Export every step_stride-th step, starting at 0; the final step is
+    /// always exported
+    int step_stride = 1;
+};
+
+/**
+ * @brief Steps a path file of num_steps steps holds at step_stride.
+ */
+std::vector<int> exported_steps(int num_steps, int step_stride);
+
+/**
+ * @brief Writer of one path file, fed row by row in step order.
+ *
+ * Writes to path + ".tmp" and renames it into place on close(); a writer
+ * destroyed before close() (e.g. by an engine error) removes the partial
+ * file.
+ */
+class PathWriter {
+public:
+    /**
+     * @throws std::invalid_argument for step_stride < 1 or an empty path
+     * @throws std::runtime_error if the file cannot be created
+     */
+    PathWriter(const PathExportOptions& options, int num_paths, int num_steps);
+    ~PathWriter();
+
+    PathWriter(const PathWriter&) = delete;
+    PathWriter& operator=(const PathWriter&) = delete;
+
+    /// Whether step is one of the exported steps
+    bool exports(int step) const;
+
+    /**
+     * @brief Append the row of an exported step (num_paths values).
+     *
+     * @throws std::logic_error if step is not the next exported step
+     * @throws std::runtime_error if the write fails
+     */
+    void write(int step, const double* values);
+
+    /// write() of a PathPrecision::Float32 row
+    void write(int step, const float* values);
+
+    /**
+     * @brief Flush and move the file into place.
+     *
+     * @throws std::logic_error if rows are missing
+     * @throws std::runtime_error if the file cannot be written or renamed
+     */
+    void close();
+
+    /// Bytes written so far, header included
+    std::size_t bytes_written() const { return written_; }
+
+private:
+    void put(const void* data, std::size_t bytes);
+    void advance_row(int step);
+
+    /// Write a row in the other precision, through buffer
+    template <typename To, typename From>
+    void put_converted(const From* values, std::vector<To>& buffer);
+
+    std::string path_;
+    std::string staging_;
+    std::ofstream out_;
+    bool float32_;
+    int step_stride_;
+    int num_paths_;
+    int num_steps_;
+    std::vector<int> steps_;
+    std::size_t next_row_ = 0;
+    std::size_t written_ = 0;
+    std::vector<float> narrow_;  // float64 rows to a float32 file
+    std::vector<double> widen_;  // float32 rows to a float64 file
+    bool closed_ = false;
+};
+
+} // namespace quant
+
+#endif // PATH_EXPORT_H
@@ -0,0 +1,67 @@
+/**
+ * @file path_matrix.h
+ * @brief Flat, 64-byte aligned step-major matrix of simulated values.
+ *
+ * Row s holds the values of every path at step s, and each row starts on a
+ * cache line (rows are padded to pitch() values). The engines write a
+ * tile of paths over a block of steps at a time, touching only a few
+ * rows, and the per-step aggregation reads each row as one contiguous
+ * array.
+ */
+
+#ifndef PATH_MATRIX_H
+#define PATH_MATRIX_H
+
+#include "simulation_workspace.h"
+
+#include <cstddef>
+
+namespace quant {
+
+/**
+ * @brief View of a rows x cols step-major matrix of Value in workspace
+ *        memory.
+ *
+ * Does not own its storage: the workspace block lives until the run's
+ * lease ends.
+ */
+template <typename Value>
+class BasicPathMatrix {
+public:
+    /// Values per row: cols rounded up to whole cache lines
+    static std::size_t pitch_for(int cols) {
+        constexpr std::size_t LINE = WORKSPACE_ALIGNMENT / sizeof(Value);
+        return (static_cast<std::size_t>(cols) + LINE - 1) / LINE * LINE;
+    }
+
+    BasicPathMatrix() = default;
+
+    /// Uninitialized rows x cols matrix taken from workspace
+    BasicPathMatrix(SimulationWorkspace& workspace, int rows, int cols)
+        : rows_(rows),
+          cols_(cols),
+          pitch_(pitch_for(cols)),
+          data_(workspace.allocate<Value>(static_cast<std::size_t>(rows) * pitch_)) {}
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    std::size_t pitch() const { return pitch_; }
+
+    /// Bytes of the matrix including row padding
+    std::size_t bytes() const { return static_cast<std::size_t>(rows_) * pitch_ * sizeof(Value); }
+
+    Value* row(int r) { return data_ + r * pitch_; }
+    const Value* row(int r) const { return data_ + r * pitch_; }
+
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    std::size_t pitch_ = 0;
+    Value* data_ = nullptr;
+};
+
+using PathMatrix = BasicPathMatrix<double>;
+
+} // namespace quant
+
+#endif // PATH_MATRIX_H
@@ -0,0 +1,443 @@
+/**
+ * @file path_simulation.h
+ * @brief Model-independent single-asset path engine,
+ *        simulate<Process, Aggregator>.
+ *
+ * The process policy (process_models.h) decides how prices move; the
+ * aggregator policy decides how many steps are produced per pass and what
+ * happens to each step's prices. Both are template parameters so the step
+ * loop of every combination is compiled and inlined on its own.
+ *
+ * An aggregator provides
+ *
+ *   int steps_per_pass() const;
+ *   bool records(int step) const;
+ *   void begin(double initial_price);
+ *   void record(int step, int path, const double* prices, int lanes);
+ *   void end_pass(int first, int count);
+ *   void finish();
+ *
+ * where record() receives the prices of paths path .. path + lanes - 1 at
+ * one step (always double; the aggregator stores them at its own
+ * precision, see PathPrecision), for the steps records() selects (see
+ * SimulationConfig::output_stride). record() runs concurrently for
+ * disjoint tiles of one pass; end_pass() runs once the pass is complete,
+ * finish() after the last pass.
+ *
+ * Path buffers, per-path state and aggregator rows all come from the run's
+ * SimulationWorkspace, so a warm workspace makes a run allocation-free
+ * apart from its result. Given a PathWriter, the aggregators export each
+ * step's row before aggregation reorders it.
+ */
+
+#ifndef PATH_SIMULATION_H
+#define PATH_SIMULATION_H
+
+#include "engine_timings.h"
+#include "monte_carlo.h"
+#include "path_export.h"
+#include "path_matrix.h"
+#include "path_statistics.h"
+#include "simd_kernels.h"
+#include "simulation_workspace.h"
+#include "thread_pool.h"
+#include "variance_reduction.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+/// Paths per parallel task. Fixed so the work split never depends on the
+/// number of threads.
+constexpr int PATH_BLOCK = 1024;
+
+/// Steps of shocks generated per call, and per pass in streaming mode.
+/// Must be even so every block starts on a Philox normal pair.
+constexpr int STEP_BLOCK = 8;
+
+/// Philox stream of process factor f >= 1 is FACTOR_STREAM_BASE + f
+/// (streams 0 and 1 belong to the shock generator)
+constexpr uint32_t FACTOR_STREAM_BASE = 1;
+
+static_assert(PATH_BLOCK % SIMD_TILE == 0, "path blocks must hold whole SIMD tiles");
+
+/**
+ * @brief The seed to use for a run: config seed, or the clock when it is 0.
+ */
+inline uint64_t resolve_seed(uint64_t seed) {
+    if (seed == 0) {
+        auto now = std::chrono::high_resolution_clock::now();
+        seed = static_cast<uint64_t>(now.time_since_epoch().count());
+    }
+    return seed;
+}
+
+/**
+ * @brief Aggregation options of a single-asset run.
+ */
+inline AggregationOptions aggregation_options(const SimulationConfig& config) {
+    AggregationOptions options;
+    options.reference = config.s0;
+    options.histogram_bins = config.histogram_bins;
+    options.quantiles = config.quantiles;
+    options.confidence_levels = config.confidence_levels;
+    options.keep_final_values = config.keep_final_prices;
+    return options;
+}
+
+/**
+ * @brief Call fn with a Value{} of the row type config.path_precision
+ *        selects (double or float).
+ */
+template <typename Fn>
+void visit_precision(const SimulationConfig& config, Fn&& fn) {
+    if (config.path_precision == PathPrecision::Float32) {
+        fn(float{});
+    } else {
+        fn(double{});
+    }
+}
+
+/**
+ * @brief Materialize the (num_steps + 1) x num_simulations path matrix of
+ *        Value, then aggregate every step in parallel.
+ */
+template <typename Value = double>
+class FullPathAggregator {
+public:
+    FullPathAggregator(const SimulationConfig& config, const QuantilePlan& plan, SimulationResult& result,
+                       SimulationWorkspace& workspace, PathWriter* writer = nullptr)
+        : plan_(plan),
+          result_(result),
+          writer_(writer),
+          num_steps_(config.num_steps),
+          threads_(resolve_num_threads(config.num_threads)),
+          grid_(config.num_steps, config.output_stride),
+          paths_(workspace, grid_.num_points(), config.num_simulations) {
+        count_bytes(result.timings, paths_.bytes());
+    }
+
+    int steps_per_pass() const { return std::max(num_steps_, 1); }
+
+    bool records(int step) const { return grid_.contains(step); }
+
+    void begin(double initial_price) {
+        std::fill(paths_.row(0), paths_.row(0) + paths_.cols(), initial_price);
+    }
+
+    void record(int step, int path, const double* prices, int lanes) {
+        std::copy(prices, prices + lanes, paths_.row(grid_.point(step)) + path);
+    }
+
+    void end_pass(int, int) {}
+
+    void finish() {
+        // Exports run with output_stride 1, so rows are steps
+        if (writer_ != nullptr) {
+            PhaseTimer timer(result_.timings.export_seconds);
+            for (int step = 0; step <= num_steps_; ++step) {
+                if (writer_->exports(step)) {
+                    writer_->write(step, paths_.row(step));
+                }
+            }
+        }
+
+        PhaseTimer timer(result_.timings.step_stats_seconds);
+        // Steps are independent
+        ThreadPool::instance().parallel_for(paths_.rows(), threads_, [&](std::size_t point) {
+            const int p = static_cast<int>(point);
+            aggregate_step(paths_.row(p), paths_.cols(), p, plan_, result_);
+        });
+    }
+
+private:
+    const QuantilePlan& plan_;
+    SimulationResult& result_;
+    PathWriter* writer_;
+    int num_steps_;
+    unsigned threads_;
+    StepGrid grid_;
+
+    /// [point][simulation] for contiguous access during aggregation
+    BasicPathMatrix<Value> paths_;
+};
+
+/**
+ * @brief Aggregate each block of STEP_BLOCK steps as soon as it is
+ *        produced; only a STEP_BLOCK x num_simulations buffer of Value is
+ *        kept.
+ */
+template <typename Value = double>
+class StreamingAggregator {
+public:
+    StreamingAggregator(const SimulationConfig& config, const QuantilePlan& plan, SimulationResult& result,
+                        SimulationWorkspace& workspace, PathWriter* writer = nullptr)
+        : plan_(plan),
+          result_(result),
+          writer_(writer),
+          threads_(resolve_num_threads(config.num_threads)),
+          grid_(config.num_steps, config.output_stride),
+          rows_(workspace, std::min(STEP_BLOCK, std::max(config.num_steps, 1)), config.num_simulations) {
+        count_bytes(result.timings, rows_.bytes());
+    }
+
+    int steps_per_pass() const { return STEP_BLOCK; }
+
+    bool records(int step) const { return grid_.contains(step); }
+
+    void begin(double initial_price) {
+        std::fill(rows_.row(0), rows_.row(0) + rows_.cols(), initial_price);
+        export_rows(0, 1);
+
+        PhaseTimer timer(result_.timings.step_stats_seconds);
+        aggregate_step(rows_.row(0), rows_.cols(), 0, plan_, result_);
+    }
+
+    void record(int step, int path, const double* prices, int lanes) {
+        std::copy(prices, prices + lanes, rows_.row((step - 1) % STEP_BLOCK) + path);
+    }
+
+    void end_pass(int first, int count) {
+        export_rows(first, count);
+
+        PhaseTimer timer(result_.timings.step_stats_seconds);
+        // Reused for every block; aggregate_step reorders each row in place
+        ThreadPool::instance().parallel_for(count, threads_, [&](std::size_t j) {
+            const int r = static_cast<int>(j);
+            if (grid_.contains(first + r)) {
+                aggregate_step(rows_.row(r), rows_.cols(), grid_.point(first + r), plan_, result_);
+            }
+        });
+    }
+
+    void finish() {}
+
+private:
+    /// Write the exported steps among first .. first + count - 1 (rows
+    /// 0 .. count - 1)
+    void export_rows(int first, int count) {
+        if (writer_ == nullptr) {
+            return;
+        }
+        PhaseTimer timer(result_.timings.export_seconds);
+        for (int j = 0; j < count; ++j) {
+            if (writer_->exports(first + j)) {
+                writer_->write(first + j, rows_.row(j));
+            }
+        }
+    }
+
+    const QuantilePlan& plan_;
+    SimulationResult& result_;
+    PathWriter* writer_;
+    unsigned threads_;
+    StepGrid grid_;
+    BasicPathMatrix<Value> rows_;
+};
+
+/**
+ * @brief Simulate paths first_path .. first_path + num_paths - 1 under
+ *        Process, feeding every step to Aggregator.
+ *
+ * Passes of aggregator.steps_per_pass() steps run one after the other; in
+ * each, blocks of PATH_BLOCK paths run on the ThreadPool. A block advances
+ * all its SIMD tiles by STEP_BLOCK steps before moving on to the next
+ * STEP_BLOCK, so the aggregator's writes stay within STEP_BLOCK rows of
+ * PATH_BLOCK values (64 KiB) at a time. Current prices, process state and
+ * drawdowns are kept per path, so a pass can stop at any step and the
+ * output never depends on the pass length.
+ * Draws depend only on the global path index, so simulating a run in
+ * several ranges gives the same paths as one call over all of them.
+ *
+ * The aggregator sees range-local path indices; the shock generator sees
+ * global ones.
+ *
+ * With config.log_space the per-path buffers hold log prices and log
+ * drawdowns, advanced by Process::step_log(); prices are exponentiated
+ * only for the steps the aggregator records, and the outputs are
+ * converted once the range is done.
+ *
+ * @param workspace    Arena of the run; supplies the per-path peaks and
+ *                     process state
+ * @param first_path   Global index of the first path; must be a multiple
+ *                     of SIMD_TILE (keeps antithetic pairs together)
+ * @param num_paths    Paths in the range
+ * @param cancel       Polled before every block of paths (may be null)
+ * @param final_prices Out: final price of each path (num_paths)
+ * @param max_drawdown Out: maximum drawdown of each path (num_paths)
+ *
+ * @return false if cancelled; the outputs are then incomplete
+ */
+template <typename Process, typename Aggregator>
+bool simulate_paths(
+    const SimulationConfig& config,
+    const Process& process,
+    uint64_t key,
+    ShockGenerator& shocks,
+    Aggregator& aggregator,
+    SimulationWorkspace& workspace,
+    int first_path,
+    int num_paths,
+    const CancellationToken* cancel,
+    double* final_prices,
+    double* max_drawdown
+) {
+    constexpr int NUM_FACTORS = Process::NUM_FACTORS;
+    constexpr int NUM_STATES = Process::NUM_STATES;
+    constexpr std::size_t FACTOR_STRIDE = STEP_BLOCK * SIMD_TILE;
+
+    const int num_steps = config.num_steps;
+    const unsigned threads = resolve_num_threads(config.num_threads);
+    const std::size_t num_blocks = static_cast<std::size_t>((num_paths + PATH_BLOCK - 1) / PATH_BLOCK);
+    const SimdKernels& kernels = simd_kernels();
+
+    const bool log_space = config.log_space;
+    const double start = log_space ? std::log(config.s0) : config.s0;
+
+    // final_prices holds the current (log) price of every path until the
+    // last step
+    double* prices = final_prices;
+    std::fill(prices, prices + num_paths, start);
+    std::fill(max_drawdown, max_drawdown + num_paths, 0.0);
+    double* peak = workspace.allocate<double>(num_paths);
+    std::fill(peak, peak + num_paths, start);
+
+    // Process state laid out tile by tile as [tile][state][lane]
+    const std::size_t num_tiles = (num_paths + SIMD_TILE - 1) / SIMD_TILE;
+    const std::size_t state_size = num_tiles * NUM_STATES * SIMD_TILE;
+    double* state = workspace.allocate<double>(state_size);
+    std::fill(state, state + state_size, 0.0);
+
+    aggregator.begin(config.s0);
+
+    for (int pass = 1; pass <= num_steps; pass += aggregator.steps_per_pass()) {
+        const int pass_end = std::min(pass + aggregator.steps_per_pass(), num_steps + 1);
+
+        ThreadPool::instance().parallel_for(num_blocks, threads, [&](std::size_t block) {
+            if (cancel != nullptr && cancel->cancelled()) {
+                return;
+            }
+
+            const int local_begin = static_cast<int>(block) * PATH_BLOCK;
+            const int local_end = std::min(local_begin + PATH_BLOCK, num_paths);
+            alignas(64) double z[NUM_FACTORS * STEP_BLOCK * SIMD_TILE];
+            alignas(64) double exp_prices[SIMD_TILE];
+
+            for (int first = pass; first < pass_end; first += STEP_BLOCK) {
+                const int count = std::min(STEP_BLOCK, pass_end - first);
+
+                for (int local = local_begin; local < local_end; local += SIMD_TILE) {
+                    const int sim0 = first_path + local;
+                    const int lanes = std::min(SIMD_TILE, local_end - local);
+                    double* tile_prices = prices + local;
+                    double* tile_state = state + (local / SIMD_TILE) * NUM_STATES * SIMD_TILE;
+
+                    if (first == 1) {
+                        process.initialize(tile_state, lanes);
+                    }
+
+                    shocks.generate(sim0, lanes, first, count, z);
+                    for (int f = 1; f < NUM_FACTORS; ++f) {
+                        kernels.normals(key, static_cast<uint64_t>(sim0), lanes, (first - 1) / 2,
+                                        (count + 1) / 2, FACTOR_STREAM_BASE + f, z + f * FACTOR_STRIDE);
+                    }
+
+                    for (int j = 0; j < count; ++j) {
+                        const int step = first + j;
+                        if (log_space) {
+                            process.step_log(z + j * SIMD_TILE, FACTOR_STRIDE, tile_state, tile_prices, lanes);
+                            if (aggregator.records(step)) {
+                                kernels.exp(tile_prices, exp_prices, lanes);
+                                aggregator.record(step, local, exp_prices, lanes);
+                            }
+                            track_log_drawdown(tile_prices, peak + local, max_drawdown + local, lanes);
+                        } else {
+                            process.step(z + j * SIMD_TILE, FACTOR_STRIDE, tile_state, tile_prices, lanes);
+                            if (aggregator.records(step)) {
+                                aggregator.record(step, local, tile_prices, lanes);
+                            }
+                            track_drawdown(tile_prices, peak + local, max_drawdown + local, lanes);
+                        }
+                    }
+                }
+            }
+        });
+
+        if (cancel != nullptr && cancel->cancelled()) {
+            return false;
+        }
+        aggregator.end_pass(pass, pass_end - pass);
+    }
+    aggregator.finish();
+
+    if (log_space) {
+        // Drawdown 1 - exp(-d) of each log drawdown d
+        kernels.exp(final_prices, final_prices, num_paths);
+        for (int i = 0; i < num_paths; ++i) {
+            max_drawdown[i] = -max_drawdown[i];
+        }
+        kernels.exp(max_drawdown, max_drawdown, num_paths);
+        for (int i = 0; i < num_paths; ++i) {
+            max_drawdown[i] = 1.0 - max_drawdown[i];
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Simulate every path of a run under Process and aggregate it with
+ *        Aggregator into result.
+ *
+ * Fills the per-step statistics through the aggregator and the terminal
+ * statistics, drawdowns and mean estimate directly, timing each phase
+ * into result.timings.
+ */
+template <typename Process, typename Aggregator>
+void simulate(
+    const SimulationConfig& config,
+    const Process& process,
+    uint64_t key,
+    ShockGenerator& shocks,
+    Aggregator& aggregator,
+    SimulationWorkspace& workspace,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    const int num_simulations = config.num_simulations;
+    double* final_prices = workspace.allocate<double>(num_simulations);
+    double* max_drawdown = workspace.allocate<double>(num_simulations);
+
+    // Final prices, drawdowns, peaks and the tiled process state of
+    // simulate_paths
+    const std::size_t num_tiles = (config.num_simulations + SIMD_TILE - 1) / SIMD_TILE;
+    count_bytes(result.timings,
+                (3 * static_cast<std::size_t>(config.num_simulations)
+                 + num_tiles * Process::NUM_STATES * SIMD_TILE) * sizeof(double));
+
+    {
+        PhaseTimer timer(result.timings.path_seconds);
+        simulate_paths(config, process, key, shocks, aggregator, workspace, 0, num_simulations, nullptr,
+                       final_prices, max_drawdown);
+    }
+    // The aggregator's passes (and exports) ran inside simulate_paths
+    result.timings.path_seconds -= result.timings.step_stats_seconds + result.timings.export_seconds;
+
+    PhaseTimer timer(result.timings.final_stats_seconds);
+
+    // Before aggregation reorders the final prices
+    const MeanEstimate estimate = shocks.estimate_mean(final_prices, num_simulations);
+
+    aggregate_final_values(final_prices, num_simulations, options, plan, result);
+    aggregate_drawdowns(max_drawdown, num_simulations, options, plan, result);
+    apply_mean_estimate(estimate, config.variance_reduction, result);
+}
+
+} // namespace quant
+
+#endif // PATH_SIMULATION_H
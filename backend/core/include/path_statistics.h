@@ -0,0 +1,212 @@
+/**
+ * @file path_statistics.h
+ * @brief Per-step and terminal aggregation of simulated value paths.
+ *
+ * Shared by the single-asset and portfolio Monte Carlo engines: both
+ * reduce num_simulations values per step to a SimulationResult (mean path,
+ * percentile bands, terminal statistics, tail risk and drawdowns).
+ */
+
+#ifndef PATH_STATISTICS_H
+#define PATH_STATISTICS_H
+
+#include "monte_carlo.h"
+
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Order-statistic positions needed at every step and at the end.
+ *
+ * Built (and validated) before any path is generated.
+ */
+struct QuantilePlan {
+    /// Sorted union of all positions selected per step
+    std::vector<int> indices;
+
+    /// Position of each requested quantile (parallel to the quantiles)
+    std::vector<int> band_index;
+
+    /// Positions backing percentile_05 / percentile_95
+    int idx_05 = 0;
+    int idx_95 = 0;
+
+    /// Positions selected in the final values: min, max, the 1% / 5%
+    /// percentiles and every VaR cut-off
+    std::vector<int> final_indices;
+
+    /// Positions selected in the max drawdowns, one per confidence level
+    std::vector<int> drawdown_indices;
+};
+
+/**
+ * @brief Options that shape the aggregated result (not the paths).
+ */
+struct AggregationOptions {
+    /// Value losses are measured from (initial price or portfolio value)
+    double reference = 0.0;
+
+    int histogram_bins = 50;
+
+    /// Quantiles in [0, 1] for the percentile bands
+    std::vector<double> quantiles;
+
+    /// Confidence levels in (0, 1) for VaR, expected shortfall and the
+    /// drawdown quantiles
+    std::vector<double> confidence_levels;
+
+    /// Copy every final value into SimulationResult::final_prices
+    bool keep_final_values = false;
+};
+
+/**
+ * @brief Steps 0 .. num_steps that are aggregated: every stride-th one and
+ *        the final step, each at its own point of the per-step results.
+ */
+class StepGrid {
+public:
+    /// @throws std::invalid_argument for stride < 1
+    StepGrid(int num_steps, int stride);
+
+    bool contains(int step) const { return step % stride_ == 0 || step == num_steps_; }
+
+    /// Point of an aggregated step (index into SimulationResult::steps)
+    int point(int step) const { return step == num_steps_ ? num_points_ - 1 : step / stride_; }
+
+    int num_points() const { return num_points_; }
+    int num_steps() const { return num_steps_; }
+    int stride() const { return stride_; }
+
+private:
+    int num_steps_;
+    int stride_;
+    int num_points_;
+};
+
+/**
+ * @brief Selection plan for a run of num_simulations paths.
+ *
+ * @throws std::invalid_argument for a quantile outside [0, 1] or a
+ *         confidence level outside (0, 1).
+ */
+QuantilePlan make_quantile_plan(int num_simulations, const AggregationOptions& options);
+
+/**
+ * @brief Check the aggregation options of a run without building anything.
+ *
+ * @throws std::invalid_argument for the options StepGrid and
+ *         make_quantile_plan() reject: stride < 1, a quantile outside
+ *         [0, 1] or a confidence level outside (0, 1).
+ */
+void validate_aggregation(int stride, const AggregationOptions& options);
+
+/**
+ * @brief Size the per-step and per-level buffers of a result, with one
+ *        point per step of grid.
+ */
+void prepare_result(SimulationResult& result, const StepGrid& grid, const AggregationOptions& options);
+
+/// prepare_result() for every step 0 .. num_steps
+inline void prepare_result(SimulationResult& result, int num_steps, const AggregationOptions& options) {
+    prepare_result(result, StepGrid(num_steps, 1), options);
+}
+
+/**
+ * @brief Fold one step of values into each path's running peak and
+ *        maximum drawdown.
+ */
+void track_drawdown(const double* values, double* peak, double* max_drawdown, int n);
+
+/**
+ * @brief track_drawdown() on log values: peak and max_drawdown hold the
+ *        running log peak and the largest log peak - value.
+ *
+ * A log drawdown d is the drawdown 1 - exp(-d), so the per-path maxima
+ * need one exponential each at the end instead of a division per step.
+ */
+void track_log_drawdown(const double* log_values, double* peak, double* max_drawdown, int n);
+
+/**
+ * @brief Mean and percentile bands for one time step, stored at point
+ *        (the step's index in SimulationResult::steps).
+ *
+ * Reorders step_values (partial selection) as a side effect. Steps are
+ * independent and may be aggregated concurrently.
+ */
+void aggregate_step(
+    double* step_values,
+    int num_simulations,
+    int point,
+    const QuantilePlan& plan,
+    SimulationResult& result
+);
+
+/**
+ * @brief aggregate_step over a PathPrecision::Float32 row; the mean is
+ *        accumulated in double.
+ */
+void aggregate_step(
+    float* step_values,
+    int num_simulations,
+    int point,
+    const QuantilePlan& plan,
+    SimulationResult& result
+);
+
+inline void aggregate_step(
+    std::vector<double>& step_values,
+    int point,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    aggregate_step(step_values.data(), static_cast<int>(step_values.size()), point, plan, result);
+}
+
+/**
+ * @brief Final value statistics, tail risk metrics and histogram.
+ *
+ * standard_error assumes independent paths. Reorders final_values (partial selection) as a side effect.
+ */
+void aggregate_final_values(
+    double* final_values,
+    int num_simulations,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationResult& result
+);
+
+inline void aggregate_final_values(
+    std::vector<double>& final_values,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    aggregate_final_values(final_values.data(), static_cast<int>(final_values.size()), options, plan, result);
+}
+
+/**
+ * @brief Distribution of per-path maximum drawdowns.
+ *
+ * Reorders max_drawdown (partial selection) as a side effect.
+ */
+void aggregate_drawdowns(
+    double* max_drawdown,
+    int num_simulations,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationResult& result
+);
+
+inline void aggregate_drawdowns(
+    std::vector<double>& max_drawdown,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    aggregate_drawdowns(max_drawdown.data(), static_cast<int>(max_drawdown.size()), options, plan, result);
+}
+
+} // namespace quant
+
+#endif // PATH_STATISTICS_H
@@ -0,0 +1,55 @@
+/**
+ * @file percentiles.h
+ * @brief Order-statistic selection for percentile bands.
+ *
+ * Computes several percentiles of the same sample with one partial
+ * partitioning pass instead of a full sort.
+ */
+
+#ifndef PERCENTILES_H
+#define PERCENTILES_H
+
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Position of quantile q in an ascending sample of size n.
+ *
+ * Uses the engine's historical convention floor(q * n), clamped to
+ * [0, n - 1].
+ */
+int quantile_index(double q, int n);
+
+/**
+ * @brief Order-statistic positions for a list of quantiles.
+ *
+ * @param quantiles Quantiles in [0, 1], any order
+ * @param n         Sample size
+ *
+ * @return Sorted, de-duplicated positions
+ *
+ * @throws std::invalid_argument if a quantile lies outside [0, 1].
+ */
+std::vector<int> quantile_indices(const std::vector<double>& quantiles, int n);
+
+/**
+ * @brief Partially reorder data so that each requested position holds its
+ *        order statistic.
+ *
+ * After the call, data[k] for every k in sorted_indices equals the value a
+ * full ascending sort would place there. Recursive std::nth_element over
+ * the index list: O(n log m) for m positions, versus O(n log n) for a sort.
+ *
+ * @param data           Sample, reordered in place
+ * @param n              Sample size
+ * @param sorted_indices Ascending, unique positions in [0, n)
+ */
+void select_order_statistics(double* data, int n, const std::vector<int>& sorted_indices);
+
+/// float variant, for PathPrecision::Float32 step rows
+void select_order_statistics(float* data, int n, const std::vector<int>& sorted_indices);
+
+} // namespace quant
+
+#endif // PERCENTILES_H
@@ -0,0 +1,157 @@
+/**
+ * @file price_panel.h
+ * @brief Memory-mapped columnar (dates x symbols) daily price panel.
+ *
+ * A panel file holds every symbol's daily series as one contiguous,
+ * 64-byte aligned float64 column per price field, over the union of all
+ * trading dates, plus a per-symbol validity bitmap (bit t set when the
+ * symbol has a bar on date t). Ingestion rewrites the file; readers map it
+ * read-only, so opening a panel costs a few page faults rather than
+ * hydrating database rows.
+ *
+ * Layout (little-endian, every section 64-byte aligned):
+ *   header      64 bytes (magic "STRATAPX", version, counts, offsets)
+ *   fields      num_fields x 32-byte NUL-padded names
+ *   symbols     num_symbols x 32-byte NUL-padded names, sorted
+ *   dates       num_dates int64 days since 1970-01-01, increasing
+ *   validity    num_symbols x ceil(num_dates / 64) uint64 words
+ *   values      num_fields x num_symbols columns of column_stride doubles
+ *               (NaN where invalid), column_stride = num_dates rounded up
+ *               to a multiple of 8
+ */
+
+#ifndef PRICE_PANEL_H
+#define PRICE_PANEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace quant {
+
+/// Trading date as days since 1970-01-01 (numpy datetime64[D])
+using PanelDate = std::int64_t;
+
+/// Longest field or symbol name a panel stores (excluding the NUL)
+constexpr std::size_t PANEL_NAME_MAX = 31;
+
+/**
+ * @brief Rows of a panel aligned across symbols, ready for the engines.
+ */
+struct AlignedPanel {
+    std::vector<PanelDate> dates;
+    std::vector<double> values;  // row-major dates x num_symbols
+    std::size_t num_symbols = 0;
+};
+
+/**
+ * @brief Read-only view of a mapped panel file.
+ *
+ * Pointers returned by the accessors stay valid for the lifetime of the
+ * panel. The writer replaces the file by rename, so a mapped panel keeps
+ * seeing the snapshot it opened.
+ */
+class PricePanel {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be mapped
+     * @throws std::invalid_argument if it is not a valid panel
+     */
+    explicit PricePanel(const std::string& path);
+    ~PricePanel();
+
+    PricePanel(const PricePanel&) = delete;
+    PricePanel& operator=(const PricePanel&) = delete;
+    PricePanel(PricePanel&& other) noexcept;
+    PricePanel& operator=(PricePanel&& other) noexcept;
+
+    std::size_t num_dates() const { return num_dates_; }
+    std::size_t num_symbols() const { return symbols_.size(); }
+    std::size_t num_fields() const { return fields_.size(); }
+
+    const std::vector<std::string>& symbols() const { return symbols_; }
+    const std::vector<std::string>& fields() const { return fields_; }
+
+    /// Increasing trading dates (num_dates)
+    const PanelDate* dates() const { return dates_; }
+
+    /// Index of a symbol or field, -1 if absent
+    int symbol_index(const std::string& symbol) const;
+    int field_index(const std::string& field) const;
+
+    /// Series of one field and symbol (num_dates values, NaN where invalid)
+    const double* column(int field, int symbol) const;
+
+    /// Validity bitmap of a symbol (ceil(num_dates / 64) words, LSB first)
+    const std::uint64_t* validity(int symbol) const;
+
+    bool valid(int symbol, std::size_t t) const {
+        return (validity(symbol)[t / 64] >> (t % 64)) & 1u;
+    }
+
+    /// First date index >= date (num_dates if none)
+    std::size_t lower_bound(PanelDate date) const;
+
+    /**
+     * @brief Gather one field of several symbols into a row-major matrix
+     *        over [first, last].
+     *
+     * Dates where none of the symbols has a bar are skipped. Without
+     * forward_fill a row needs every symbol to be valid (an inner join);
+     * with it, a missing bar repeats the symbol's last valid value, and
+     * rows before every symbol has started are dropped.
+     *
+     * @throws std::invalid_argument for an out-of-range field or symbol
+     */
+    AlignedPanel align(
+        int field,
+        const std::vector<int>& symbols,
+        PanelDate first,
+        PanelDate last,
+        bool forward_fill = false
+    ) const;
+
+private:
+    void unmap() noexcept;
+
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* mapping_ = nullptr;
+#endif
+
+    std::size_t num_dates_ = 0;
+    std::size_t column_stride_ = 0;
+    std::size_t validity_words_ = 0;
+    std::vector<std::string> symbols_;
+    std::vector<std::string> fields_;
+    const PanelDate* dates_ = nullptr;
+    const std::uint64_t* validity_ = nullptr;
+    const double* values_ = nullptr;
+};
+
+/**
+ * @brief Write a panel file, replacing path atomically.
+ *
+ * A (symbol, date) entry is valid when every field of it is finite.
+ * Symbols may come in any order; the file stores them sorted.
+ *
+ * @param values Field-major, then symbol-major series:
+ *               values[(f * symbols.size() + s) * dates.size() + t]
+ *
+ * @throws std::invalid_argument for unsorted dates, duplicate or too long
+ *         names, or no fields
+ * @throws std::runtime_error if the file cannot be written
+ */
+void write_price_panel(
+    const std::string& path,
+    const std::vector<PanelDate>& dates,
+    const std::vector<std::string>& symbols,
+    const std::vector<std::string>& fields,
+    const double* values
+);
+
+} // namespace quant
+
+#endif // PRICE_PANEL_H
@@ -0,0 +1,272 @@
+/**
+ * @file process_models.h
+ * @brief Price process policies for simulate<Process, Aggregator>.
+ *
+ * A process policy advances one SIMD tile of paths by one step. It
+ * declares how many normal shocks it consumes per step (NUM_FACTORS) and
+ * how many doubles of per-path state it carries between steps
+ * (NUM_STATES), and provides
+ *
+ *   void initialize(double* state, int lanes) const;
+ *   void step(const double* z, std::size_t factor_stride, double* state,
+ *             double* prices, int lanes) const;
+ *   void step_log(const double* z, std::size_t factor_stride, double* state,
+ *                 double* log_prices, int lanes) const;
+ *
+ * where z[f * factor_stride + lane] is shock f of each lane and state
+ * holds NUM_STATES rows of SIMD_TILE lanes (initialize() sets all of them
+ * at t = 0). Factor 0 comes from the variance-reduction shock generator;
+ * the others are independent pseudo-random normals. step() is inline so
+ * each model compiles into its own loop inside simulate(); the exponential
+ * goes through the per-ISA gbm_step kernel with zero drift and unit
+ * diffusion. step_log() makes the same move on log prices, adding the log
+ * return without any exponential (see SimulationConfig::log_space).
+ */
+
+#ifndef PROCESS_MODELS_H
+#define PROCESS_MODELS_H
+
+#include "monte_carlo.h"
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace quant {
+
+/**
+ * @brief Geometric Brownian motion:
+ *        S(t+dt) = S(t) * exp((mu - sigma^2 / 2) dt + sigma sqrt(dt) Z).
+ */
+class GbmProcess {
+public:
+    static constexpr int NUM_FACTORS = 1;
+    static constexpr int NUM_STATES = 0;
+
+    explicit GbmProcess(const SimulationConfig& config);
+
+    void initialize(double*, int) const {}
+
+    void step(const double* z, std::size_t, double*, double* prices, int lanes) const {
+        kernels_.gbm_step(drift_, diffusion_, z, prices, lanes);
+    }
+
+    void step_log(const double* z, std::size_t, double*, double* log_prices, int lanes) const {
+        for (int i = 0; i < lanes; ++i) {
+            log_prices[i] += drift_ + diffusion_ * z[i];
+        }
+    }
+
+private:
+    const SimdKernels& kernels_;
+    double drift_;
+    double diffusion_;
+};
+
+/**
+ * @brief Heston stochastic variance, full-truncation Euler (see
+ *        HestonParams). State: the variance of each path.
+ */
+class HestonProcess {
+public:
+    static constexpr int NUM_FACTORS = 2;
+    static constexpr int NUM_STATES = 1;
+
+    /// @throws std::invalid_argument for negative variances or rates, or
+    ///         |rho| > 1
+    explicit HestonProcess(const SimulationConfig& config);
+
+    void initialize(double* state, int lanes) const {
+        std::fill(state, state + lanes, v0_);
+    }
+
+    void step(const double* z, std::size_t factor_stride, double* state, double* prices, int lanes) const {
+        alignas(64) double log_step[SIMD_TILE];
+        log_returns(z, factor_stride, state, log_step, lanes);
+        kernels_.gbm_step(0.0, 1.0, log_step, prices, lanes);
+    }
+
+    void step_log(const double* z, std::size_t factor_stride, double* state, double* log_prices, int lanes) const {
+        alignas(64) double log_step[SIMD_TILE];
+        log_returns(z, factor_stride, state, log_step, lanes);
+        for (int i = 0; i < lanes; ++i) {
+            log_prices[i] += log_step[i];
+        }
+    }
+
+private:
+    /// Log return of each lane over the step; advances the variance
+    void log_returns(const double* z, std::size_t factor_stride, double* state, double* log_step, int lanes) const {
+        const double* z_price = z;
+        const double* z_other = z + factor_stride;
+        double* variance = state;
+
+        for (int i = 0; i < lanes; ++i) {
+            const double v = std::max(variance[i], 0.0);
+            const double vol = std::sqrt(v * dt_);
+            const double z_variance = rho_ * z_price[i] + rho_bar_ * z_other[i];
+            log_step[i] = (mu_ - 0.5 * v) * dt_ + vol * z_price[i];
+            variance[i] += kappa_dt_ * (theta_ - v) + xi_ * vol * z_variance;
+        }
+    }
+
+    const SimdKernels& kernels_;
+    double mu_;
+    double dt_;
+    double v0_;
+    double kappa_dt_;
+    double theta_;
+    double xi_;
+    double rho_;
+    double rho_bar_;  // sqrt(1 - rho^2)
+};
+
+/**
+ * @brief Merton jump diffusion (see MertonParams).
+ *
+ * The jump count of a step is read off factor 1 by inversion: with
+ * u = Phi(-z) uniform, N = #{k : u < P(N > k)}, comparing against the
+ * Poisson upper tail so rare counts keep their probability. Factor 2 sizes
+ * the jumps: N * jump_mean + sqrt(N) * jump_std * z.
+ */
+class MertonProcess {
+public:
+    static constexpr int NUM_FACTORS = 3;
+    static constexpr int NUM_STATES = 0;
+
+    /// Largest jump count per step that can be drawn
+    static constexpr int MAX_JUMPS = 16;
+
+    /// @throws std::invalid_argument for a negative intensity or jump_std
+    explicit MertonProcess(const SimulationConfig& config);
+
+    void initialize(double*, int) const {}
+
+    void step(const double* z, std::size_t factor_stride, double*, double* prices, int lanes) const {
+        alignas(64) double log_step[SIMD_TILE];
+        log_returns(z, factor_stride, log_step, lanes);
+        kernels_.gbm_step(0.0, 1.0, log_step, prices, lanes);
+    }
+
+    void step_log(const double* z, std::size_t factor_stride, double*, double* log_prices, int lanes) const {
+        alignas(64) double log_step[SIMD_TILE];
+        log_returns(z, factor_stride, log_step, lanes);
+        for (int i = 0; i < lanes; ++i) {
+            log_prices[i] += log_step[i];
+        }
+    }
+
+private:
+    /// Log return of each lane over the step, jumps included
+    void log_returns(const double* z, std::size_t factor_stride, double* log_step, int lanes) const {
+        const double* z_count = z + factor_stride;
+        const double* z_size = z + 2 * factor_stride;
+
+        for (int i = 0; i < lanes; ++i) {
+            log_step[i] = -z_count[i];
+        }
+        kernels_.normal_cdf(log_step, log_step, lanes);
+
+        for (int i = 0; i < lanes; ++i) {
+            double jumps = 0.0;
+            for (int k = 0; k < num_tails_; ++k) {
+                jumps += log_step[i] < tail_[k] ? 1.0 : 0.0;
+            }
+            log_step[i] = drift_ + diffusion_ * z[i]
+                        + jumps * jump_mean_ + std::sqrt(jumps) * jump_std_ * z_size[i];
+        }
+    }
+
+    const SimdKernels& kernels_;
+    double drift_;
+    double diffusion_;
+    double jump_mean_;
+    double jump_std_;
+
+    /// P(N > k) per step for k < num_tails_ (only tails above 1e-300)
+    double tail_[MAX_JUMPS];
+    int num_tails_ = 0;
+};
+
+/**
+ * @brief GARCH(1,1) per-step variance (see GarchParams). State: the
+ *        conditional variance h of each path's next log return.
+ */
+class GarchProcess {
+public:
+    static constexpr int NUM_FACTORS = 1;
+    static constexpr int NUM_STATES = 1;
+
+    /// @throws std::invalid_argument for negative weights or
+    ///         alpha + beta >= 1
+    explicit GarchProcess(const SimulationConfig& config);
+
+    void initialize(double* state, int lanes) const {
+        std::fill(state, state + lanes, h0_);
+    }
+
+    void step(const double* z, std::size_t, double* state, double* prices, int lanes) const {
+        alignas(64) double log_step[SIMD_TILE];
+        log_returns(z, state, log_step, lanes);
+        kernels_.gbm_step(0.0, 1.0, log_step, prices, lanes);
+    }
+
+    void step_log(const double* z, std::size_t, double* state, double* log_prices, int lanes) const {
+        alignas(64) double log_step[SIMD_TILE];
+        log_returns(z, state, log_step, lanes);
+        for (int i = 0; i < lanes; ++i) {
+            log_prices[i] += log_step[i];
+        }
+    }
+
+private:
+    /// Log return of each lane over the step; advances the variance
+    void log_returns(const double* z, double* state, double* log_step, int lanes) const {
+        double* h = state;
+
+        for (int i = 0; i < lanes; ++i) {
+            const double eps = std::sqrt(h[i]) * z[i];
+            log_step[i] = mu_dt_ - 0.5 * h[i] + eps;
+            h[i] = omega_ + alpha_ * eps * eps + beta_ * h[i];
+        }
+    }
+
+    const SimdKernels& kernels_;
+    double mu_dt_;
+    double h0_;
+    double omega_;
+    double alpha_;
+    double beta_;
+};
+
+/**
+ * @brief Call fn with the process policy selected by config.model.
+ *
+ * Each model instantiates fn separately, so generic code written once
+ * still gets a specialized loop per model.
+ *
+ * @throws std::invalid_argument for invalid model parameters.
+ */
+template <typename Fn>
+void visit_process(const SimulationConfig& config, Fn&& fn) {
+    switch (config.model) {
+    case ProcessModel::Heston:
+        fn(HestonProcess(config));
+        break;
+    case ProcessModel::Merton:
+        fn(MertonProcess(config));
+        break;
+    case ProcessModel::GARCH:
+        fn(GarchProcess(config));
+        break;
+    case ProcessModel::GBM:
+    default:
+        fn(GbmProcess(config));
+        break;
+    }
+}
+
+} // namespace quant
+
+#endif // PROCESS_MODELS_H
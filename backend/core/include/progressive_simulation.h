@@ -0,0 +1,93 @@
+/**
+ * @file progressive_simulation.h
+ * @brief Chunked, cancellable single-asset Monte Carlo with snapshots.
+ *
+ * A long run is split into chunks of paths requested by the caller; after
+ * each chunk an aggregate snapshot of every path done so far can be taken,
+ * so a chart can refine while the run continues, and an abandoned run
+ * stops between blocks of paths.
+ */
+
+#ifndef PROGRESSIVE_SIMULATION_H
+#define PROGRESSIVE_SIMULATION_H
+
+#include "monte_carlo.h"
+#include "path_statistics.h"
+#include "thread_pool.h"
+#include "variance_reduction.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief A Monte Carlo run of config.num_simulations paths, simulated a
+ *        chunk at a time.
+ *
+ * Chunks are consecutive path ranges of one seeded run, so the paths are
+ * exactly those run_monte_carlo(config) would simulate, however the run is
+ * split. Final prices and drawdowns are kept per path (O(num_simulations)
+ * memory), so terminal statistics, tail risk, drawdowns and the standard
+ * error of a snapshot are exact over the completed paths, as is the mean
+ * path. Per-step percentile bands are the path-weighted average of each
+ * chunk's exact bands, which converges to the full-run bands as chunks
+ * grow.
+ *
+ * Paths are always aggregated step by step (config.storage is ignored).
+ * run() and snapshot() must not be called concurrently with each other.
+ */
+class ProgressiveSimulation {
+public:
+    /**
+     * @throws std::invalid_argument for invalid model parameters,
+     *         quantiles, confidence levels or output_stride.
+     */
+    explicit ProgressiveSimulation(const SimulationConfig& config);
+
+    /**
+     * @brief Simulate up to num_paths more paths.
+     *
+     * The chunk is rounded up to whole SIMD tiles (and cut at the total).
+     *
+     * @param num_paths Paths requested
+     * @param cancel    Polled before every block of paths (may be null).
+     *                  A cancelled chunk is discarded.
+     *
+     * @return Paths added (0 when cancelled or already complete)
+     */
+    int run(int num_paths, const CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief Aggregate result over the completed paths.
+     *
+     * @throws std::logic_error if no path has completed yet.
+     */
+    SimulationResult snapshot() const;
+
+    int completed_paths() const { return completed_; }
+    int total_paths() const { return config_.num_simulations; }
+    bool done() const { return completed_ >= config_.num_simulations; }
+
+private:
+    SimulationConfig config_;
+    uint64_t seed_;
+    AggregationOptions options_;
+    ShockGenerator shocks_;
+
+    int completed_ = 0;
+
+    /// Per path, in path order (length = total)
+    std::vector<double> final_prices_;
+    std::vector<double> max_drawdown_;
+
+    /// Path-weighted sums of each chunk's per-step statistics
+    std::vector<double> mean_sum_;
+    std::vector<double> percentile_05_sum_;
+    std::vector<double> percentile_95_sum_;
+    std::vector<double> bands_sum_;
+};
+
+} // namespace quant
+
+#endif // PROGRESSIVE_SIMULATION_H
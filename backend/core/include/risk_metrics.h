@@ -0,0 +1,63 @@
+/**
+ * @file risk_metrics.h
+ * @brief Tail risk statistics of a simulated distribution.
+ *
+ * Value at Risk and expected shortfall are read off a buffer whose tail
+ * order statistics have already been placed by select_order_statistics(),
+ * so every confidence level shares one selection pass and one prefix sum.
+ */
+
+#ifndef RISK_METRICS_H
+#define RISK_METRICS_H
+
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Position of the loss-tail cut-off at a confidence level.
+ *
+ * The (1 - confidence) quantile of an ascending sample of size n, using
+ * the quantile_index() convention.
+ */
+int tail_index(double confidence, int n);
+
+/**
+ * @brief Loss-tail positions for a list of confidence levels.
+ *
+ * @param confidence_levels Levels in (0, 1), any order
+ * @param n                 Sample size
+ *
+ * @return Sorted, de-duplicated positions
+ *
+ * @throws std::invalid_argument if a level lies outside (0, 1).
+ */
+std::vector<int> tail_indices(const std::vector<double>& confidence_levels, int n);
+
+/**
+ * @brief Value at Risk and expected shortfall at each confidence level.
+ *
+ * Losses are measured against reference (e.g. the initial price), so a
+ * positive value is a loss. Expected shortfall at level c is reference
+ * minus the mean of the tail_index(c, n) + 1 lowest values.
+ *
+ * @param values             Sample with every tail_indices() position
+ *                           selected (see select_order_statistics)
+ * @param n                  Sample size
+ * @param reference          Value losses are measured from
+ * @param confidence_levels  Levels in (0, 1), any order
+ * @param value_at_risk      Output, one entry per level
+ * @param expected_shortfall Output, one entry per level
+ */
+void tail_risk(
+    const double* values,
+    int n,
+    double reference,
+    const std::vector<double>& confidence_levels,
+    double* value_at_risk,
+    double* expected_shortfall
+);
+
+} // namespace quant
+
+#endif // RISK_METRICS_H
@@ -0,0 +1,136 @@
+/**
+ * @file rng.h
+ * @brief Counter-based random number generation for parallel simulation.
+ *
+ * Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as
+ * 1, 2, 3") maps a (counter, key) pair to 128 random bits with no hidden
+ * state. Every normal draw is addressed by (seed, path, draw index), so
+ * results do not depend on how paths are split across threads or on the
+ * order in which they are generated.
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace quant {
+
+/**
+ * @brief Philox4x32-10 counter-based generator.
+ */
+struct Philox4x32 {
+    using Block = std::array<uint32_t, 4>;
+
+    static constexpr uint32_t M0 = 0xD2511F53u;
+    static constexpr uint32_t M1 = 0xCD9E8D57u;
+    static constexpr uint32_t W0 = 0x9E3779B9u;
+    static constexpr uint32_t W1 = 0xBB67AE85u;
+
+    /**
+     * @brief Generate 128 random bits for the given counter and key.
+     */
+    static inline Block generate(Block ctr, uint64_t key) {
+        uint32_t k0 = static_cast<uint32_t>(key);
+        uint32_t k1 = static_cast<uint32_t>(key >> 32);
+
+        for (int round = 0; round < 10; ++round) {
+            const uint64_t p0 = static_cast<uint64_t>(M0) * ctr[0];
+            const uint64_t p1 = static_cast<uint64_t>(M1) * ctr[2];
+
+            ctr = {
+                static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ k0,
+                static_cast<uint32_t>(p1),
+                static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ k1,
+                static_cast<uint32_t>(p0)
+            };
+
+            k0 += W0;
+            k1 += W1;
+        }
+        return ctr;
+    }
+};
+
+/**
+ * @brief Map 64 random bits to a double in (0, 1].
+ *
+ * Never returns 0, so the result is safe to pass to std::log.
+ */
+inline double uniform_open_closed(uint64_t bits) {
+    return static_cast<double>((bits >> 11) + 1) * (1.0 / 9007199254740992.0);  // 2^-53
+}
+
+/**
+ * @brief Pair of independent standard normals for one counter value.
+ *
+ * @param key        Generator key (the simulation seed)
+ * @param path       Path index
+ * @param pair_index Index of the pair within the path (draws 2k and 2k+1)
+ * @param stream     Independent sub-stream id (e.g. for a second factor)
+ */
+inline void normal_pair(
+    uint64_t key,
+    uint64_t path,
+    uint32_t pair_index,
+    uint32_t stream,
+    double& z0,
+    double& z1
+) {
+    constexpr double TWO_PI = 6.283185307179586;
+
+    const Philox4x32::Block bits = Philox4x32::generate(
+        {pair_index, stream, static_cast<uint32_t>(path), static_cast<uint32_t>(path >> 32)},
+        key
+    );
+
+    const double u1 = uniform_open_closed((static_cast<uint64_t>(bits[0]) << 32) | bits[1]);
+    const double u2 = uniform_open_closed((static_cast<uint64_t>(bits[2]) << 32) | bits[3]);
+
+    // Box-Muller transform
+    const double r = std::sqrt(-2.0 * std::log(u1));
+    const double theta = TWO_PI * u2;
+    z0 = r * std::cos(theta);
+    z1 = r * std::sin(theta);
+}
+
+/**
+ * @brief Fill out[0..count) with draws first..first+count-1 of a path.
+ *
+ * Draw i of a path always has the same value, whichever block it is
+ * requested in.
+ */
+inline void fill_path_normals(
+    uint64_t key,
+    uint64_t path,
+    int first,
+    int count,
+    uint32_t stream,
+    double* out
+) {
+    int i = 0;
+    double z0, z1;
+
+    // Odd starting draw: use the second half of its pair
+    if ((first & 1) && count > 0) {
+        normal_pair(key, path, static_cast<uint32_t>(first >> 1), stream, z0, z1);
+        out[i++] = z1;
+    }
+
+    for (; i + 1 < count; i += 2) {
+        normal_pair(key, path, static_cast<uint32_t>((first + i) >> 1), stream, z0, z1);
+        out[i] = z0;
+        out[i + 1] = z1;
+    }
+
+    if (i < count) {
+        normal_pair(key, path, static_cast<uint32_t>((first + i) >> 1), stream, z0, z1);
+        out[i] = z0;
+    }
+}
+
+} // namespace quant
+
+#endif // RNG_H
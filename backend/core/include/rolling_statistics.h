@@ -0,0 +1,121 @@
+/**
+ * @file rolling_statistics.h
+ * @brief O(1) rolling mean / standard deviation and live pair signals.
+ *
+ * RollingStatistics keeps the last `window` observations in a ring buffer
+ * and updates the window mean and sum of squared deviations with
+ * Welford's add/remove formulas, so each new bar costs O(1) however long
+ * the history. PairSignal builds the rolling z-score of a pair spread and
+ * the entry/exit state machine of the pairs backtest on top of it.
+ */
+
+#ifndef ROLLING_STATISTICS_H
+#define ROLLING_STATISTICS_H
+
+#include "pairs_backtest.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Mean and sample standard deviation of the last `window` values.
+ *
+ * Matches a rolling_mean / rolling_std (ddof = 1) whose window includes
+ * the current value. The running sums are recomputed from the buffer once
+ * per `window` updates, which bounds rounding drift at O(1) amortized
+ * cost.
+ */
+class RollingStatistics {
+public:
+    /// @throws std::invalid_argument for window < 2
+    explicit RollingStatistics(int window);
+
+    /// Add a value, dropping the oldest once the window is full
+    void push(double value);
+
+    /// Forget every value
+    void reset();
+
+    int window() const { return static_cast<int>(buffer_.size()); }
+    int count() const { return count_; }
+
+    /// True once the window is full
+    bool ready() const { return count_ == window(); }
+
+    double mean() const { return mean_; }
+
+    /// Sample variance (0 with fewer than two values)
+    double variance() const;
+
+    double std_dev() const;
+
+    /// (value - mean) / std_dev, 0 while std_dev is 0
+    double z_score(double value) const;
+
+    /**
+     * @brief z-score of value against the window push(value) would give,
+     *        without changing the state.
+     */
+    double preview_z_score(double value) const;
+
+private:
+    void recompute();
+
+    std::vector<double> buffer_;
+    int head_ = 0;     // slot of the oldest value once full
+    int count_ = 0;
+    int updates_ = 0;  // since the last recompute
+    double mean_ = 0.0;
+    double m2_ = 0.0;  // sum of squared deviations from mean_
+};
+
+/**
+ * @brief Live state of one pair after a bar.
+ */
+struct PairSignalState {
+    double spread = 0.0;   // price_1 - hedge_ratio * price_2
+    double z_score = 0.0;  // rolling z-score (0 until ready)
+    int position = 0;      // -1, 0 or +1 after this bar
+    bool ready = false;    // rolling window full
+};
+
+/**
+ * @brief Rolling spread z-score and signal state machine of one pair,
+ *        updated per bar in O(1).
+ *
+ * Reproduces the series of the pairs backtest: the z-score of a bar uses
+ * the window ending at that bar, and positions follow next_pairs_position
+ * from the first full window on.
+ */
+class PairSignal {
+public:
+    /// @throws std::invalid_argument for window < 2
+    PairSignal(double hedge_ratio, int window, const PairsThresholds& thresholds);
+
+    /// Replay n bars of history (oldest first) to warm up the state
+    void seed(const double* price_1, const double* price_2, std::size_t n);
+
+    /// Commit one bar
+    PairSignalState update(double price_1, double price_2);
+
+    /// The state update(price_1, price_2) would give, without committing
+    /// it (e.g. for intraday ticks of the bar in progress)
+    PairSignalState preview(double price_1, double price_2) const;
+
+    const PairSignalState& state() const { return state_; }
+    double hedge_ratio() const { return hedge_ratio_; }
+    const PairsThresholds& thresholds() const { return thresholds_; }
+    const RollingStatistics& statistics() const { return stats_; }
+
+private:
+    double hedge_ratio_;
+    PairsThresholds thresholds_;
+    RollingStatistics stats_;
+    PairSignalState state_;
+};
+
+} // namespace quant
+
+#endif // ROLLING_STATISTICS_H
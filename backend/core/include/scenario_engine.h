@@ -0,0 +1,104 @@
+/**
+ * @file scenario_engine.h
+ * @brief Spot/vol scenario ladders for a book of options.
+ *
+ * Reprices every position under every (spot shock, vol shock) pair of a
+ * grid and returns price and Black-Scholes Greeks tensors, plus the
+ * quantity-weighted book totals per scenario.
+ */
+
+#ifndef SCENARIO_ENGINE_H
+#define SCENARIO_ENGINE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief One option position of a book.
+ */
+struct OptionPosition {
+    double strike = 0.0;
+    double time_to_expiry = 0.0; // years
+    double volatility = 0.0;     // unshocked implied volatility
+    double quantity = 1.0;       // signed number of contracts
+    bool is_call = true;
+};
+
+/**
+ * @brief Shock axes of a scenario grid.
+ */
+struct ScenarioGrid {
+    /// Relative spot shocks: scenario spot = spot * (1 + shock)
+    std::vector<double> spot_shocks;
+
+    /// Absolute vol shocks: scenario vol = volatility + shock
+    std::vector<double> vol_shocks;
+};
+
+/**
+ * @brief Prices and Greeks over a scenario grid.
+ *
+ * Per-position tensors are row-major [position][spot shock][vol shock]
+ * (size = num_positions * num_spot * num_vol, empty unless requested);
+ * book tensors are [spot shock][vol shock] sums weighted by
+ * OptionPosition::quantity.
+ * Greeks use the units of GreeksResult (vega and rho per 1%, theta per
+ * day). Scenarios with a non-positive shocked spot or vol get expiry
+ * values (intrinsic price against the strike discounted to today when
+ * T > 0, the matching 0/+-1 delta, zero other Greeks).
+ */
+struct ScenarioResult {
+    int num_positions = 0;
+    int num_spot = 0;
+    int num_vol = 0;
+
+    std::vector<double> price;
+    std::vector<double> delta;
+    std::vector<double> gamma;
+    std::vector<double> vega;
+    std::vector<double> theta;
+    std::vector<double> rho;
+
+    std::vector<double> book_price;
+    std::vector<double> book_delta;
+    std::vector<double> book_gamma;
+    std::vector<double> book_vega;
+    std::vector<double> book_theta;
+    std::vector<double> book_rho;
+};
+
+/**
+ * @brief Reprice a book of options across a spot x vol shock grid.
+ *
+ * Terms that do not depend on a shock (sqrt(T), e^(-rT), log K) are
+ * computed once per position, terms that depend only on the vol shock
+ * once per (position, vol), and each spot ladder then goes through the
+ * SIMD Phi/phi kernels in one pass. Fixed-size blocks of positions run in
+ * parallel on the shared ThreadPool, each summing its own book partials;
+ * the partials are then combined in block order, so results do not depend
+ * on the thread count.
+ *
+ * @param positions      Option positions
+ * @param spot           Current (unshocked) spot price
+ * @param risk_free_rate Risk-free interest rate
+ * @param grid           Spot and vol shocks
+ * @param per_position   Also return the per-position tensors (memory is
+ *                       6 * positions * scenarios doubles)
+ * @param num_threads    Worker threads (0 = all cores)
+ *
+ * @return ScenarioResult with per-position and book tensors
+ */
+ScenarioResult run_scenario_grid(
+    const std::vector<OptionPosition>& positions,
+    double spot,
+    double risk_free_rate,
+    const ScenarioGrid& grid,
+    bool per_position = true,
+    int num_threads = 0
+);
+
+} // namespace quant
+
+#endif // SCENARIO_ENGINE_H
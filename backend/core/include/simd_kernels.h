@@ -0,0 +1,94 @@
+/**
+ * @file simd_kernels.h
+ * @brief Runtime-dispatched SIMD kernels for the GBM path generator and
+ *        the pricing engines.
+ *
+ * The kernels are written once as branch-free loops over a tile of paths
+ * ("lanes") or an array and compiled into one object per instruction set (generic,
+ * AVX2, AVX-512, NEON). simd_kernels() picks the widest variant the CPU
+ * supports at first use.
+ */
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstdint>
+
+namespace quant {
+
+/// Paths advanced together by one kernel call
+constexpr int SIMD_TILE = 64;
+
+/**
+ * @brief Table of kernels compiled for one instruction set.
+ */
+struct SimdKernels {
+    /// Instruction set name ("generic", "avx2", "avx512", "neon")
+    const char* isa;
+
+    /**
+     * @brief Standard normals for a tile of consecutive paths.
+     *
+     * Writes draws [2 * first_pair, 2 * (first_pair + num_pairs)) of paths
+     * first_path .. first_path + num_lanes - 1 as z[draw][lane], with a row
+     * stride of SIMD_TILE. Philox4x32-10 counters (see rng.h) feed a
+     * vectorized Box-Muller transform, so each draw depends only on
+     * (key, path, draw, stream).
+     */
+    void (*normals)(
+        uint64_t key,
+        uint64_t first_path,
+        int num_lanes,
+        int first_pair,
+        int num_pairs,
+        uint32_t stream,
+        double* z
+    );
+
+    /**
+     * @brief One GBM step across lanes:
+     *        prices[i] *= exp(drift + diffusion * z[i]) for i < n.
+     */
+    void (*gbm_step)(double drift, double diffusion, const double* z, double* prices, int n);
+
+    /**
+     * @brief One correlated log-normal step of a multi-asset tile.
+     *
+     * For each asset a: levels[a][i] *= exp(drift[a] + sum_{b <= a}
+     * factor[a][b] * z[b][i]); then values[i] = sum_a holdings[a] *
+     * levels[a][i], for lanes i < n. factor is the row-major lower Cholesky
+     * factor, z has row stride z_stride and levels row stride SIMD_TILE.
+     */
+    void (*portfolio_step)(
+        const double* factor,
+        const double* drift,
+        const double* holdings,
+        int num_assets,
+        const double* z,
+        int z_stride,
+        double* levels,
+        double* values,
+        int n
+    );
+
+    /// @name Array variants of fast_math.h (same accuracy): out[i] = f(x[i])
+    /// for i < n. out may alias x.
+    /// @{
+    void (*exp)(const double* x, double* out, int n);
+    void (*log)(const double* x, double* out, int n);
+    void (*normal_pdf)(const double* x, double* out, int n);
+    void (*normal_cdf)(const double* x, double* out, int n);
+    /// @}
+};
+
+/**
+ * @brief Kernels for the widest instruction set available at runtime.
+ *
+ * The STRATA_SIMD environment variable ("generic", "avx2", "avx512",
+ * "neon") overrides the choice if that variant is built and supported.
+ */
+const SimdKernels& simd_kernels();
+
+} // namespace quant
+
+#endif // SIMD_KERNELS_H
@@ -0,0 +1,155 @@
+/**
+ * @file simulation_workspace.h
+ * @brief Reusable arena for the scratch buffers of repeated engine runs.
+ *
+ * A run takes 64-byte aligned blocks from one contiguous buffer by bumping
+ * an offset and gives them all back at once when it ends. A run that needs
+ * more than the buffer holds gets the rest from overflow blocks, and the
+ * next run first regrows the buffer to what the last one used, so repeated
+ * runs of the same shape allocate nothing once warm.
+ *
+ * Every thread has its own workspace (SimulationWorkspace::local()); a
+ * caller may also keep one and pass it to each run.
+ */
+
+#ifndef SIMULATION_WORKSPACE_H
+#define SIMULATION_WORKSPACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace quant {
+
+/// Alignment of every workspace block (one cache line)
+constexpr std::size_t WORKSPACE_ALIGNMENT = 64;
+
+/// Buffer size a workspace keeps between runs unless told otherwise
+constexpr std::size_t DEFAULT_WORKSPACE_RETAIN_BYTES = std::size_t(256) << 20;
+
+/**
+ * @brief Bump allocator over one aligned buffer, reused run after run.
+ *
+ * Blocks are only valid during the run that took them (see Lease). Blocks
+ * are taken on the thread driving the run, before its parallel sections;
+ * workers only write into them. One run at a time per workspace.
+ */
+class SimulationWorkspace {
+public:
+    /**
+     * @param retain_bytes Largest buffer kept after a run (larger ones are
+     *                     freed when the run ends)
+     */
+    explicit SimulationWorkspace(std::size_t retain_bytes = DEFAULT_WORKSPACE_RETAIN_BYTES);
+    ~SimulationWorkspace();
+
+    SimulationWorkspace(const SimulationWorkspace&) = delete;
+    SimulationWorkspace& operator=(const SimulationWorkspace&) = delete;
+
+    /// The calling thread's workspace
+    static SimulationWorkspace& local();
+
+    /**
+     * @brief Scope of one run on a workspace.
+     *
+     * @throws std::runtime_error if the workspace is already in a run
+     */
+    class Lease {
+    public:
+        explicit Lease(SimulationWorkspace& workspace);
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+    private:
+        SimulationWorkspace& workspace_;
+    };
+
+    /**
+     * @brief Uninitialized, aligned block of count T for the current run.
+     */
+    template <typename T>
+    T* allocate(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "workspace blocks are never destroyed");
+        return static_cast<T*>(allocate_bytes(count * sizeof(T)));
+    }
+
+    /// Bytes of the contiguous buffer
+    std::size_t capacity() const { return capacity_; }
+
+    /// Most bytes any run has taken
+    std::size_t high_water() const { return high_water_; }
+
+    /// Buffers of the last run that did not fit (0 when warm)
+    std::size_t overflow_allocations() const { return last_overflow_count_; }
+
+    std::size_t retain_bytes() const { return retain_bytes_; }
+    void set_retain_bytes(std::size_t bytes) { retain_bytes_ = bytes; }
+
+    bool in_use() const { return in_use_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Grow the buffer to at least bytes now.
+     *
+     * @throws std::runtime_error during a run
+     */
+    void reserve(std::size_t bytes);
+
+    /**
+     * @brief Free the buffer.
+     *
+     * @throws std::runtime_error during a run
+     */
+    void release();
+
+private:
+    struct AlignedDelete {
+        void operator()(void* p) const;
+    };
+    using Block = std::unique_ptr<void, AlignedDelete>;
+
+    void begin();
+    void end() noexcept;
+    void* allocate_bytes(std::size_t bytes);
+    void resize_buffer(std::size_t bytes);
+
+    Block buffer_;
+    std::size_t capacity_ = 0;
+    std::size_t offset_ = 0;
+    std::size_t retain_bytes_;
+
+    /// Blocks that did not fit in the buffer this run, and their bytes
+    std::vector<Block> overflow_;
+    std::size_t overflow_bytes_ = 0;
+
+    std::size_t last_run_bytes_ = 0;
+    std::size_t last_overflow_count_ = 0;
+    std::size_t high_water_ = 0;
+    std::atomic<bool> in_use_{false};
+};
+
+/**
+ * @brief A leased workspace for one run: the one given, else the calling
+ *        thread's, else (when that one is already in a run further up the
+ *        stack) a private one.
+ */
+class WorkspaceScope {
+public:
+    explicit WorkspaceScope(SimulationWorkspace* workspace);
+
+    SimulationWorkspace& workspace() { return workspace_; }
+
+private:
+    static SimulationWorkspace& select(SimulationWorkspace* workspace, std::unique_ptr<SimulationWorkspace>& own);
+
+    std::unique_ptr<SimulationWorkspace> own_;
+    SimulationWorkspace& workspace_;
+    SimulationWorkspace::Lease lease_;
+};
+
+} // namespace quant
+
+#endif // SIMULATION_WORKSPACE_H
@@ -0,0 +1,35 @@
+/**
+ * @file sobol.h
+ * @brief Sobol low-discrepancy sequence.
+ *
+ * 32-bit Sobol points with the Joe-Kuo (2008) direction numbers for the
+ * first SOBOL_MAX_DIMS dimensions. Points are computed directly from their
+ * index, so any path can be generated independently of the others.
+ */
+
+#ifndef SOBOL_H
+#define SOBOL_H
+
+#include <cstdint>
+
+namespace quant {
+
+/// Dimensions with direction numbers
+constexpr int SOBOL_MAX_DIMS = 16;
+
+/**
+ * @brief Coordinate dim of Sobol point index, as a 32-bit binary fraction.
+ *
+ * The coordinate in [0, 1) is the result times 2^-32. XOR-ing the result
+ * with a random 32-bit shift per dimension (a random digital shift) keeps
+ * the sequence's equidistribution and makes each shifted copy an unbiased
+ * estimator.
+ *
+ * @param index Point index (0-based)
+ * @param dim   Dimension in [0, SOBOL_MAX_DIMS)
+ */
+uint32_t sobol_coordinate(uint32_t index, int dim);
+
+} // namespace quant
+
+#endif // SOBOL_H
@@ -0,0 +1,171 @@
+/**
+ * @file thread_pool.h
+ * @brief Persistent work-stealing worker pool used by the parallel engines.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace quant {
+
+/**
+ * @brief Scheduling class of pool work.
+ *
+ * Idle workers always take queued Interactive work before Batch work.
+ */
+enum class TaskPriority {
+    Interactive = 0,  ///< Latency-sensitive request servicing
+    Batch = 1         ///< Throughput work (bulk runs, exports, screens)
+};
+
+constexpr std::size_t NUM_TASK_PRIORITIES = 2;
+
+/**
+ * @brief Fixed-size pool of work-stealing worker threads.
+ *
+ * Every worker owns a deque per priority. Work submitted from a worker goes
+ * to the back of its own deque and is popped from there (LIFO, cache-warm);
+ * work from other threads goes to a shared injector queue. An idle worker
+ * takes, for each priority in turn, from its own deque, the injector, then
+ * the front of another worker's deque.
+ *
+ * Work is submitted as a parallel_for over task indices or as a single
+ * job. The calling thread always takes part in its own parallel_for, so
+ * nested calls (e.g. from inside a worker) cannot deadlock. The helpers of
+ * a parallel_for are queued at the calling thread's priority: the priority
+ * of the job it is running, else that of its PriorityScope.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param num_workers Number of background workers (0 = one per physical core)
+     */
+    explicit ThreadPool(unsigned num_workers = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Maximum parallelism of a parallel_for: the calling thread plus
+    /// helpers, one thread per worker in all
+    unsigned concurrency() const { return num_workers(); }
+
+    /// Number of background workers
+    unsigned num_workers() const { return static_cast<unsigned>(workers_.size()); }
+
+    /**
+     * @brief Run fn(i) for every i in [0, num_tasks) and wait for completion.
+     *
+     * Tasks are claimed dynamically, so fn must not depend on which thread
+     * runs a given index.
+     *
+     * @param num_tasks   Number of task indices
+     * @param max_threads Upper bound on threads used (0 = concurrency())
+     * @param fn          Task body
+     *
+     * @throws Rethrows the first exception thrown by any task.
+     */
+    void parallel_for(
+        std::size_t num_tasks,
+        unsigned max_threads,
+        const std::function<void(std::size_t)>& fn
+    );
+
+    /**
+     * @brief Queue job to run once on a worker, without waiting for it.
+     *
+     * job must not throw; the pool has no one to report an exception to.
+     */
+    void submit(std::function<void()> job, TaskPriority priority);
+
+    /// Process-wide pool shared by all engines
+    static ThreadPool& instance();
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskPriority priority;
+    };
+
+    /// Deques of one worker (or of the injector), one per priority
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks[NUM_TASK_PRIORITIES];
+    };
+
+    void worker_loop(std::size_t index);
+    void push(Task task);
+    bool try_pop(std::size_t index, Task& task);
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    TaskQueue injector_;
+
+    /// Queued tasks of every queue; workers sleep while it is 0
+    std::atomic<std::size_t> pending_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stopping_ = false;
+};
+
+/**
+ * @brief Set the priority of pool work started by the current thread for
+ *        the lifetime of the scope.
+ */
+class PriorityScope {
+public:
+    explicit PriorityScope(TaskPriority priority);
+    ~PriorityScope();
+
+    PriorityScope(const PriorityScope&) = delete;
+    PriorityScope& operator=(const PriorityScope&) = delete;
+
+    /// Priority of the current thread (Interactive unless a scope is open)
+    static TaskPriority current();
+
+private:
+    TaskPriority previous_;
+};
+
+/**
+ * @brief Cooperative cancellation flag shared between a caller and a
+ *        running engine.
+ *
+ * Engines poll it between units of work (e.g. blocks of paths) and stop
+ * early once it is set; cancel() may be called from any thread.
+ */
+class CancellationToken {
+public:
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled_{false};
+};
+
+/**
+ * @brief Number of physical cores (hyper-threads of a core count once).
+ *
+ * Read from the Linux CPU topology; elsewhere, or when it is unreadable,
+ * falls back to std::thread::hardware_concurrency(). Always at least 1.
+ */
+unsigned physical_core_count();
+
+/**
+ * @brief Resolve a user-supplied thread count (0 = all cores).
+ */
+unsigned resolve_num_threads(int num_threads);
+
+} // namespace quant
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,131 @@
+/**
+ * @file variance_reduction.h
+ * @brief Shock generation and mean estimators for the variance-reduction
+ *        modes of the single-asset engine (see VarianceReduction).
+ */
+
+#ifndef VARIANCE_REDUCTION_H
+#define VARIANCE_REDUCTION_H
+
+#include "monte_carlo.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace quant {
+
+/// Randomized Sobol replicates (independent digital shifts)
+constexpr int SOBOL_REPLICATES = 16;
+
+/**
+ * @brief Brownian bridge over a coarse grid of knots.
+ *
+ * Knot m sits at step knot_step[m]; the last knot is the final step. The
+ * knots are built in breadth-first order (terminal value first, then
+ * midpoints), so the leading normals fix the coarse shape of the path.
+ * Time is measured in steps, so W has unit variance per step.
+ */
+struct BrownianBridge {
+    int num_knots = 0;
+
+    /// Step of each knot, ascending (length = num_knots)
+    std::vector<int> knot_step;
+
+    /// Construction order: knot built by normal i, and the knots it is
+    /// bridged between (-1 = W(0) = 0 on the left, none on the right)
+    std::vector<int> node;
+    std::vector<int> left;
+    std::vector<int> right;
+
+    /// Conditional mean weights and standard deviation of each node
+    std::vector<double> left_weight;
+    std::vector<double> right_weight;
+    std::vector<double> stddev;
+
+    /// Per step (index 1 .. num_steps): the next knot at or after the step
+    std::vector<int> next_knot;
+};
+
+/**
+ * @brief Bridge on min(num_steps, max_knots) knots spread evenly over
+ *        num_steps steps.
+ */
+BrownianBridge make_brownian_bridge(int num_steps, int max_knots);
+
+/**
+ * @brief Final-price mean and its standard error.
+ */
+struct MeanEstimate {
+    double mean = 0.0;
+    double standard_error = 0.0;
+};
+
+/**
+ * @brief Store an estimate in a result: standard_error always, and the
+ *        mean under ControlVariate (the only mode whose mean differs from
+ *        the plain average).
+ */
+void apply_mean_estimate(const MeanEstimate& estimate, VarianceReduction mode, SimulationResult& result);
+
+/**
+ * @brief Normal shocks of every path under one VarianceReduction mode.
+ *
+ * Holds the per-path state a mode carries across blocks of steps (Sobol
+ * knots and bridge position, control-variate shock sums), so tiles can be
+ * generated block by block in any order. generate() may run concurrently
+ * on disjoint tiles.
+ */
+class ShockGenerator {
+public:
+    ShockGenerator(VarianceReduction mode, uint64_t key, int num_simulations, int num_steps);
+
+    /**
+     * @brief Shocks of steps first .. first + count - 1 for one tile.
+     *
+     * Blocks of a path must be generated in step order. Generating from
+     * first = 1 again restarts the path.
+     *
+     * @param sim0  First path of the tile
+     * @param lanes Paths in the tile (<= SIMD_TILE)
+     * @param first First step (1-based); first - 1 must be even
+     * @param count Steps to produce (<= 8)
+     * @param z     z[step][lane] output, row stride SIMD_TILE
+     */
+    void generate(int sim0, int lanes, int first, int count, double* z);
+
+    /**
+     * @brief Mean of the final prices and its standard error under the
+     *        mode's estimator.
+     *
+     * @param final_prices Final price of paths 0 .. n - 1, in path order
+     *                     (a prefix of the run is allowed)
+     */
+    MeanEstimate estimate_mean(const double* final_prices, int n) const;
+
+    MeanEstimate estimate_mean(const std::vector<double>& final_prices) const {
+        return estimate_mean(final_prices.data(), static_cast<int>(final_prices.size()));
+    }
+
+private:
+    void sobol_knots(int sim0, int lanes);
+
+    VarianceReduction mode_;
+    uint64_t key_;
+    BrownianBridge bridge_;
+
+    /// Sobol: digital shift per [replicate][knot]
+    std::vector<uint32_t> shifts_;
+
+    /// Sobol: W at each knot, [path][knot]
+    std::vector<double> knots_;
+
+    /// Sobol: W at the last generated step of each path
+    std::vector<double> brownian_;
+
+    /// ControlVariate: sum of each path's shocks so far
+    std::vector<double> shock_sum_;
+};
+
+} // namespace quant
+
+#endif // VARIANCE_REDUCTION_H
@@ -0,0 +1,425 @@
+/**
+ * @file american_option.cpp
+ * @brief Implementation of the Longstaff-Schwartz American option pricer.
+ */
+
+#include "american_option.h"
+#include "path_matrix.h"
+#include "path_simulation.h"
+#include "process_models.h"
+#include "simulation_workspace.h"
+#include "thread_pool.h"
+#include "variance_reduction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+
+namespace {
+
+/// Regression columns: basis terms 1, x .. x^degree, then the response
+constexpr int MAX_COLUMNS = MAX_BASIS_DEGREE + 2;
+
+/// Pivots below this fraction of the largest one count as zero
+constexpr double RANK_TOLERANCE = 1e-12;
+
+/**
+ * @brief Aggregator keeping every path's price at every exercise date.
+ */
+class ExerciseDatePrices {
+public:
+    explicit ExerciseDatePrices(PathMatrix& prices) : prices_(prices) {}
+
+    int steps_per_pass() const { return prices_.rows() - 1; }
+
+    bool records(int) const { return true; }
+
+    void begin(double initial_price) {
+        std::fill(prices_.row(0), prices_.row(0) + prices_.cols(), initial_price);
+    }
+
+    void record(int step, int path, const double* prices, int lanes) {
+        std::copy(prices, prices + lanes, prices_.row(step) + path);
+    }
+
+    void end_pass(int, int) {}
+
+    void finish() {}
+
+private:
+    PathMatrix& prices_;
+};
+
+/**
+ * @brief Least-squares fit of y on the basis columns, kept as the upper
+ *        triangular R of [X | y].
+ *
+ * A block of rows is factored by Householder reflections (column dot
+ * products the compiler vectorizes); R factors of disjoint row sets are
+ * combined with merge(), by Givens rotations, so blocks of paths are
+ * factored in parallel and reduced in block order.
+ */
+class LeastSquares {
+public:
+    explicit LeastSquares(int columns = 0) : columns_(columns) {}
+
+    /**
+     * @brief Set R to the factor of an m-row block.
+     *
+     * @param a Column c of the block is a[c] .. a[c] + m - 1; overwritten
+     */
+    void factor(double* const* a, int m) {
+        for (int k = 0; k < columns_ && k < m; ++k) {
+            double* v = a[k] + k;
+            const int len = m - k;
+
+            double norm2 = 0.0;
+            for (int i = 0; i < len; ++i) {
+                norm2 += v[i] * v[i];
+            }
+            if (norm2 == 0.0) {
+                continue;
+            }
+
+            // Reflect column k onto alpha e_k; v = x - alpha e_k
+            const double alpha = v[0] > 0.0 ? -std::sqrt(norm2) : std::sqrt(norm2);
+            const double head = v[0];
+            v[0] = head - alpha;
+            const double scale = 1.0 / (norm2 - head * alpha);  // 2 / |v|^2
+            r_[k][k] = alpha;
+
+            for (int j = k + 1; j < columns_; ++j) {
+                double* col = a[j] + k;
+                double dot = 0.0;
+                for (int i = 0; i < len; ++i) {
+                    dot += v[i] * col[i];
+                }
+                dot *= scale;
+                for (int i = 0; i < len; ++i) {
+                    col[i] -= dot * v[i];
+                }
+                r_[k][j] = col[0];
+            }
+        }
+    }
+
+    /// Rotate row (columns_ values, overwritten) into R
+    void add_row(double* row) {
+        for (int k = 0; k < columns_; ++k) {
+            if (row[k] == 0.0) {
+                continue;
+            }
+            const double pivot = std::sqrt(r_[k][k] * r_[k][k] + row[k] * row[k]);
+            const double c = r_[k][k] / pivot;
+            const double s = row[k] / pivot;
+            r_[k][k] = pivot;
+            for (int j = k + 1; j < columns_; ++j) {
+                const double top = r_[k][j];
+                r_[k][j] = c * top + s * row[j];
+                row[j] = c * row[j] - s * top;
+            }
+        }
+    }
+
+    /// Fold in the rows of another fit over the same columns
+    void merge(const LeastSquares& other) {
+        for (int i = 0; i < columns_; ++i) {
+            double row[MAX_COLUMNS];
+            std::copy(other.r_[i], other.r_[i] + columns_, row);
+            add_row(row);
+        }
+    }
+
+    /**
+     * @brief Coefficients of the basis columns; columns with a vanishing
+     *        pivot (too few or collinear rows) get 0.
+     */
+    void solve(double* beta) const {
+        const int p = columns_ - 1;
+        double largest = 0.0;
+        for (int k = 0; k < p; ++k) {
+            largest = std::max(largest, std::fabs(r_[k][k]));
+        }
+        for (int k = p - 1; k >= 0; --k) {
+            double sum = r_[k][p];
+            for (int j = k + 1; j < p; ++j) {
+                sum -= r_[k][j] * beta[j];
+            }
+            beta[k] = std::fabs(r_[k][k]) > RANK_TOLERANCE * largest ? sum / r_[k][k] : 0.0;
+        }
+    }
+
+private:
+    int columns_;
+    double r_[MAX_COLUMNS][MAX_COLUMNS] = {};
+};
+
+struct OptionInputs {
+    double strike;
+    double time_to_expiry;
+    double spot;
+    double rate;
+    double volatility;
+    double dividend_yield;
+    bool is_call;
+};
+
+struct OptionValue {
+    double price = 0.0;
+    double standard_error = 0.0;
+    double delta = 0.0;
+    double gamma = 0.0;
+    double vega = 0.0;
+    double theta = 0.0;
+    double rho = 0.0;
+};
+
+/// Pathwise sums of one block of paths toward the Greeks
+struct GreekSums {
+    double delta = 0.0;
+    double gamma = 0.0;
+    double vega = 0.0;
+    double rho = 0.0;
+};
+
+OptionValue price_option(const OptionInputs& o, const LsmConfig& config, uint64_t key, SimulationWorkspace* workspace) {
+    const double sign = o.is_call ? 1.0 : -1.0;
+    auto payoff = [&](double s) { return std::max(sign * (s - o.strike), 0.0); };
+
+    OptionValue value;
+    if (o.time_to_expiry <= 0.0 || o.volatility <= 0.0 || o.strike <= 0.0 || o.spot <= 0.0) {
+        value.price = payoff(o.spot);
+        value.delta = o.is_call ? (o.spot > o.strike ? 1.0 : 0.0) : (o.spot < o.strike ? -1.0 : 0.0);
+        return value;
+    }
+
+    const int num_paths = config.num_simulations;
+    const int num_dates = config.exercise_dates;
+    const int columns = config.basis_degree + 2;
+    const double dt = o.time_to_expiry / num_dates;
+    const double drift = o.rate - o.dividend_yield;
+    const unsigned threads = resolve_num_threads(config.num_threads);
+    const std::size_t num_blocks = static_cast<std::size_t>((num_paths + PATH_BLOCK - 1) / PATH_BLOCK);
+
+    // Risk-neutral GBM sampled at the exercise dates
+    SimulationConfig sim;
+    sim.s0 = o.spot;
+    sim.mu = drift;
+    sim.sigma = o.volatility;
+    sim.dt = dt;
+    sim.num_steps = num_dates;
+    sim.num_simulations = num_paths;
+    sim.num_threads = config.num_threads;
+    sim.variance_reduction = config.variance_reduction;
+
+    WorkspaceScope scope(workspace);
+    SimulationWorkspace& arena = scope.workspace();
+    PathMatrix prices(arena, num_dates + 1, num_paths);
+    double* cash = arena.allocate<double>(num_paths);
+    double* discounted = arena.allocate<double>(num_paths);
+    int* exercise = arena.allocate<int>(num_paths);
+
+    ShockGenerator shocks(config.variance_reduction, key, num_paths, num_dates);
+    ExerciseDatePrices recorder(prices);
+    // cash and discounted stand in for the final prices and drawdowns
+    simulate_paths(sim, GbmProcess(sim), key, shocks, recorder, arena, 0, num_paths, nullptr, cash,
+                   discounted);
+
+    // discount[k]: value now of a unit paid k dates later
+    std::vector<double> discount(num_dates + 1);
+    for (int k = 0; k <= num_dates; ++k) {
+        discount[k] = std::exp(-o.rate * dt * k);
+    }
+
+    const double* final_row = prices.row(num_dates);
+    for (int i = 0; i < num_paths; ++i) {
+        cash[i] = payoff(final_row[i]);
+        exercise[i] = num_dates;
+    }
+
+    // Backward induction: regress the discounted future cash flow of the
+    // in-the-money paths on powers of S/K, exercise where intrinsic wins
+    // Regression rows of each block, packed column by column: row c of
+    // design holds column c for the in-the-money paths of every block
+    PathMatrix design(arena, columns, num_paths);
+    std::vector<LeastSquares> fits(num_blocks);
+    for (int date = num_dates - 1; date >= 1; --date) {
+        const double* row = prices.row(date);
+
+        ThreadPool::instance().parallel_for(num_blocks, threads, [&](std::size_t block) {
+            const int begin = static_cast<int>(block) * PATH_BLOCK;
+            const int end = std::min(begin + PATH_BLOCK, num_paths);
+            double* a[MAX_COLUMNS];
+            for (int c = 0; c < columns; ++c) {
+                a[c] = design.row(c) + begin;
+            }
+
+            int m = 0;
+            for (int i = begin; i < end; ++i) {
+                if (payoff(row[i]) <= 0.0) {
+                    continue;
+                }
+                const double x = row[i] / o.strike;
+                a[0][m] = 1.0;
+                for (int k = 1; k < columns - 1; ++k) {
+                    a[k][m] = a[k - 1][m] * x;
+                }
+                a[columns - 1][m] = cash[i] * discount[exercise[i] - date];
+                ++m;
+            }
+
+            LeastSquares fit(columns);
+            fit.factor(a, m);
+            fits[block] = fit;
+        });
+
+        LeastSquares fit(columns);
+        for (const LeastSquares& part : fits) {
+            fit.merge(part);
+        }
+        double beta[MAX_COLUMNS] = {};
+        fit.solve(beta);
+
+        ThreadPool::instance().parallel_for(num_blocks, threads, [&](std::size_t block) {
+            const int begin = static_cast<int>(block) * PATH_BLOCK;
+            const int end = std::min(begin + PATH_BLOCK, num_paths);
+            for (int i = begin; i < end; ++i) {
+                const double intrinsic = payoff(row[i]);
+                if (intrinsic <= 0.0) {
+                    continue;
+                }
+                const double x = row[i] / o.strike;
+                double continuation = 0.0;
+                for (int k = columns - 2; k >= 0; --k) {
+                    continuation = continuation * x + beta[k];
+                }
+                if (intrinsic > continuation) {
+                    cash[i] = intrinsic;
+                    exercise[i] = date;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < num_paths; ++i) {
+        discounted[i] = cash[i] * discount[exercise[i]];
+    }
+    const MeanEstimate estimate = shocks.estimate_mean(discounted, num_paths);
+
+    // Exercising now beats holding on
+    const double intrinsic = payoff(o.spot);
+    if (intrinsic > estimate.mean) {
+        value.price = intrinsic;
+        value.delta = sign;
+        return value;
+    }
+
+    // Greeks with each path's exercise date held fixed. Along a path,
+    // S(t) = S0 exp((r - q - sigma^2/2) t + sigma W(t)), so
+    // dS/dS0 = S/S0, dS/dsigma = S (W - sigma t) and dS/dr = S t; gamma
+    // weights the pathwise delta by the score of the first step,
+    // Z1 / (S0 sigma sqrt(dt)), less delta / S0.
+    const double log_drift = drift - 0.5 * o.volatility * o.volatility;
+    const double first_step_scale = 1.0 / (o.spot * o.volatility * std::sqrt(dt));
+    const double* first_row = prices.row(1);
+
+    std::vector<GreekSums> sums(num_blocks);
+    ThreadPool::instance().parallel_for(num_blocks, threads, [&](std::size_t block) {
+        GreekSums s;
+        const int begin = static_cast<int>(block) * PATH_BLOCK;
+        const int end = std::min(begin + PATH_BLOCK, num_paths);
+        for (int i = begin; i < end; ++i) {
+            const int date = exercise[i];
+            const double t = date * dt;
+            const double price = prices.row(date)[i];
+            const double in_money = cash[i] > 0.0 ? sign * discount[date] * price : 0.0;
+
+            const double delta = in_money / o.spot;
+            const double w = (std::log(price / o.spot) - log_drift * t) / o.volatility;
+            const double z1 = (std::log(first_row[i] / o.spot) - log_drift * dt) / (o.volatility * std::sqrt(dt));
+
+            s.delta += delta;
+            s.gamma += delta * (z1 * first_step_scale - 1.0 / o.spot);
+            s.vega += in_money * (w - o.volatility * t);
+            s.rho += -t * discounted[i] + in_money * t;
+        }
+        sums[block] = s;
+    });
+
+    GreekSums total;
+    for (const GreekSums& s : sums) {
+        total.delta += s.delta;
+        total.gamma += s.gamma;
+        total.vega += s.vega;
+        total.rho += s.rho;
+    }
+
+    value.price = estimate.mean;
+    value.standard_error = estimate.standard_error;
+    value.delta = total.delta / num_paths;
+    value.gamma = total.gamma / num_paths;
+    // Scaled by 0.01 per 1% shift, as in calculate_greeks
+    value.vega = total.vega / num_paths * 0.01;
+    value.rho = total.rho / num_paths * 0.01;
+    // V_t = rV - (r - q) S V_S - sigma^2 S^2 V_SS / 2, per calendar day
+    value.theta = (o.rate * value.price - drift * o.spot * value.delta
+                   - 0.5 * o.volatility * o.volatility * o.spot * o.spot * value.gamma) / 365.0;
+    return value;
+}
+
+} // namespace
+
+AmericanOptionBatch price_american_batch(
+    const double* strike,
+    const double* time_to_expiry,
+    const double* spot,
+    const double* risk_free_rate,
+    const double* volatility,
+    const double* dividend_yield,
+    const bool* is_call,
+    std::size_t n,
+    const LsmConfig& config,
+    SimulationWorkspace* workspace
+) {
+    if (config.num_simulations < 2) {
+        throw std::invalid_argument("num_simulations must be at least 2");
+    }
+    if (config.exercise_dates < 1) {
+        throw std::invalid_argument("exercise_dates must be at least 1");
+    }
+    if (config.basis_degree < 1 || config.basis_degree > MAX_BASIS_DEGREE) {
+        throw std::invalid_argument("basis_degree must be between 1 and " + std::to_string(MAX_BASIS_DEGREE));
+    }
+
+    AmericanOptionBatch out;
+    out.price.resize(n);
+    out.standard_error.resize(n);
+    out.delta.resize(n);
+    out.gamma.resize(n);
+    out.vega.resize(n);
+    out.theta.resize(n);
+    out.rho.resize(n);
+
+    // One key for the chain: common random numbers across options
+    const uint64_t key = resolve_seed(config.seed);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const OptionInputs option = {strike[i], time_to_expiry[i], spot[i], risk_free_rate[i],
+                                     volatility[i], dividend_yield[i], is_call[i]};
+        const OptionValue value = price_option(option, config, key, workspace);
+        out.price[i] = value.price;
+        out.standard_error[i] = value.standard_error;
+        out.delta[i] = value.delta;
+        out.gamma[i] = value.gamma;
+        out.vega[i] = value.vega;
+        out.theta[i] = value.theta;
+        out.rho[i] = value.rho;
+    }
+
+    return out;
+}
+
+} // namespace quant
@@ -0,0 +1,454 @@
+/**
+ * @file cointegration.cpp
+ * @brief Implementation of the all-pairs cointegration screen.
+ */
+
+#include "cointegration.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+/// Candidate pairs per parallel task
+constexpr std::size_t PAIR_BLOCK = 32;
+
+constexpr std::size_t MIN_OBSERVATIONS = 20;
+
+/// Half-life reported for spreads that do not revert
+constexpr double NOT_MEAN_REVERTING = 9999.0;
+
+// MacKinnon (1994) response surface, constant term, N = 2 variables
+constexpr double TAU_MAX = 0.92;
+constexpr double TAU_MIN = -18.86;
+constexpr double TAU_STAR = -2.62;
+constexpr double TAU_SMALL_P[3] = {2.92, 1.5012, 0.039796};
+constexpr double TAU_LARGE_P[4] = {2.1945, 0.64695, -0.29198, -0.042377};
+
+/**
+ * @brief In-place Cholesky factor (lower triangle) of the leading m x m
+ *        block of a symmetric matrix with row stride lda.
+ *
+ * @return false if the block is not positive definite
+ */
+bool cholesky(double* a, int m, int lda) {
+    for (int j = 0; j < m; ++j) {
+        double d = a[j * lda + j];
+        for (int k = 0; k < j; ++k) {
+            d -= a[j * lda + k] * a[j * lda + k];
+        }
+        if (d <= 0.0) {
+            return false;
+        }
+        d = std::sqrt(d);
+        a[j * lda + j] = d;
+        for (int i = j + 1; i < m; ++i) {
+            double s = a[i * lda + j];
+            for (int k = 0; k < j; ++k) {
+                s -= a[i * lda + k] * a[j * lda + k];
+            }
+            a[i * lda + j] = s / d;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Solve L L' x = b in place with a factor from cholesky().
+ */
+void cholesky_solve(const double* l, int m, int lda, double* b) {
+    for (int i = 0; i < m; ++i) {
+        double s = b[i];
+        for (int k = 0; k < i; ++k) {
+            s -= l[i * lda + k] * b[k];
+        }
+        b[i] = s / l[i * lda + i];
+    }
+    for (int i = m - 1; i >= 0; --i) {
+        double s = b[i];
+        for (int k = i + 1; k < m; ++k) {
+            s -= l[k * lda + i] * b[k];
+        }
+        b[i] = s / l[i * lda + i];
+    }
+}
+
+/**
+ * @brief Lag sums from which the normal equations of any ADF regression
+ *        of one spread follow in O(lags^2).
+ *
+ * With d[t] = e[t+1] - e[t], every Gram entry of the regression
+ * d[t] ~ e[t] + d[t-1] + ... + d[t-lags] over t = first .. n - 2 is a
+ * window sum of e[s]^2, of e[s + l] d[s] or of d[s] d[s + k] that misses
+ * at most max_lag + 1 terms at either end of the full sum. Each series is
+ * therefore kept as its full sum (one vectorizable pass) plus its first
+ * and last max_lag + 1 partial sums, shared by every lag count of the AIC
+ * search and the final fit.
+ */
+class AdfSums {
+public:
+    /// Doubles of work space needed
+    static std::size_t size(int n, int max_lag) {
+        return static_cast<std::size_t>(n) + (2 * max_lag + 3) * series_size(max_lag);
+    }
+
+    /// work: at least size(n, max_lag) doubles
+    AdfSums(const double* e, int n, int max_lag, double* work)
+        : n_(n), edge_(max_lag + 1), d_(work), ee_(work + n),
+          ed_(ee_ + series_size(max_lag)), dd_(ed_ + (max_lag + 1) * series_size(max_lag)) {
+        for (int t = 0; t + 1 < n; ++t) {
+            d_[t] = e[t + 1] - e[t];
+        }
+        const double* d = d_;
+
+        summarize(n, [=](int s) { return e[s] * e[s]; }, ee_);
+        for (int l = 0; l <= max_lag; ++l) {
+            summarize(n - 1, [=](int s) { return e[s + l] * d[s]; }, ed_ + l * series_size(max_lag));
+            summarize(n - 1 - l, [=](int s) { return d[s] * d[s + l]; }, dd_ + l * series_size(max_lag));
+        }
+    }
+
+    /**
+     * @brief Normal equations over t = first .. n - 2 into gram, an
+     *        (lags + 2)^2 matrix of the regressors followed by the
+     *        response (lower triangle; the last row is X'y, the last
+     *        diagonal entry y'y). first must be at least lags.
+     */
+    void normal_equations(int lags, int first, double* gram) const {
+        const int m = lags + 2;
+        const int last = n_ - 2;
+
+        // Column index -> lag of d (the response is d at lag 0)
+        auto lag_of = [&](int a) { return a == m - 1 ? 0 : a; };
+
+        gram[0] = window(ee_, n_, first, last);
+        for (int a = 1; a < m; ++a) {
+            const int l = lag_of(a);
+            gram[a * m] = window(ed_ + l * series_size(edge_ - 1), n_ - 1, first - l, last - l);
+            for (int b = 1; b <= a; ++b) {
+                const int l1 = std::max(l, lag_of(b));
+                const int k = std::abs(l - lag_of(b));
+                gram[a * m + b] = window(dd_ + k * series_size(edge_ - 1), n_ - 1 - k, first - l1, last - l1);
+            }
+        }
+    }
+
+private:
+    /// Full sum, then edge_ + 1 head and edge_ + 1 tail partial sums
+    static std::size_t series_size(int max_lag) { return 1 + 2 * static_cast<std::size_t>(max_lag + 2); }
+
+    template <typename Term>
+    void summarize(int count, Term term, double* out) const {
+        double total = 0.0;
+        for (int s = 0; s < count; ++s) {
+            total += term(s);
+        }
+        out[0] = total;
+
+        double* head = out + 1;        // head[j] = terms 0 .. j - 1
+        double* tail = out + 2 + edge_; // tail[j] = the last j terms
+        head[0] = 0.0;
+        tail[0] = 0.0;
+        for (int j = 1; j <= edge_; ++j) {
+            head[j] = head[j - 1] + (j - 1 < count ? term(j - 1) : 0.0);
+            tail[j] = tail[j - 1] + (count - j >= 0 ? term(count - j) : 0.0);
+        }
+    }
+
+    /// Sum over s = lo .. hi of a series of count terms
+    double window(const double* series, int count, int lo, int hi) const {
+        return series[0] - series[1 + lo] - series[2 + edge_ + (count - 1 - hi)];
+    }
+
+    int n_;
+    int edge_;
+    double* d_;
+    double* ee_;
+    double* ed_; // per lag l: e[s + l] d[s]
+    double* dd_; // per lag k: d[s] d[s + k]
+};
+
+/**
+ * @brief OLS on the leading `regressors` columns of AdfSums::normal_equations().
+ *
+ * @param coef Out: coefficients (regressors)
+ * @param inv00 Out (optional): element (0, 0) of the inverse Gram matrix
+ *
+ * @return Residual sum of squares, or -1 for a singular design
+ */
+double adf_fit(const double* gram, int m, int regressors, double* factor, double* coef, double* inv00) {
+    for (int a = 0; a < regressors; ++a) {
+        for (int b = 0; b <= a; ++b) {
+            factor[a * m + b] = gram[a * m + b];
+        }
+    }
+    if (!cholesky(factor, regressors, m)) {
+        return -1.0;
+    }
+
+    const double* xy = gram + (m - 1) * m;
+    std::copy(xy, xy + regressors, coef);
+    cholesky_solve(factor, regressors, m, coef);
+
+    if (inv00 != nullptr) {
+        double unit[64] = {1.0};
+        cholesky_solve(factor, regressors, m, unit);
+        *inv00 = unit[0];
+    }
+
+    double ssr = gram[(m - 1) * m + (m - 1)];
+    for (int a = 0; a < regressors; ++a) {
+        ssr -= coef[a] * xy[a];
+    }
+    return std::max(ssr, 0.0);
+}
+
+/// Work space of adf_test(): the sums plus Gram, factor and coefficients
+std::size_t adf_work_size(int n, int max_lag) {
+    return AdfSums::size(n, max_lag) + 2 * static_cast<std::size_t>((max_lag + 2) * (max_lag + 2)) + 64;
+}
+
+struct AdfResult {
+    double statistic = 0.0;
+    int lags = 0;
+    bool valid = false;
+};
+
+/**
+ * @brief ADF test without trend, lag count by AIC (as statsmodels
+ *        adfuller(autolag="AIC", regression="n")).
+ *
+ * @param work At least adf_work_size(n, max_lag) doubles
+ */
+AdfResult adf_test(const double* e, int n, int max_lag, double* work) {
+    const int m = max_lag + 2;
+    const AdfSums sums(e, n, max_lag, work);
+    double* gram = work + AdfSums::size(n, max_lag);
+    double* factor = gram + m * m;
+    double* coef = factor + m * m;
+
+    // Every lag count on the common sample t = max_lag .. n - 2; the
+    // models are the leading blocks of the largest one
+    const int common_obs = n - 1 - max_lag;
+    sums.normal_equations(max_lag, max_lag, gram);
+
+    AdfResult result;
+    double best_aic = 0.0;
+    for (int lags = 0; lags <= max_lag; ++lags) {
+        const double ssr = adf_fit(gram, m, lags + 1, factor, coef, nullptr);
+        if (ssr <= 0.0) {
+            continue;
+        }
+        const double aic = common_obs * std::log(ssr / common_obs) + 2.0 * (lags + 1);
+        if (!result.valid || aic < best_aic) {
+            best_aic = aic;
+            result.lags = lags;
+            result.valid = true;
+        }
+    }
+    if (!result.valid) {
+        return result;
+    }
+
+    // Refit the chosen model on all the observations it can use
+    const int lags = result.lags;
+    const int obs = n - 1 - lags;
+    sums.normal_equations(lags, lags, gram);
+
+    double inv00 = 0.0;
+    const double ssr = adf_fit(gram, lags + 2, lags + 1, factor, coef, &inv00);
+    const int dof = obs - (lags + 1);
+    if (ssr <= 0.0 || dof <= 0) {
+        result.valid = false;
+        return result;
+    }
+    result.statistic = coef[0] / std::sqrt(ssr / dof * inv00);
+    return result;
+}
+
+/**
+ * @brief Ornstein-Uhlenbeck half-life of a spread: regress its change on
+ *        its previous level (with a constant), -ln 2 / slope.
+ */
+double half_life(const double* e, int n) {
+    double mean_level = 0.0;
+    double mean_change = 0.0;
+    for (int t = 1; t < n; ++t) {
+        mean_level += e[t - 1];
+        mean_change += e[t] - e[t - 1];
+    }
+    mean_level /= n - 1;
+    mean_change /= n - 1;
+
+    double sxy = 0.0;
+    double sxx = 0.0;
+    for (int t = 1; t < n; ++t) {
+        const double x = e[t - 1] - mean_level;
+        sxy += x * (e[t] - e[t - 1] - mean_change);
+        sxx += x * x;
+    }
+
+    const double slope = sxx > 0.0 ? sxy / sxx : 0.0;
+    return slope < 0.0 ? -std::log(2.0) / slope : NOT_MEAN_REVERTING;
+}
+
+} // namespace
+
+double engle_granger_p_value(double adf_statistic) {
+    if (adf_statistic > TAU_MAX) {
+        return 1.0;
+    }
+    if (adf_statistic < TAU_MIN) {
+        return 0.0;
+    }
+
+    const double x = adf_statistic;
+    const double z = x <= TAU_STAR
+        ? TAU_SMALL_P[0] + x * (TAU_SMALL_P[1] + x * TAU_SMALL_P[2])
+        : TAU_LARGE_P[0] + x * (TAU_LARGE_P[1] + x * (TAU_LARGE_P[2] + x * TAU_LARGE_P[3]));
+    return 0.5 * std::erfc(-z / std::sqrt(2.0));
+}
+
+std::vector<CointegrationPair> screen_cointegrated_pairs(
+    const double* prices,
+    std::size_t num_obs,
+    std::size_t num_assets,
+    const CointegrationOptions& options
+) {
+    if (num_obs < MIN_OBSERVATIONS) {
+        throw std::invalid_argument("cointegration screen needs at least 20 observations");
+    }
+    if (options.max_p_value < 0.0 || options.min_abs_correlation < 0.0) {
+        throw std::invalid_argument("max_p_value and min_abs_correlation must be non-negative");
+    }
+
+    const int n = static_cast<int>(num_obs);
+    const int lag_cap = n / 2 - 1;
+    int max_lag = options.max_lag >= 0
+        ? options.max_lag
+        : static_cast<int>(std::ceil(12.0 * std::pow(n / 100.0, 0.25)));
+    max_lag = std::max(0, std::min({max_lag, lag_cap, 62}));
+
+    const unsigned threads = resolve_num_threads(options.num_threads);
+    ThreadPool& pool = ThreadPool::instance();
+
+    // Centered columns (asset-major), means and squared norms
+    std::vector<double> centered(num_assets * num_obs);
+    std::vector<double> mean(num_assets);
+    std::vector<double> norm2(num_assets);
+    pool.parallel_for(num_assets, threads, [&](std::size_t a) {
+        double* c = &centered[a * num_obs];
+        double sum = 0.0;
+        for (std::size_t t = 0; t < num_obs; ++t) {
+            c[t] = prices[t * num_assets + a];
+            sum += c[t];
+        }
+        mean[a] = sum / n;
+        double ss = 0.0;
+        for (std::size_t t = 0; t < num_obs; ++t) {
+            c[t] -= mean[a];
+            ss += c[t] * c[t];
+        }
+        norm2[a] = ss;
+    });
+
+    // Cross products of the upper triangle
+    std::vector<double> cross(num_assets * num_assets);
+    pool.parallel_for(num_assets, threads, [&](std::size_t i) {
+        const double* ci = &centered[i * num_obs];
+        for (std::size_t j = i + 1; j < num_assets; ++j) {
+            const double* cj = &centered[j * num_obs];
+            double s = 0.0;
+            for (std::size_t t = 0; t < num_obs; ++t) {
+                s += ci[t] * cj[t];
+            }
+            cross[i * num_assets + j] = s;
+        }
+    });
+
+    // Correlation pre-filter
+    struct Candidate {
+        int first;
+        int second;
+        double correlation;
+    };
+    std::vector<Candidate> candidates;
+    for (std::size_t i = 0; i < num_assets; ++i) {
+        for (std::size_t j = i + 1; j < num_assets; ++j) {
+            if (norm2[i] <= 0.0 || norm2[j] <= 0.0) {
+                continue;  // constant price
+            }
+            const double corr = cross[i * num_assets + j] / std::sqrt(norm2[i] * norm2[j]);
+            if (std::abs(corr) >= options.min_abs_correlation) {
+                candidates.push_back({static_cast<int>(i), static_cast<int>(j), corr});
+            }
+        }
+    }
+
+    std::vector<CointegrationPair> tested(candidates.size());
+    std::vector<char> passed(candidates.size(), 0);
+    const std::size_t num_blocks = (candidates.size() + PAIR_BLOCK - 1) / PAIR_BLOCK;
+    const std::size_t work_size = adf_work_size(n, max_lag);
+
+    pool.parallel_for(num_blocks, threads, [&](std::size_t block) {
+        std::vector<double> spread(num_obs);
+        std::vector<double> work(work_size);
+
+        const std::size_t end = std::min((block + 1) * PAIR_BLOCK, candidates.size());
+        for (std::size_t c = block * PAIR_BLOCK; c < end; ++c) {
+            const Candidate& cand = candidates[c];
+            const double* ci = &centered[cand.first * num_obs];
+            const double* cj = &centered[cand.second * num_obs];
+
+            // OLS residual of first on second (centered spread)
+            const double beta = cross[cand.first * num_assets + cand.second] / norm2[cand.second];
+            double ss = 0.0;
+            for (std::size_t t = 0; t < num_obs; ++t) {
+                spread[t] = ci[t] - beta * cj[t];
+                ss += spread[t] * spread[t];
+            }
+
+            // An exact linear relation leaves no residual to test
+            if (ss <= 1e-24 * norm2[cand.first]) {
+                continue;
+            }
+
+            const AdfResult adf = adf_test(spread.data(), n, max_lag, work.data());
+            if (!adf.valid) {
+                continue;
+            }
+            const double p_value = engle_granger_p_value(adf.statistic);
+            if (p_value > options.max_p_value) {
+                continue;
+            }
+
+            CointegrationPair& pair = tested[c];
+            pair.first = cand.first;
+            pair.second = cand.second;
+            pair.correlation = cand.correlation;
+            pair.hedge_ratio = beta;
+            pair.adf_statistic = adf.statistic;
+            pair.p_value = p_value;
+            pair.lags = adf.lags;
+            pair.half_life = half_life(spread.data(), n);
+            pair.spread_mean = mean[cand.first] - beta * mean[cand.second];
+            pair.spread_std = std::sqrt(ss / n);
+            pair.last_z_score = spread[num_obs - 1] / pair.spread_std;
+            passed[c] = 1;
+        }
+    });
+
+    std::vector<CointegrationPair> result;
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        if (passed[c]) {
+            result.push_back(tested[c]);
+        }
+    }
+    return result;
+}
+
+} // namespace quant
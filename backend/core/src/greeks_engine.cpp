@@ -4,29 +4,13 @@
  */
 
 #include "greeks_engine.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
 #include <cmath>
 #include <algorithm>
 
 namespace quant {
 
-// Constants
-constexpr double PI = 3.14159265358979323846;
-constexpr double INV_SQRT_2PI = 0.3989422804014327; // 1 / sqrt(2 * pi)
-
-/**
- * @brief Standard Normal Probability Density Function (PDF)
- */
-inline double normal_pdf(double x) {
-    return INV_SQRT_2PI * std::exp(-0.5 * x * x);
-}
-
-/**
- * @brief Standard Normal Cumulative Distribution Function (CDF)
- */
-inline double normal_cdf(double x) {
-    return 0.5 * std::erfc(-x * 0.7071067811865475); // -x / sqrt(2)
-}
-
 GreeksResult calculate_greeks(
     double strike,
     double time_to_expiry,
@@ -49,7 +33,7 @@ GreeksResult calculate_greeks(
     }
 
     double sqrt_t = std::sqrt(time_to_expiry);
-    double d1 = (std::log(spot / strike) + (risk_free_rate + 0.5 * volatility * volatility) * time_to_expiry) / (volatility * sqrt_t);
+    double d1 = (fmath::log(spot / strike) + (risk_free_rate + 0.5 * volatility * volatility) * time_to_expiry) / (volatility * sqrt_t);
     double d2 = d1 - volatility * sqrt_t;
 
     double nd1 = normal_cdf(d1);
@@ -57,7 +41,7 @@ GreeksResult calculate_greeks(
     double n_prime_d1 = normal_pdf(d1);
 
     // Common term: e^(-rT)
-    double exp_rt = std::exp(-risk_free_rate * time_to_expiry);
+    double exp_rt = fmath::exp(-risk_free_rate * time_to_expiry);
 
     // GAMMA (Same for Call and Put)
     result.gamma = n_prime_d1 / (spot * volatility * sqrt_t);
@@ -97,4 +81,131 @@ GreeksResult calculate_greeks(
     return result;
 }
 
+namespace {
+
+/// Options per parallel task in calculate_greeks_batch
+constexpr std::size_t GREEKS_BLOCK = 4096;
+
+/// Options per pass through the SIMD math kernels
+constexpr int GREEKS_TILE = 256;
+
+/**
+ * @brief Greeks for options [begin, begin + n) of a batch, n <= GREEKS_TILE.
+ *
+ * Runs in three passes so the transcendental functions go through the
+ * SIMD kernels: shared terms, then log/exp/Phi/phi over the whole tile,
+ * then the Greeks. Degenerate rows are evaluated on safe dummy inputs and
+ * overwritten by the expiry values, so no pass has branches.
+ */
+void greeks_tile(
+    const double* strike,
+    const double* time_to_expiry,
+    const double* spot,
+    const double* risk_free_rate,
+    const double* volatility,
+    const bool* is_call,
+    std::size_t begin,
+    int n,
+    GreeksBatch& out
+) {
+    const SimdKernels& kernels = simd_kernels();
+
+    alignas(64) double log_moneyness[GREEKS_TILE];
+    alignas(64) double exp_rt[GREEKS_TILE];
+    alignas(64) double sqrt_t[GREEKS_TILE];
+    alignas(64) double d1[GREEKS_TILE];
+    alignas(64) double signed_d2[GREEKS_TILE];
+    alignas(64) double nd1[GREEKS_TILE];
+    alignas(64) double n_signed_d2[GREEKS_TILE];
+    alignas(64) double n_prime_d1[GREEKS_TILE];
+
+    const double* k = strike + begin;
+    const double* t = time_to_expiry + begin;
+    const double* s = spot + begin;
+    const double* r = risk_free_rate + begin;
+    const double* v = volatility + begin;
+    const bool* call = is_call + begin;
+
+    auto valid = [&](int i) { return t[i] > 0.0 && v[i] > 0.0 && k[i] > 0.0 && s[i] > 0.0; };
+
+    // Pass 1: arguments of the shared transcendental terms
+    for (int i = 0; i < n; ++i) {
+        const bool ok = valid(i);
+        const double ts = ok ? t[i] : 1.0;
+        log_moneyness[i] = ok ? s[i] / k[i] : 1.0;
+        exp_rt[i] = -r[i] * ts;
+        sqrt_t[i] = std::sqrt(ts);
+    }
+    kernels.log(log_moneyness, log_moneyness, n);
+    kernels.exp(exp_rt, exp_rt, n);
+
+    // Pass 2: d1 / d2. Calls use N(d2), puts N(-d2): one CDF either way
+    for (int i = 0; i < n; ++i) {
+        const bool ok = valid(i);
+        const double ts = ok ? t[i] : 1.0;
+        const double vs = ok ? v[i] : 1.0;
+        const double vol_sqrt_t = vs * sqrt_t[i];
+        d1[i] = (log_moneyness[i] + (r[i] + 0.5 * vs * vs) * ts) / vol_sqrt_t;
+        signed_d2[i] = (call[i] ? 1.0 : -1.0) * (d1[i] - vol_sqrt_t);
+    }
+    kernels.normal_cdf(d1, nd1, n);
+    kernels.normal_cdf(signed_d2, n_signed_d2, n);
+    kernels.normal_pdf(d1, n_prime_d1, n);
+
+    // Pass 3: Greeks
+    for (int i = 0; i < n; ++i) {
+        const bool ok = valid(i);
+        const double ks = ok ? k[i] : 1.0;
+        const double ts = ok ? t[i] : 1.0;
+        const double ss = ok ? s[i] : 1.0;
+        const double vs = ok ? v[i] : 1.0;
+        const double sign = call[i] ? 1.0 : -1.0;
+
+        const double decay = -(ss * n_prime_d1[i] * vs) / (2.0 * sqrt_t[i]);
+        const double carry = -sign * r[i] * ks * exp_rt[i] * n_signed_d2[i];
+
+        const double delta = call[i] ? nd1[i] : nd1[i] - 1.0;
+        const double expiry_delta = call[i] ? (s[i] > k[i] ? 1.0 : 0.0) : (s[i] < k[i] ? -1.0 : 0.0);
+
+        const std::size_t o = begin + i;
+        out.delta[o] = ok ? delta : expiry_delta;
+        out.gamma[o] = ok ? n_prime_d1[i] / (ss * vs * sqrt_t[i]) : 0.0;
+        out.vega[o] = ok ? ss * n_prime_d1[i] * sqrt_t[i] * 0.01 : 0.0;
+        out.theta[o] = ok ? (decay + carry) / 365.0 : 0.0;
+        out.rho[o] = ok ? sign * ks * ts * exp_rt[i] * n_signed_d2[i] * 0.01 : 0.0;
+    }
+}
+
+} // namespace
+
+GreeksBatch calculate_greeks_batch(
+    const double* strike,
+    const double* time_to_expiry,
+    const double* spot,
+    const double* risk_free_rate,
+    const double* volatility,
+    const bool* is_call,
+    std::size_t n
+) {
+    GreeksBatch out;
+    out.delta.resize(n);
+    out.gamma.resize(n);
+    out.vega.resize(n);
+    out.theta.resize(n);
+    out.rho.resize(n);
+
+    const std::size_t num_blocks = (n + GREEKS_BLOCK - 1) / GREEKS_BLOCK;
+    ThreadPool::instance().parallel_for(num_blocks, 0, [&](std::size_t block) {
+        const std::size_t begin = block * GREEKS_BLOCK;
+        const std::size_t end = std::min(begin + GREEKS_BLOCK, n);
+        for (std::size_t tile = begin; tile < end; tile += GREEKS_TILE) {
+            const int count = static_cast<int>(std::min<std::size_t>(GREEKS_TILE, end - tile));
+            greeks_tile(strike, time_to_expiry, spot, risk_free_rate, volatility, is_call,
+                        tile, count, out);
+        }
+    });
+
+    return out;
+}
+
 } // namespace quant
@@ -0,0 +1,305 @@
+/**
+ * @file hrp.cpp
+ * @brief Implementation of the Hierarchical Risk Parity allocator.
+ */
+
+#include "hrp.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+/// Assets per side of a covariance tile (a 32 x 32 accumulator)
+constexpr std::size_t ASSET_TILE = 32;
+
+/// Observations per pass over a tile: two 32-asset strips of 512 doubles
+/// (256 KiB) stay in L2 while every pair of the tile is accumulated
+constexpr std::size_t OBS_TILE = 512;
+
+/**
+ * @brief Sample covariance matrix (num_assets x num_assets, full).
+ */
+std::vector<double> covariance(
+    const double* returns, std::size_t num_obs, std::size_t num_assets, unsigned threads
+) {
+    ThreadPool& pool = ThreadPool::instance();
+
+    // Centered columns, asset-major so every pair is a contiguous dot product
+    std::vector<double> centered(num_assets * num_obs);
+    pool.parallel_for(num_assets, threads, [&](std::size_t a) {
+        double* c = &centered[a * num_obs];
+        double sum = 0.0;
+        for (std::size_t t = 0; t < num_obs; ++t) {
+            c[t] = returns[t * num_assets + a];
+            sum += c[t];
+        }
+        const double mean = sum / static_cast<double>(num_obs);
+        for (std::size_t t = 0; t < num_obs; ++t) {
+            c[t] -= mean;
+        }
+    });
+
+    // Upper-triangle tiles (row tile <= column tile)
+    const std::size_t num_tiles = (num_assets + ASSET_TILE - 1) / ASSET_TILE;
+    std::vector<std::pair<std::size_t, std::size_t>> tiles;
+    tiles.reserve(num_tiles * (num_tiles + 1) / 2);
+    for (std::size_t bi = 0; bi < num_tiles; ++bi) {
+        for (std::size_t bj = bi; bj < num_tiles; ++bj) {
+            tiles.emplace_back(bi, bj);
+        }
+    }
+
+    std::vector<double> cov(num_assets * num_assets);
+    const double scale = 1.0 / static_cast<double>(num_obs - 1);
+    pool.parallel_for(tiles.size(), threads, [&](std::size_t tile) {
+        const std::size_t i0 = tiles[tile].first * ASSET_TILE;
+        const std::size_t j0 = tiles[tile].second * ASSET_TILE;
+        const std::size_t i1 = std::min(i0 + ASSET_TILE, num_assets);
+        const std::size_t j1 = std::min(j0 + ASSET_TILE, num_assets);
+
+        double acc[ASSET_TILE][ASSET_TILE] = {};
+        for (std::size_t t0 = 0; t0 < num_obs; t0 += OBS_TILE) {
+            const std::size_t len = std::min(OBS_TILE, num_obs - t0);
+            for (std::size_t i = i0; i < i1; ++i) {
+                const double* ci = &centered[i * num_obs + t0];
+                for (std::size_t j = std::max(i, j0); j < j1; ++j) {
+                    const double* cj = &centered[j * num_obs + t0];
+                    double s = 0.0;
+                    for (std::size_t t = 0; t < len; ++t) {
+                        s += ci[t] * cj[t];
+                    }
+                    acc[i - i0][j - j0] += s;
+                }
+            }
+        }
+
+        for (std::size_t i = i0; i < i1; ++i) {
+            for (std::size_t j = std::max(i, j0); j < j1; ++j) {
+                const double c = acc[i - i0][j - j0] * scale;
+                cov[i * num_assets + j] = c;
+                cov[j * num_assets + i] = c;
+            }
+        }
+    });
+    return cov;
+}
+
+/**
+ * @brief Single-linkage dendrogram from the Prim minimum spanning tree of
+ *        the correlation distance (scipy linkage layout).
+ *
+ * Merge heights are the sorted MST edge weights (a stable sort, so ties
+ * merge in tree order) and clusters are joined with union-find.
+ */
+std::vector<double> single_linkage(const std::vector<double>& cov, const std::vector<double>& inv_std, std::size_t n) {
+    auto distance = [&](std::size_t a, std::size_t b) {
+        const double rho = std::clamp(cov[a * n + b] * inv_std[a] * inv_std[b], -1.0, 1.0);
+        return std::sqrt(0.5 * (1.0 - rho));
+    };
+
+    struct Edge {
+        int a;
+        int b;
+        double d;
+    };
+    std::vector<Edge> edges(n - 1);
+    std::vector<double> best(n, std::numeric_limits<double>::infinity());
+    std::vector<int> nearest(n, 0);
+    std::vector<char> in_tree(n, 0);
+
+    std::size_t x = 0;
+    for (std::size_t k = 0; k + 1 < n; ++k) {
+        in_tree[x] = 1;
+        std::size_t y = 0;
+        double d_min = std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < n; ++i) {
+            if (in_tree[i]) {
+                continue;
+            }
+            const double d = distance(x, i);
+            if (d < best[i]) {
+                best[i] = d;
+                nearest[i] = static_cast<int>(x);
+            }
+            if (best[i] < d_min) {
+                d_min = best[i];
+                y = i;
+            }
+        }
+        edges[k] = {nearest[y], static_cast<int>(y), d_min};
+        x = y;
+    }
+    std::stable_sort(edges.begin(), edges.end(), [](const Edge& l, const Edge& r) { return l.d < r.d; });
+
+    std::vector<int> root(n);
+    std::vector<int> cluster(n);
+    std::vector<int> size(n, 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        root[i] = static_cast<int>(i);
+        cluster[i] = static_cast<int>(i);
+    }
+    auto find = [&](int i) {
+        while (root[i] != i) {
+            root[i] = root[root[i]];
+            i = root[i];
+        }
+        return i;
+    };
+
+    std::vector<double> linkage((n - 1) * 4);
+    for (std::size_t k = 0; k + 1 < n; ++k) {
+        const int ra = find(edges[k].a);
+        const int rb = find(edges[k].b);
+        double* row = &linkage[k * 4];
+        row[0] = std::min(cluster[ra], cluster[rb]);
+        row[1] = std::max(cluster[ra], cluster[rb]);
+        row[2] = edges[k].d;
+        row[3] = size[ra] + size[rb];
+
+        root[rb] = ra;
+        size[ra] += size[rb];
+        cluster[ra] = static_cast<int>(n + k);
+    }
+    return linkage;
+}
+
+/**
+ * @brief Leaves of the dendrogram, left (lower cluster id) first.
+ */
+std::vector<int> quasi_diagonal_order(const std::vector<double>& linkage, std::size_t n) {
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<int> stack{static_cast<int>(2 * n - 2)};
+    while (!stack.empty()) {
+        const int id = stack.back();
+        stack.pop_back();
+        if (id < static_cast<int>(n)) {
+            order.push_back(id);
+            continue;
+        }
+        const double* row = &linkage[(id - n) * 4];
+        stack.push_back(static_cast<int>(row[1]));
+        stack.push_back(static_cast<int>(row[0]));
+    }
+    return order;
+}
+
+/**
+ * @brief Variance of the inverse-variance portfolio of the assets
+ *        [begin, end) of a reordered covariance matrix.
+ *
+ * @param inv_var 1 / variance of every asset, in the same order
+ */
+double cluster_variance(
+    const std::vector<double>& sorted_cov, const std::vector<double>& inv_var,
+    std::size_t n, std::size_t begin, std::size_t end
+) {
+    double iv_sum = 0.0;
+    for (std::size_t i = begin; i < end; ++i) {
+        iv_sum += inv_var[i];
+    }
+
+    // w' C w with w_i = inv_var[i] / iv_sum
+    double variance = 0.0;
+    for (std::size_t i = begin; i < end; ++i) {
+        const double* row = &sorted_cov[i * n];
+        double s = 0.0;
+        for (std::size_t j = begin; j < end; ++j) {
+            s += row[j] * inv_var[j];
+        }
+        variance += inv_var[i] * s;
+    }
+    return variance / (iv_sum * iv_sum);
+}
+
+} // namespace
+
+HrpAllocation hrp_allocation(
+    const double* returns,
+    std::size_t num_obs,
+    std::size_t num_assets,
+    int num_threads
+) {
+    if (num_obs < 2) {
+        throw std::invalid_argument("HRP needs at least 2 observations");
+    }
+    if (num_assets == 0) {
+        throw std::invalid_argument("HRP needs at least one asset");
+    }
+
+    HrpAllocation result;
+    const std::size_t n = num_assets;
+    if (n == 1) {
+        result.weights = {1.0};
+        result.order = {0};
+        return result;
+    }
+
+    const unsigned threads = resolve_num_threads(num_threads);
+    const std::vector<double> cov = covariance(returns, num_obs, n, threads);
+
+    std::vector<double> inv_std(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double variance = cov[i * n + i];
+        if (!(variance > 0.0)) {
+            throw std::invalid_argument("HRP needs every asset to have non-zero return variance");
+        }
+        inv_std[i] = 1.0 / std::sqrt(variance);
+    }
+
+    result.linkage = single_linkage(cov, inv_std, n);
+    result.order = quasi_diagonal_order(result.linkage, n);
+
+    // Covariance in quasi-diagonal order: every cluster is a contiguous block
+    std::vector<double> sorted_cov(n * n);
+    ThreadPool::instance().parallel_for(n, threads, [&](std::size_t i) {
+        const double* src = &cov[result.order[i] * n];
+        double* dst = &sorted_cov[i * n];
+        for (std::size_t j = 0; j < n; ++j) {
+            dst[j] = src[result.order[j]];
+        }
+    });
+
+    std::vector<double> inv_var(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        inv_var[i] = 1.0 / sorted_cov[i * n + i];
+    }
+
+    // Recursive bisection over index ranges of the ordered assets
+    std::vector<double> sorted_weights(n, 1.0);
+    std::vector<std::pair<std::size_t, std::size_t>> ranges{{0, n}};
+    while (!ranges.empty()) {
+        const auto [begin, end] = ranges.back();
+        ranges.pop_back();
+        if (end - begin < 2) {
+            continue;
+        }
+        const std::size_t mid = begin + (end - begin) / 2;
+        const double v0 = cluster_variance(sorted_cov, inv_var, n, begin, mid);
+        const double v1 = cluster_variance(sorted_cov, inv_var, n, mid, end);
+        const double alpha = 1.0 - v0 / (v0 + v1);
+        for (std::size_t i = begin; i < mid; ++i) {
+            sorted_weights[i] *= alpha;
+        }
+        for (std::size_t i = mid; i < end; ++i) {
+            sorted_weights[i] *= 1.0 - alpha;
+        }
+        ranges.emplace_back(begin, mid);
+        ranges.emplace_back(mid, end);
+    }
+
+    result.weights.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        result.weights[result.order[i]] = sorted_weights[i];
+    }
+    return result;
+}
+
+} // namespace quant
@@ -0,0 +1,213 @@
+/**
+ * @file implied_vol.cpp
+ * @brief Implementation of the batched implied-volatility solver.
+ */
+
+#include "implied_vol.h"
+#include "greeks_engine.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace quant {
+
+namespace {
+
+/// Options per parallel task
+constexpr std::size_t IV_BLOCK = 4096;
+
+/// Options stepped together by the Newton loop
+constexpr int IV_TILE = 64;
+
+/// Upper end of the initial bracket, in total volatility sigma * sqrt(T).
+/// A call at w = 20 is worth S - X * N(-10), i.e. the upper bound.
+constexpr double MAX_TOTAL_VOL = 20.0;
+
+constexpr double SQRT_2PI = 2.5066282746310002;
+constexpr double INV_PI = 0.3183098861837907;
+constexpr double MAX_FINITE = std::numeric_limits<double>::max();
+
+/**
+ * @brief Solve options [begin, end) of a batch, at most IV_TILE of them.
+ *
+ * Works in total volatility w = sigma * sqrt(T) on the equivalent call,
+ * where C(w) = S N(d1) - X N(d1 - w), d1 = ln(S/X)/w + w/2, X = K e^(-rT)
+ * and dC/dw = S phi(d1).
+ */
+void solve_tile(
+    const double* price,
+    const double* strike,
+    const double* time_to_expiry,
+    const double* spot,
+    const double* risk_free_rate,
+    const bool* is_call,
+    std::size_t begin,
+    int lanes,
+    double tolerance,
+    int max_iterations,
+    ImpliedVolBatch& out
+) {
+    double s[IV_TILE], x[IV_TILE], log_sx[IV_TILE], target[IV_TILE];
+    double w[IV_TILE], lo[IV_TILE], hi[IV_TILE], w_tol[IV_TILE];
+    alignas(64) double d1[IV_TILE], d2[IV_TILE], nd1[IV_TILE], nd2[IV_TILE], pdf_d1[IV_TILE];
+    int iterations[IV_TILE];
+    bool active[IV_TILE];
+    uint8_t status[IV_TILE];
+
+    // Normalize to a call and check the no-arbitrage bounds
+    for (int l = 0; l < lanes; ++l) {
+        const std::size_t i = begin + l;
+        const double k = strike[i];
+        const double t = time_to_expiry[i];
+        const double r = risk_free_rate[i];
+        const double p = price[i];
+
+        // Range checks rather than std::isfinite, which -ffast-math folds away
+        const bool valid = k > 0.0 && t > 0.0 && spot[i] > 0.0 &&
+                           std::fabs(p) < MAX_FINITE && std::fabs(r) < MAX_FINITE;
+        const double sqrt_t = std::sqrt(valid ? t : 1.0);
+
+        s[l] = valid ? spot[i] : 1.0;
+        x[l] = valid ? k * fmath::exp(-r * t) : 1.0;
+        log_sx[l] = fmath::log(s[l] / x[l]);
+
+        // Put-call parity: C = P + S - K e^(-rT)
+        target[l] = is_call[i] ? p : p + s[l] - x[l];
+        const bool in_bounds = target[l] > std::max(s[l] - x[l], 0.0) && target[l] < s[l];
+
+        status[l] = static_cast<uint8_t>(
+            !valid ? IvStatus::InvalidInput
+                   : (in_bounds ? IvStatus::MaxIterations : IvStatus::OutOfBounds));
+        active[l] = valid && in_bounds;
+
+        // Corrado-Miller closed-form estimate, Brenner-Subrahmanyam if it fails
+        const double half_moneyness = 0.5 * (s[l] - x[l]);
+        const double a = target[l] - half_moneyness;
+        const double disc = a * a - 4.0 * half_moneyness * half_moneyness * INV_PI;
+        double guess = SQRT_2PI / (s[l] + x[l]) * (a + std::sqrt(std::max(disc, 0.0)));
+        guess = guess > 0.0 ? guess : SQRT_2PI * target[l] / s[l];
+
+        w[l] = std::min(std::max(guess, 1e-6), MAX_TOTAL_VOL);
+        lo[l] = 0.0;
+        hi[l] = MAX_TOTAL_VOL;
+        w_tol[l] = tolerance * sqrt_t;
+        iterations[l] = 0;
+    }
+
+    const SimdKernels& kernels = simd_kernels();
+
+    // Safeguarded Newton, all lanes in lock-step until every lane is done
+    for (int it = 0; it < max_iterations; ++it) {
+        int remaining = 0;
+
+        for (int l = 0; l < lanes; ++l) {
+            d1[l] = log_sx[l] / w[l] + 0.5 * w[l];
+            d2[l] = d1[l] - w[l];
+        }
+        kernels.normal_cdf(d1, nd1, lanes);
+        kernels.normal_cdf(d2, nd2, lanes);
+        kernels.normal_pdf(d1, pdf_d1, lanes);
+
+        for (int l = 0; l < lanes; ++l) {
+            const double model = s[l] * nd1[l] - x[l] * nd2[l];
+            const double vega = s[l] * pdf_d1[l];
+            const double diff = model - target[l];
+
+            // C(w) is increasing, so the sign of diff moves one bracket end
+            const double new_lo = (active[l] && diff < 0.0) ? w[l] : lo[l];
+            const double new_hi = (active[l] && diff >= 0.0) ? w[l] : hi[l];
+
+            const double newton = w[l] - diff / vega;
+            const bool inside = newton > new_lo && newton < new_hi;
+            const double next = inside ? newton : 0.5 * (new_lo + new_hi);
+
+            const bool done = std::fabs(next - w[l]) <= w_tol[l];
+
+            lo[l] = new_lo;
+            hi[l] = new_hi;
+            w[l] = active[l] ? next : w[l];
+            iterations[l] += active[l] ? 1 : 0;
+            status[l] = (active[l] && done) ? static_cast<uint8_t>(IvStatus::Converged) : status[l];
+            active[l] = active[l] && !done;
+            remaining += active[l] ? 1 : 0;
+        }
+
+        if (remaining == 0) {
+            break;
+        }
+    }
+
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    for (int l = 0; l < lanes; ++l) {
+        const std::size_t i = begin + l;
+        const bool solved = status[l] == static_cast<uint8_t>(IvStatus::Converged) ||
+                            status[l] == static_cast<uint8_t>(IvStatus::MaxIterations);
+        out.volatility[i] = solved ? w[l] / std::sqrt(time_to_expiry[i]) : NaN;
+        out.iterations[i] = iterations[l];
+        out.status[i] = status[l];
+    }
+}
+
+} // namespace
+
+double black_scholes_price(
+    double strike,
+    double time_to_expiry,
+    double spot,
+    double risk_free_rate,
+    double volatility,
+    bool is_call
+) {
+    const double sign = is_call ? 1.0 : -1.0;
+
+    // At expiry
+    if (time_to_expiry <= 0.0) {
+        return std::max(sign * (spot - strike), 0.0);
+    }
+
+    const double discounted_strike = strike * fmath::exp(-risk_free_rate * time_to_expiry);
+    if (volatility <= 0.0 || strike <= 0.0 || spot <= 0.0) {
+        return std::max(sign * (spot - discounted_strike), 0.0);
+    }
+
+    const double vol_sqrt_t = volatility * std::sqrt(time_to_expiry);
+    const double d1 = fmath::log(spot / discounted_strike) / vol_sqrt_t + 0.5 * vol_sqrt_t;
+    const double d2 = d1 - vol_sqrt_t;
+
+    return sign * (spot * normal_cdf(sign * d1) - discounted_strike * normal_cdf(sign * d2));
+}
+
+ImpliedVolBatch implied_volatility_batch(
+    const double* price,
+    const double* strike,
+    const double* time_to_expiry,
+    const double* spot,
+    const double* risk_free_rate,
+    const bool* is_call,
+    std::size_t n,
+    double tolerance,
+    int max_iterations
+) {
+    ImpliedVolBatch out;
+    out.volatility.resize(n);
+    out.iterations.resize(n);
+    out.status.resize(n);
+
+    const std::size_t num_blocks = (n + IV_BLOCK - 1) / IV_BLOCK;
+    ThreadPool::instance().parallel_for(num_blocks, 0, [&](std::size_t block) {
+        const std::size_t block_end = std::min((block + 1) * IV_BLOCK, n);
+
+        for (std::size_t begin = block * IV_BLOCK; begin < block_end; begin += IV_TILE) {
+            const int lanes = static_cast<int>(std::min<std::size_t>(IV_TILE, block_end - begin));
+            solve_tile(price, strike, time_to_expiry, spot, risk_free_rate, is_call,
+                       begin, lanes, tolerance, max_iterations, out);
+        }
+    });
+
+    return out;
+}
+
+} // namespace quant
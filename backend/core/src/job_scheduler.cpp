@@ -0,0 +1,343 @@
+/**
+ * @file job_scheduler.cpp
+ * @brief Implementation of the admission-controlled job queue.
+ */
+
+#include "job_scheduler.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+double seconds_between(std::chrono::steady_clock::time_point from,
+                       std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+const char* priority_name(TaskPriority priority) {
+    return priority == TaskPriority::Interactive ? "interactive" : "batch";
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Job
+// ---------------------------------------------------------------------------
+
+Job::Job(std::function<void()> fn, TaskPriority priority, JobScheduler* scheduler)
+    : fn_(std::move(fn)),
+      priority_(priority),
+      scheduler_(scheduler),
+      submitted_(Clock::now()) {}
+
+Job::State Job::state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+bool Job::done() const {
+    const State state = this->state();
+    return state == State::Done || state == State::Cancelled;
+}
+
+void Job::wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return state_ == State::Done || state_ == State::Cancelled; });
+}
+
+bool Job::cancel() {
+    return scheduler_->cancel(*this);
+}
+
+void Job::on_done(std::function<void()> callback) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_ != State::Done && state_ != State::Cancelled) {
+            callbacks_.push_back(std::move(callback));
+            return;
+        }
+    }
+    callback();
+}
+
+std::exception_ptr Job::error() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+double Job::queued_seconds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (state_) {
+        case State::Queued:
+            return seconds_between(submitted_, Clock::now());
+        case State::Cancelled:
+            return seconds_between(submitted_, finished_);
+        default:
+            return seconds_between(submitted_, started_);
+    }
+}
+
+double Job::run_seconds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (state_) {
+        case State::Running:
+            return seconds_between(started_, Clock::now());
+        case State::Done:
+            return seconds_between(started_, finished_);
+        default:
+            return 0.0;
+    }
+}
+
+void Job::run() {
+    std::exception_ptr error;
+    try {
+        fn_();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // Release whatever the function holds here, not in the last handle
+    fn_ = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = error;
+        finished_ = Clock::now();
+    }
+
+    // Free the slot before waking anyone up
+    scheduler_->finished(*this);
+    finish(State::Done);
+}
+
+void Job::finish(State state) {
+    if (state == State::Cancelled) {
+        fn_ = nullptr;
+    }
+
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state == State::Cancelled) {
+            finished_ = Clock::now();
+        }
+        state_ = state;
+        callbacks.swap(callbacks_);
+    }
+    cv_.notify_all();
+
+    for (std::function<void()>& callback : callbacks) {
+        callback();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// JobScheduler
+// ---------------------------------------------------------------------------
+
+JobScheduler::JobScheduler(ThreadPool& pool, const SchedulerLimits& limits)
+    : pool_(pool), limits_(limits) {}
+
+JobScheduler::~JobScheduler() {
+    cancel_pending();
+    wait_idle();
+}
+
+unsigned JobScheduler::slots_locked() const {
+    return limits_.max_running > 0 ? limits_.max_running : std::max(1u, pool_.num_workers());
+}
+
+bool JobScheduler::can_start_locked(TaskPriority priority) const {
+    const unsigned slots = slots_locked();
+    if (running_total_ >= slots) {
+        return false;
+    }
+    if (priority == TaskPriority::Batch) {
+        // Keep the last slot for interactive work
+        const std::size_t batch_slots = std::max(1u, slots - 1);
+        return stats_[static_cast<std::size_t>(TaskPriority::Batch)].running < batch_slots;
+    }
+    return true;
+}
+
+void JobScheduler::start_locked(const std::shared_ptr<Job>& job) {
+    SchedulerStats& stats = stats_[static_cast<std::size_t>(job->priority())];
+    const Job::Clock::time_point now = Job::Clock::now();
+
+    ++running_total_;
+    ++stats.running;
+    const double wait = seconds_between(job->submitted_, now);
+    stats.wait_seconds_total += wait;
+    stats.wait_seconds_max = std::max(stats.wait_seconds_max, wait);
+
+    {
+        std::lock_guard<std::mutex> lock(job->mutex_);
+        job->state_ = Job::State::Running;
+        job->started_ = now;
+    }
+    pool_.submit([job] { job->run(); }, job->priority());
+}
+
+void JobScheduler::dispatch_locked() {
+    for (;;) {
+        bool started = false;
+        for (std::size_t priority = 0; priority < NUM_TASK_PRIORITIES && !started; ++priority) {
+            std::deque<std::shared_ptr<Job>>& queue = queued_[priority];
+            if (!queue.empty() && can_start_locked(static_cast<TaskPriority>(priority))) {
+                std::shared_ptr<Job> job = std::move(queue.front());
+                queue.pop_front();
+                start_locked(job);
+                started = true;
+            }
+        }
+        if (!started) {
+            return;
+        }
+    }
+}
+
+std::shared_ptr<Job> JobScheduler::submit(std::function<void()> fn, TaskPriority priority) {
+    auto job = std::make_shared<Job>(std::move(fn), priority, this);
+    const auto index = static_cast<std::size_t>(priority);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    SchedulerStats& stats = stats_[index];
+    std::deque<std::shared_ptr<Job>>& queue = queued_[index];
+
+    if (queue.empty() && can_start_locked(priority)) {
+        ++stats.submitted;
+        start_locked(job);
+        return job;
+    }
+
+    const std::size_t max_queued = priority == TaskPriority::Interactive
+        ? limits_.max_queued_interactive
+        : limits_.max_queued_batch;
+    if (queue.size() >= max_queued) {
+        ++stats.rejected;
+        throw SchedulerOverloaded(
+            std::string("engine overloaded: ") + std::to_string(queue.size()) + " " +
+            priority_name(priority) + " jobs already waiting"
+        );
+    }
+
+    ++stats.submitted;
+    queue.push_back(std::move(job));
+    return queue.back();
+}
+
+bool JobScheduler::cancel(Job& job) {
+    std::shared_ptr<Job> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto index = static_cast<std::size_t>(job.priority());
+        std::deque<std::shared_ptr<Job>>& queue = queued_[index];
+        const auto it = std::find_if(queue.begin(), queue.end(),
+                                     [&](const std::shared_ptr<Job>& queued) { return queued.get() == &job; });
+        if (it == queue.end()) {
+            return false;
+        }
+        cancelled = std::move(*it);
+        queue.erase(it);
+        ++stats_[index].cancelled;
+        if (running_total_ == 0 && queued_[0].empty() && queued_[1].empty()) {
+            idle_cv_.notify_all();
+        }
+    }
+    cancelled->finish(Job::State::Cancelled);
+    return true;
+}
+
+void JobScheduler::finished(Job& job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SchedulerStats& stats = stats_[static_cast<std::size_t>(job.priority())];
+
+    --running_total_;
+    --stats.running;
+    if (job.error_) {
+        ++stats.failed;
+    } else {
+        ++stats.completed;
+    }
+    const double run = seconds_between(job.started_, job.finished_);
+    stats.run_seconds_total += run;
+    stats.run_seconds_max = std::max(stats.run_seconds_max, run);
+
+    dispatch_locked();
+    if (running_total_ == 0) {
+        idle_cv_.notify_all();
+    }
+}
+
+void JobScheduler::set_limits(const SchedulerLimits& limits) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limits_ = limits;
+    // More slots may have opened up
+    dispatch_locked();
+}
+
+SchedulerLimits JobScheduler::limits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return limits_;
+}
+
+unsigned JobScheduler::slots() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_locked();
+}
+
+SchedulerStats JobScheduler::stats(TaskPriority priority) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto index = static_cast<std::size_t>(priority);
+    SchedulerStats stats = stats_[index];
+    stats.queued = queued_[index].size();
+    return stats;
+}
+
+std::size_t JobScheduler::cancel_pending() {
+    std::vector<std::shared_ptr<Job>> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t priority = 0; priority < NUM_TASK_PRIORITIES; ++priority) {
+            stats_[priority].cancelled += queued_[priority].size();
+            for (std::shared_ptr<Job>& job : queued_[priority]) {
+                cancelled.push_back(std::move(job));
+            }
+            queued_[priority].clear();
+        }
+        if (running_total_ == 0) {
+            idle_cv_.notify_all();
+        }
+    }
+
+    for (const std::shared_ptr<Job>& job : cancelled) {
+        job->finish(Job::State::Cancelled);
+    }
+    return cancelled.size();
+}
+
+void JobScheduler::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] {
+        if (running_total_ > 0) {
+            return false;
+        }
+        for (const std::deque<std::shared_ptr<Job>>& queue : queued_) {
+            if (!queue.empty()) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+JobScheduler& JobScheduler::instance() {
+    static JobScheduler scheduler(ThreadPool::instance());
+    return scheduler;
+}
+
+} // namespace quant
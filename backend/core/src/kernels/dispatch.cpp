@@ -0,0 +1,133 @@
+/**
+ * @file dispatch.cpp
+ * @brief Runtime CPU-feature detection and SIMD kernel selection.
+ */
+
+#include "simd_kernels.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace quant {
+
+namespace kernels {
+namespace generic { const SimdKernels& table(); }
+#ifdef QUANT_HAVE_AVX2
+namespace avx2 { const SimdKernels& table(); }
+#endif
+#ifdef QUANT_HAVE_AVX512
+namespace avx512 { const SimdKernels& table(); }
+#endif
+#ifdef QUANT_HAVE_NEON
+namespace neon { const SimdKernels& table(); }
+#endif
+} // namespace kernels
+
+namespace {
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+bool cpu_has_avx2() {
+    int info[4];
+    __cpuid(info, 1);
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!fma || !osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+bool cpu_has_avx512() {
+    if (!cpu_has_avx2() || (_xgetbv(0) & 0xE6) != 0xE6) {
+        return false;
+    }
+    int info[4];
+    __cpuidex(info, 7, 0);
+    const bool f = (info[1] & (1 << 16)) != 0;
+    const bool dq = (info[1] & (1 << 17)) != 0;
+    const bool vl = (info[1] & (1 << 31)) != 0;
+    return f && dq && vl;
+}
+
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+bool cpu_has_avx2() {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+bool cpu_has_avx512() {
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+           __builtin_cpu_supports("avx512vl");
+}
+
+#else
+
+bool cpu_has_avx2() { return false; }
+bool cpu_has_avx512() { return false; }
+
+#endif
+
+/// Variant requested through STRATA_SIMD, or nullptr for automatic
+const SimdKernels* requested_kernels() {
+    const char* env = std::getenv("STRATA_SIMD");
+    if (env == nullptr) {
+        return nullptr;
+    }
+    if (std::strcmp(env, "generic") == 0) {
+        return &kernels::generic::table();
+    }
+#ifdef QUANT_HAVE_AVX2
+    if (std::strcmp(env, "avx2") == 0 && cpu_has_avx2()) {
+        return &kernels::avx2::table();
+    }
+#endif
+#ifdef QUANT_HAVE_AVX512
+    if (std::strcmp(env, "avx512") == 0 && cpu_has_avx512()) {
+        return &kernels::avx512::table();
+    }
+#endif
+#ifdef QUANT_HAVE_NEON
+    if (std::strcmp(env, "neon") == 0) {
+        return &kernels::neon::table();
+    }
+#endif
+    return nullptr;
+}
+
+const SimdKernels& select_kernels() {
+    if (const SimdKernels* requested = requested_kernels()) {
+        return *requested;
+    }
+#ifdef QUANT_HAVE_AVX512
+    if (cpu_has_avx512()) {
+        return kernels::avx512::table();
+    }
+#endif
+#ifdef QUANT_HAVE_AVX2
+    if (cpu_has_avx2()) {
+        return kernels::avx2::table();
+    }
+#endif
+#ifdef QUANT_HAVE_NEON
+    // NEON is part of the AArch64 baseline
+    return kernels::neon::table();
+#else
+    return kernels::generic::table();
+#endif
+}
+
+} // namespace
+
+const SimdKernels& simd_kernels() {
+    static const SimdKernels& selected = select_kernels();
+    return selected;
+}
+
+} // namespace quant
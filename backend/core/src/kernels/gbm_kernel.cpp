@@ -0,0 +1,160 @@
+/**
+ * @file gbm_kernel.cpp
+ * @brief GBM step and normal-generation kernels (compiled once per ISA).
+ *
+ * CMake builds this file several times with different target flags and a
+ * different QUANT_KERNEL_ISA, producing one kernel table per instruction
+ * set. The loops are written lane-wise over a tile of paths so the
+ * compiler vectorizes them for whichever ISA the object targets.
+ */
+
+#include "simd_kernels.h"
+#include "fast_math.h"
+#include "rng.h"
+
+#include <cstddef>
+
+#ifndef QUANT_KERNEL_ISA
+#define QUANT_KERNEL_ISA generic
+#endif
+
+#define QUANT_STRINGIFY_IMPL(x) #x
+#define QUANT_STRINGIFY(x) QUANT_STRINGIFY_IMPL(x)
+
+namespace quant {
+namespace kernels {
+namespace QUANT_KERNEL_ISA {
+
+// Defined in math_kernels.cpp, built for the same ISA
+void exp_array(const double* x, double* out, int n);
+void log_array(const double* x, double* out, int n);
+void normal_pdf_array(const double* x, double* out, int n);
+void normal_cdf_array(const double* x, double* out, int n);
+
+namespace {
+
+void normals(
+    uint64_t key,
+    uint64_t first_path,
+    int num_lanes,
+    int first_pair,
+    int num_pairs,
+    uint32_t stream,
+    double* z
+) {
+    const uint32_t k0_init = static_cast<uint32_t>(key);
+    const uint32_t k1_init = static_cast<uint32_t>(key >> 32);
+
+    for (int p = 0; p < num_pairs; ++p) {
+        const uint32_t pair_index = static_cast<uint32_t>(first_pair + p);
+        double* z0 = z + (2 * p) * SIMD_TILE;
+        double* z1 = z0 + SIMD_TILE;
+
+        for (int lane = 0; lane < num_lanes; ++lane) {
+            const uint64_t path = first_path + static_cast<uint64_t>(lane);
+
+            // Philox4x32-10, same counter layout as quant::normal_pair()
+            uint32_t c0 = pair_index;
+            uint32_t c1 = stream;
+            uint32_t c2 = static_cast<uint32_t>(path);
+            uint32_t c3 = static_cast<uint32_t>(path >> 32);
+            uint32_t k0 = k0_init;
+            uint32_t k1 = k1_init;
+
+            for (int round = 0; round < 10; ++round) {
+                const uint64_t p0 = static_cast<uint64_t>(Philox4x32::M0) * c0;
+                const uint64_t p1 = static_cast<uint64_t>(Philox4x32::M1) * c2;
+                const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                c1 = static_cast<uint32_t>(p1);
+                c3 = static_cast<uint32_t>(p0);
+                c0 = n0;
+                c2 = n2;
+                k0 += Philox4x32::W0;
+                k1 += Philox4x32::W1;
+            }
+
+            // 52-bit uniforms in (0, 1] built directly from the exponent
+            // bits, avoiding integer-to-double conversion
+            const uint64_t b0 = (static_cast<uint64_t>(c0) << 32) | c1;
+            const uint64_t b1 = (static_cast<uint64_t>(c2) << 32) | c3;
+            const double u1 = 2.0 - fmath::from_bits((b0 >> 12) | 0x3FF0000000000000ull);
+            const double u2 = 2.0 - fmath::from_bits((b1 >> 12) | 0x3FF0000000000000ull);
+
+            // Box-Muller transform
+            const double r = std::sqrt(-2.0 * fmath::log(u1));
+            double s, c;
+            fmath::sincos_2pi(u2, s, c);
+
+            z0[lane] = r * c;
+            z1[lane] = r * s;
+        }
+    }
+}
+
+void gbm_step(double drift, double diffusion, const double* z, double* prices, int n) {
+    for (int i = 0; i < n; ++i) {
+        prices[i] *= fmath::exp(drift + diffusion * z[i]);
+    }
+}
+
+void portfolio_step(
+    const double* factor,
+    const double* drift,
+    const double* holdings,
+    int num_assets,
+    const double* z,
+    int z_stride,
+    double* levels,
+    double* values,
+    int n
+) {
+    alignas(64) double shock[SIMD_TILE];
+
+    for (int i = 0; i < n; ++i) {
+        values[i] = 0.0;
+    }
+
+    for (int a = 0; a < num_assets; ++a) {
+        // Row a of the lower-triangular factor times the normals
+        const double* row = factor + static_cast<std::size_t>(a) * num_assets;
+        for (int i = 0; i < n; ++i) {
+            shock[i] = 0.0;
+        }
+        for (int b = 0; b <= a; ++b) {
+            const double coef = row[b];
+            const double* zb = z + static_cast<std::size_t>(b) * z_stride;
+            for (int i = 0; i < n; ++i) {
+                shock[i] += coef * zb[i];
+            }
+        }
+
+        double* level = levels + a * SIMD_TILE;
+        const double mu = drift[a];
+        const double holding = holdings[a];
+        for (int i = 0; i < n; ++i) {
+            level[i] *= fmath::exp(mu + shock[i]);
+            values[i] += holding * level[i];
+        }
+    }
+}
+
+} // namespace
+
+const SimdKernels& table() {
+    static const SimdKernels kernels = {
+        QUANT_STRINGIFY(QUANT_KERNEL_ISA),
+        &normals,
+        &gbm_step,
+        &portfolio_step,
+        &exp_array,
+        &log_array,
+        &normal_pdf_array,
+        &normal_cdf_array
+    };
+    return kernels;
+}
+
+} // namespace QUANT_KERNEL_ISA
+} // namespace kernels
+} // namespace quant
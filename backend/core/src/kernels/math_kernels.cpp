@@ -0,0 +1,45 @@
+/**
+ * @file math_kernels.cpp
+ * @brief Array versions of the fast_math.h functions (compiled once per ISA).
+ *
+ * Built alongside gbm_kernel.cpp into each per-ISA object, which puts these
+ * loops in that ISA's SimdKernels table.
+ */
+
+#include "fast_math.h"
+
+#ifndef QUANT_KERNEL_ISA
+#define QUANT_KERNEL_ISA generic
+#endif
+
+namespace quant {
+namespace kernels {
+namespace QUANT_KERNEL_ISA {
+
+void exp_array(const double* x, double* out, int n) {
+    for (int i = 0; i < n; ++i) {
+        out[i] = fmath::exp(x[i]);
+    }
+}
+
+void log_array(const double* x, double* out, int n) {
+    for (int i = 0; i < n; ++i) {
+        out[i] = fmath::log(x[i]);
+    }
+}
+
+void normal_pdf_array(const double* x, double* out, int n) {
+    for (int i = 0; i < n; ++i) {
+        out[i] = fmath::normal_pdf(x[i]);
+    }
+}
+
+void normal_cdf_array(const double* x, double* out, int n) {
+    for (int i = 0; i < n; ++i) {
+        out[i] = fmath::normal_cdf(x[i]);
+    }
+}
+
+} // namespace QUANT_KERNEL_ISA
+} // namespace kernels
+} // namespace quant
@@ -4,149 +4,141 @@
  */
 
 #include "monte_carlo.h"
-
-#include <algorithm>
-#include <cmath>
-#include <numeric>
-#include <random>
-#include <chrono>
+#include "path_export.h"
+#include "path_simulation.h"
+#include "path_statistics.h"
+#include "process_models.h"
+#include "simulation_workspace.h"
+#include "thread_pool.h"
+#include "variance_reduction.h"
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
 
 namespace quant {
 
-SimulationResult run_monte_carlo(
-    double s0,
-    double mu,
-    double sigma,
-    int num_simulations,
-    int num_steps,
-    double dt,
-    int histogram_bins,
-    uint64_t seed
-) {
-    // Initialize random number generator
-    // Use provided seed or generate from high-resolution clock
-    std::mt19937_64 rng;
-    if (seed == 0) {
-        auto now = std::chrono::high_resolution_clock::now();
-        seed = static_cast<uint64_t>(now.time_since_epoch().count());
-    }
-    rng.seed(seed);
-
-    // Standard normal distribution
-    std::normal_distribution<double> normal(0.0, 1.0);
-
-    // Pre-compute constants for GBM
-    // S(t+dt) = S(t) * exp((mu - 0.5*sigma^2)*dt + sigma*sqrt(dt)*Z)
-    const double drift = (mu - 0.5 * sigma * sigma) * dt;
-    const double diffusion = sigma * std::sqrt(dt);
-
-    // Storage for all simulated paths
-    // paths[step][simulation] for cache-friendly access during aggregation
-    std::vector<std::vector<double>> paths(num_steps + 1, std::vector<double>(num_simulations));
-
-    // Initialize all paths with starting price
-    std::fill(paths[0].begin(), paths[0].end(), s0);
-
-    // Run simulations
-    for (int sim = 0; sim < num_simulations; ++sim) {
-        double price = s0;
-        for (int step = 1; step <= num_steps; ++step) {
-            double z = normal(rng);
-            price *= std::exp(drift + diffusion * z);
-            paths[step][sim] = price;
-        }
-    }
-
-    // Prepare result structure
+SimulationResult run_monte_carlo(const SimulationConfig& config, SimulationWorkspace* workspace) {
     SimulationResult result;
-    result.mean_path.resize(num_steps + 1);
-    result.percentile_05.resize(num_steps + 1);
-    result.percentile_95.resize(num_steps + 1);
+    PhaseTimer total(result.timings.total_seconds);
+    PhaseTimer setup(result.timings.setup_seconds);
 
-    // Calculate statistics at each time step
-    for (int step = 0; step <= num_steps; ++step) {
-        std::vector<double>& step_prices = paths[step];
+    // Use provided seed or generate from high-resolution clock
+    const uint64_t seed = resolve_seed(config.seed);
+    const AggregationOptions options = aggregation_options(config);
 
-        // Mean
-        double sum = std::accumulate(step_prices.begin(), step_prices.end(), 0.0);
-        result.mean_path[step] = sum / num_simulations;
+    // Prepare result structure
+    const StepGrid grid(config.num_steps, config.output_stride);
+    prepare_result(result, grid, options);
 
-        // Sort for percentile calculation
-        std::sort(step_prices.begin(), step_prices.end());
+    const QuantilePlan plan = make_quantile_plan(config.num_simulations, options);
 
-        // 5th and 95th percentiles
-        int idx_05 = static_cast<int>(0.05 * num_simulations);
-        int idx_95 = static_cast<int>(0.95 * num_simulations);
+    ShockGenerator shocks(config.variance_reduction, seed, config.num_simulations, config.num_steps);
 
-        // Clamp indices to valid range
-        idx_05 = std::max(0, std::min(idx_05, num_simulations - 1));
-        idx_95 = std::max(0, std::min(idx_95, num_simulations - 1));
+    WorkspaceScope scope(workspace);
 
-        result.percentile_05[step] = step_prices[idx_05];
-        result.percentile_95[step] = step_prices[idx_95];
+    std::unique_ptr<PathWriter> writer;
+    if (!config.export_paths.path.empty()) {
+        if (grid.stride() != 1) {
+            throw std::invalid_argument("path export needs output_stride 1 (use the export step_stride)");
+        }
+        writer = std::make_unique<PathWriter>(config.export_paths, config.num_simulations, config.num_steps);
     }
 
-    // Final price statistics
-    const std::vector<double>& final_prices_sorted = paths[num_steps];
-    
-    // Copy sorted final prices for Python access (CVaR)
-    result.final_prices = final_prices_sorted;
-
-    result.final_price_min = final_prices_sorted.front();
-    result.final_price_max = final_prices_sorted.back();
-
-    double sum = std::accumulate(final_prices_sorted.begin(), final_prices_sorted.end(), 0.0);
-    result.final_price_mean = sum / num_simulations;
-
-    // Percentiles for Tail Risk
-    int idx_01 = static_cast<int>(0.01 * num_simulations);
-    int idx_05 = static_cast<int>(0.05 * num_simulations);
-    
-    idx_01 = std::max(0, std::min(idx_01, num_simulations - 1));
-    idx_05 = std::max(0, std::min(idx_05, num_simulations - 1));
-
-    result.final_percentile_01 = final_prices_sorted[idx_01];
-    result.final_percentile_05 = final_prices_sorted[idx_05];
-
-    // Standard deviation
-    double sq_sum = 0.0;
-    for (double price : final_prices_sorted) {
-        double diff = price - result.final_price_mean;
-        sq_sum += diff * diff;
+    visit_process(config, [&](const auto& process) {
+        visit_precision(config, [&](auto value) {
+            using Value = decltype(value);
+            if (config.storage == PathStorage::Streaming) {
+                StreamingAggregator<Value> aggregator(config, plan, result, scope.workspace(), writer.get());
+                setup.stop();
+                simulate(config, process, seed, shocks, aggregator, scope.workspace(), options, plan, result);
+            } else {
+                FullPathAggregator<Value> aggregator(config, plan, result, scope.workspace(), writer.get());
+                setup.stop();
+                simulate(config, process, seed, shocks, aggregator, scope.workspace(), options, plan, result);
+            }
+        });
+    });
+
+    if (writer) {
+        PhaseTimer timer(result.timings.export_seconds);
+        writer->close();
     }
-    result.final_price_std = std::sqrt(sq_sum / num_simulations);
 
-    // Build histogram of final prices
-    result.histogram_data.resize(histogram_bins, 0);
-    result.histogram_edges.resize(histogram_bins + 1);
-
-    // Add margin to histogram range
-    double margin = (result.final_price_max - result.final_price_min) * 0.05;
-    double hist_min = result.final_price_min - margin;
-    double hist_max = result.final_price_max + margin;
-
-    // Handle edge case where all final prices are the same
-    if (hist_max <= hist_min) {
-        hist_min = result.final_price_mean * 0.9;
-        hist_max = result.final_price_mean * 1.1;
-    }
+    total.stop();
+    finish_timings(result.timings, config.num_simulations);
+    return result;
+}
 
-    double bin_width = (hist_max - hist_min) / histogram_bins;
+SimulationResult run_monte_carlo(
+    double s0,
+    double mu,
+    double sigma,
+    int num_simulations,
+    int num_steps,
+    double dt,
+    int histogram_bins,
+    uint64_t seed
+) {
+    SimulationConfig config;
+    config.s0 = s0;
+    config.mu = mu;
+    config.sigma = sigma;
+    config.num_simulations = num_simulations;
+    config.num_steps = num_steps;
+    config.dt = dt;
+    config.histogram_bins = histogram_bins;
+    config.seed = seed;
+    config.keep_final_prices = true;
+
+    return run_monte_carlo(config);
+}
 
-    // Compute bin edges
-    for (int i = 0; i <= histogram_bins; ++i) {
-        result.histogram_edges[i] = hist_min + i * bin_width;
+std::vector<SimulationResult> run_monte_carlo_batch(
+    const SimulationConfig& config,
+    const std::vector<BatchMember>& members,
+    SimulationWorkspace* workspace
+) {
+    if (!config.export_paths.path.empty()) {
+        throw std::invalid_argument("a batch cannot export paths");
     }
 
-    // Count prices in each bin
-    for (double price : final_prices_sorted) {
-        int bin = static_cast<int>((price - hist_min) / bin_width);
-        // Clamp to valid bin range
-        bin = std::max(0, std::min(bin, histogram_bins - 1));
-        result.histogram_data[bin]++;
+    std::vector<SimulationConfig> runs(members.size(), config);
+    for (std::size_t k = 0; k < members.size(); ++k) {
+        runs[k].s0 = members[k].s0;
+        runs[k].mu = members[k].mu;
+        runs[k].sigma = members[k].sigma;
+        visit_process(runs[k], [](const auto&) {});
     }
-
-    return result;
+    validate_aggregation(config.output_stride, aggregation_options(config));
+
+    // Members run in parallel, each with its own parallel_for over path
+    // blocks nested inside: small members then fill the cores together
+    // instead of one barrier-bound run at a time. Members taken by the
+    // calling thread lease workspace (or its own), the others their
+    // worker's.
+    const std::thread::id caller = std::this_thread::get_id();
+
+    std::vector<SimulationResult> results(members.size());
+    ThreadPool::instance().parallel_for(
+        members.size(),
+        resolve_num_threads(config.num_threads),
+        [&](std::size_t k) {
+            const bool on_caller = std::this_thread::get_id() == caller;
+            SimulationWorkspace* member_workspace =
+                on_caller && workspace != nullptr ? workspace : &SimulationWorkspace::local();
+
+            // A thread's own workspace may be leased by a run further up
+            // its stack
+            std::unique_ptr<SimulationWorkspace> own;
+            if (member_workspace != workspace && member_workspace->in_use()) {
+                own = std::make_unique<SimulationWorkspace>();
+                member_workspace = own.get();
+            }
+            results[k] = run_monte_carlo(runs[k], member_workspace);
+        }
+    );
+    return results;
 }
 
 } // namespace quant
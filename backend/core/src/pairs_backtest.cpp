@@ -0,0 +1,156 @@
+/**
+ * @file pairs_backtest.cpp
+ * @brief Implementation of the pairs-trading backtest kernel.
+ */
+
+#include "pairs_backtest.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+constexpr double TRADING_DAYS_PER_YEAR = 252.0;
+
+void validate(const PairsSeries& series) {
+    if (series.length > 0 && (series.z_score == nullptr || series.spread == nullptr || series.capital == nullptr)) {
+        throw std::invalid_argument("pairs backtest needs z_score, spread and capital series");
+    }
+}
+
+/**
+ * @brief Streaming metrics of one run.
+ *
+ * The drawdown peak starts at the first equity value, so a loss on the
+ * first day is not a drawdown.
+ */
+class MetricsAccumulator {
+public:
+    /// Add one daily return; returns the equity after it
+    double add(double r) {
+        equity_ *= 1.0 + r;
+        peak_ = count_ == 0 ? equity_ : std::max(peak_, equity_);
+        drawdown_ = (equity_ - peak_) / peak_;
+        max_drawdown_ = std::min(max_drawdown_, drawdown_);
+
+        // Welford
+        ++count_;
+        const double delta = r - mean_;
+        mean_ += delta / count_;
+        m2_ += delta * (r - mean_);
+
+        wins_ += r > 0.0 ? 1 : 0;
+        active_ += r != 0.0 ? 1 : 0;
+        return equity_;
+    }
+
+    double drawdown() const { return drawdown_; }
+
+    PairsMetrics metrics() const {
+        PairsMetrics m;
+        if (count_ == 0) {
+            return m;
+        }
+        const double std_dev = std::sqrt(m2_ / count_);
+        m.total_return = equity_ - 1.0;
+        m.sharpe_ratio = std_dev > 0.0 ? mean_ / std_dev * std::sqrt(TRADING_DAYS_PER_YEAR) : 0.0;
+        m.max_drawdown = max_drawdown_;
+        m.win_rate = active_ > 0 ? static_cast<double>(wins_) / active_ : 0.0;
+        m.trades = active_;
+        return m;
+    }
+
+private:
+    double equity_ = 1.0;
+    double peak_ = 1.0;
+    double drawdown_ = 0.0;
+    double max_drawdown_ = 0.0;
+    long count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    int wins_ = 0;
+    int active_ = 0;
+};
+
+/**
+ * @brief Run the strategy, calling on_return(i, equity, drawdown) for
+ *        every return day i >= 1 and on_position(i, position) every day.
+ */
+template <typename OnPosition, typename OnReturn>
+PairsMetrics simulate(const PairsSeries& s, const PairsThresholds& t, OnPosition on_position, OnReturn on_return) {
+    MetricsAccumulator acc;
+    int position = 0;
+    for (std::size_t i = 0; i < s.length; ++i) {
+        if (i > 0) {
+            const double r = position * (s.spread[i] - s.spread[i - 1]) / s.capital[i];
+            const double equity = acc.add(r);
+            on_return(i, equity, acc.drawdown());
+        }
+        position = next_pairs_position(position, s.z_score[i], t);
+        on_position(i, position);
+    }
+    return acc.metrics();
+}
+
+} // namespace
+
+PairsBacktestResult run_pairs_backtest(const PairsSeries& series, const PairsThresholds& thresholds) {
+    validate(series);
+
+    PairsBacktestResult result;
+    const std::size_t num_returns = series.length > 0 ? series.length - 1 : 0;
+    result.position.resize(series.length);
+    result.equity_curve.resize(num_returns);
+    result.drawdown.resize(num_returns);
+
+    result.metrics = simulate(
+        series, thresholds,
+        [&](std::size_t i, int position) { result.position[i] = position; },
+        [&](std::size_t i, double equity, double drawdown) {
+            result.equity_curve[i - 1] = equity;
+            result.drawdown[i - 1] = drawdown;
+        });
+    return result;
+}
+
+PairsGridResult run_pairs_grid(
+    const PairsSeries& series,
+    const std::vector<double>& entry_z,
+    const std::vector<double>& exit_z,
+    double stop_loss_z,
+    int num_threads
+) {
+    validate(series);
+
+    PairsGridResult result;
+    result.num_entry = static_cast<int>(entry_z.size());
+    result.num_exit = static_cast<int>(exit_z.size());
+
+    const std::size_t num_cells = entry_z.size() * exit_z.size();
+    result.total_return.resize(num_cells);
+    result.sharpe_ratio.resize(num_cells);
+    result.max_drawdown.resize(num_cells);
+    result.win_rate.resize(num_cells);
+    result.trades.resize(num_cells);
+
+    // Cells are independent and each writes only its own slot
+    ThreadPool::instance().parallel_for(num_cells, resolve_num_threads(num_threads), [&](std::size_t cell) {
+        const PairsThresholds thresholds{entry_z[cell / exit_z.size()], exit_z[cell % exit_z.size()], stop_loss_z};
+        const PairsMetrics m = simulate(
+            series, thresholds, [](std::size_t, int) {}, [](std::size_t, double, double) {});
+
+        result.total_return[cell] = m.total_return;
+        result.sharpe_ratio[cell] = m.sharpe_ratio;
+        result.max_drawdown[cell] = m.max_drawdown;
+        result.win_rate[cell] = m.win_rate;
+        result.trades[cell] = m.trades;
+    });
+
+    return result;
+}
+
+} // namespace quant
@@ -0,0 +1,171 @@
+/**
+ * @file path_export.cpp
+ * @brief Implementation of the streaming path file writer.
+ */
+
+#include "path_export.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+constexpr char MAGIC[8] = {'S', 'T', 'R', 'A', 'T', 'A', 'P', 'T'};
+constexpr std::uint32_t VERSION = 1;
+
+constexpr std::size_t ALIGNMENT = 64;
+
+/// Values converted to the file's precision per write
+constexpr std::size_t CONVERT_CHUNK = 16384;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint32_t value_bytes;    // 4 (float32) or 8 (float64)
+    std::uint32_t step_stride;
+    std::uint64_t num_paths;
+    std::uint64_t num_steps;      // simulated steps
+    std::uint64_t num_points;     // exported steps
+    std::uint64_t values_offset;  // bytes from the start of the file
+    std::uint64_t reserved;
+};
+static_assert(sizeof(FileHeader) == ALIGNMENT, "path file header must be one cache line");
+
+inline std::size_t align_up(std::size_t n, std::size_t a) {
+    return (n + a - 1) / a * a;
+}
+
+} // namespace
+
+std::vector<int> exported_steps(int num_steps, int step_stride) {
+    std::vector<int> steps;
+    for (int step = 0; step < num_steps; step += step_stride) {
+        steps.push_back(step);
+    }
+    steps.push_back(num_steps);
+    return steps;
+}
+
+PathWriter::PathWriter(const PathExportOptions& options, int num_paths, int num_steps)
+    : path_(options.path),
+      staging_(options.path + ".tmp"),
+      float32_(options.float32),
+      step_stride_(options.step_stride),
+      num_paths_(num_paths),
+      num_steps_(num_steps) {
+    if (path_.empty()) {
+        throw std::invalid_argument("path export needs a file path");
+    }
+    if (step_stride_ < 1) {
+        throw std::invalid_argument("export step_stride must be at least 1");
+    }
+    steps_ = exported_steps(num_steps_, step_stride_);
+
+    out_.open(staging_, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        throw std::runtime_error("cannot create path file " + path_);
+    }
+
+    const std::size_t steps_bytes = align_up(steps_.size() * sizeof(std::int32_t), ALIGNMENT);
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.header_size = sizeof(FileHeader);
+    header.value_bytes = float32_ ? sizeof(float) : sizeof(double);
+    header.step_stride = static_cast<std::uint32_t>(step_stride_);
+    header.num_paths = static_cast<std::uint64_t>(num_paths_);
+    header.num_steps = static_cast<std::uint64_t>(num_steps_);
+    header.num_points = steps_.size();
+    header.values_offset = sizeof(FileHeader) + steps_bytes;
+    put(&header, sizeof(header));
+
+    std::vector<std::int32_t> steps(steps_bytes / sizeof(std::int32_t), 0);
+    std::copy(steps_.begin(), steps_.end(), steps.begin());
+    put(steps.data(), steps_bytes);
+
+}
+
+PathWriter::~PathWriter() {
+    if (!closed_) {
+        out_.close();
+        std::error_code error;
+        std::filesystem::remove(staging_, error);
+    }
+}
+
+bool PathWriter::exports(int step) const {
+    return step % step_stride_ == 0 || step == num_steps_;
+}
+
+void PathWriter::put(const void* data, std::size_t bytes) {
+    out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!out_) {
+        throw std::runtime_error("cannot write path file " + path_);
+    }
+    written_ += bytes;
+}
+
+void PathWriter::advance_row(int step) {
+    if (next_row_ >= steps_.size() || steps_[next_row_] != step) {
+        throw std::logic_error("path rows must be written in step order");
+    }
+    ++next_row_;
+}
+
+template <typename To, typename From>
+void PathWriter::put_converted(const From* values, std::vector<To>& buffer) {
+    const std::size_t n = static_cast<std::size_t>(num_paths_);
+    if (buffer.empty()) {
+        buffer.resize(std::min(CONVERT_CHUNK, n));
+    }
+    for (std::size_t begin = 0; begin < n; begin += buffer.size()) {
+        const std::size_t count = std::min(buffer.size(), n - begin);
+        std::copy(values + begin, values + begin + count, buffer.begin());
+        put(buffer.data(), count * sizeof(To));
+    }
+}
+
+void PathWriter::write(int step, const double* values) {
+    advance_row(step);
+    if (float32_) {
+        put_converted(values, narrow_);
+    } else {
+        put(values, static_cast<std::size_t>(num_paths_) * sizeof(double));
+    }
+}
+
+void PathWriter::write(int step, const float* values) {
+    advance_row(step);
+    if (float32_) {
+        put(values, static_cast<std::size_t>(num_paths_) * sizeof(float));
+    } else {
+        put_converted(values, widen_);
+    }
+}
+
+void PathWriter::close() {
+    if (next_row_ != steps_.size()) {
+        throw std::logic_error("path file is missing rows");
+    }
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("cannot write path file " + path_);
+    }
+
+    std::error_code error;
+    std::filesystem::rename(staging_, path_, error);
+    if (error) {
+        std::filesystem::remove(staging_, error);
+        closed_ = true;
+        throw std::runtime_error("cannot replace path file " + path_);
+    }
+    closed_ = true;
+}
+
+} // namespace quant
@@ -0,0 +1,255 @@
+/**
+ * @file path_statistics.cpp
+ * @brief Implementation of the shared path aggregation.
+ */
+
+#include "path_statistics.h"
+#include "percentiles.h"
+#include "risk_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace quant {
+
+StepGrid::StepGrid(int num_steps, int stride) : num_steps_(num_steps), stride_(stride) {
+    if (stride < 1) {
+        throw std::invalid_argument("output_stride must be at least 1");
+    }
+    num_points_ = num_steps / stride + 1 + (num_steps % stride != 0 ? 1 : 0);
+}
+
+QuantilePlan make_quantile_plan(int num_simulations, const AggregationOptions& options) {
+    QuantilePlan plan;
+
+    std::vector<double> all = options.quantiles;
+    all.push_back(0.05);
+    all.push_back(0.95);
+    plan.indices = quantile_indices(all, num_simulations);
+
+    for (double q : options.quantiles) {
+        plan.band_index.push_back(quantile_index(q, num_simulations));
+    }
+    plan.idx_05 = quantile_index(0.05, num_simulations);
+    plan.idx_95 = quantile_index(0.95, num_simulations);
+
+    plan.final_indices = tail_indices(options.confidence_levels, num_simulations);
+    plan.final_indices.push_back(0);
+    plan.final_indices.push_back(quantile_index(0.01, num_simulations));
+    plan.final_indices.push_back(plan.idx_05);
+    plan.final_indices.push_back(num_simulations - 1);
+    std::sort(plan.final_indices.begin(), plan.final_indices.end());
+    plan.final_indices.erase(
+        std::unique(plan.final_indices.begin(), plan.final_indices.end()),
+        plan.final_indices.end()
+    );
+
+    plan.drawdown_indices = quantile_indices(options.confidence_levels, num_simulations);
+
+    return plan;
+}
+
+void validate_aggregation(int stride, const AggregationOptions& options) {
+    if (stride < 1) {
+        throw std::invalid_argument("output_stride must be at least 1");
+    }
+    for (double q : options.quantiles) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::invalid_argument("quantiles must lie in [0, 1]");
+        }
+    }
+    for (double c : options.confidence_levels) {
+        if (!(c > 0.0 && c < 1.0)) {
+            throw std::invalid_argument("confidence levels must lie in (0, 1)");
+        }
+    }
+}
+
+void prepare_result(SimulationResult& result, const StepGrid& grid, const AggregationOptions& options) {
+    const std::size_t num_points = static_cast<std::size_t>(grid.num_points());
+    result.steps.resize(num_points);
+    for (std::size_t p = 0; p + 1 < num_points; ++p) {
+        result.steps[p] = static_cast<int>(p) * grid.stride();
+    }
+    result.steps.back() = grid.num_steps();
+    result.mean_path.resize(num_points);
+    result.percentile_05.resize(num_points);
+    result.percentile_95.resize(num_points);
+    result.quantiles = options.quantiles;
+    result.percentile_bands.resize(options.quantiles.size() * num_points);
+    result.confidence_levels = options.confidence_levels;
+    result.value_at_risk.resize(options.confidence_levels.size());
+    result.expected_shortfall.resize(options.confidence_levels.size());
+    result.max_drawdown_quantiles.resize(options.confidence_levels.size());
+}
+
+void track_drawdown(const double* values, double* peak, double* max_drawdown, int n) {
+    for (int i = 0; i < n; ++i) {
+        peak[i] = std::max(peak[i], values[i]);
+        max_drawdown[i] = std::max(max_drawdown[i], 1.0 - values[i] / peak[i]);
+    }
+}
+
+void track_log_drawdown(const double* log_values, double* peak, double* max_drawdown, int n) {
+    for (int i = 0; i < n; ++i) {
+        peak[i] = std::max(peak[i], log_values[i]);
+        max_drawdown[i] = std::max(max_drawdown[i], peak[i] - log_values[i]);
+    }
+}
+
+namespace {
+
+template <typename T>
+void aggregate_step_values(
+    T* step_values,
+    int num_simulations,
+    int point,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    const std::size_t num_points = result.mean_path.size();
+
+    // Mean
+    double sum = std::accumulate(step_values, step_values + num_simulations, 0.0);
+    result.mean_path[point] = sum / num_simulations;
+
+    // One selection pass places every requested order statistic
+    select_order_statistics(step_values, num_simulations, plan.indices);
+
+    result.percentile_05[point] = step_values[plan.idx_05];
+    result.percentile_95[point] = step_values[plan.idx_95];
+
+    for (std::size_t q = 0; q < plan.band_index.size(); ++q) {
+        result.percentile_bands[q * num_points + point] = step_values[plan.band_index[q]];
+    }
+}
+
+} // namespace
+
+void aggregate_step(
+    double* step_values,
+    int num_simulations,
+    int point,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    aggregate_step_values(step_values, num_simulations, point, plan, result);
+}
+
+void aggregate_step(
+    float* step_values,
+    int num_simulations,
+    int point,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    aggregate_step_values(step_values, num_simulations, point, plan, result);
+}
+
+void aggregate_final_values(
+    double* final_values,
+    int num_simulations,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    const int histogram_bins = options.histogram_bins;
+
+    if (options.keep_final_values) {
+        result.final_prices.assign(final_values, final_values + num_simulations);
+    }
+
+    // Percentiles and VaR cut-offs for Tail Risk, plus min/max as order
+    // statistics, all in one selection pass
+    select_order_statistics(final_values, num_simulations, plan.final_indices);
+
+    result.final_price_min = final_values[0];
+    result.final_price_max = final_values[num_simulations - 1];
+
+    result.final_percentile_01 = final_values[quantile_index(0.01, num_simulations)];
+    result.final_percentile_05 = final_values[plan.idx_05];
+
+    tail_risk(
+        final_values,
+        num_simulations,
+        options.reference,
+        options.confidence_levels,
+        result.value_at_risk.data(),
+        result.expected_shortfall.data()
+    );
+
+    double sum = std::accumulate(final_values, final_values + num_simulations, 0.0);
+    result.final_price_mean = sum / num_simulations;
+
+    // Standard deviation and probability of loss
+    double sq_sum = 0.0;
+    int losses = 0;
+    for (int i = 0; i < num_simulations; ++i) {
+        const double value = final_values[i];
+        double diff = value - result.final_price_mean;
+        sq_sum += diff * diff;
+        losses += value < options.reference ? 1 : 0;
+    }
+    result.final_price_std = std::sqrt(sq_sum / num_simulations);
+
+    // Standard error of independent paths; engines with correlated paths
+    // overwrite it
+    result.standard_error = num_simulations > 1
+        ? std::sqrt(sq_sum / (num_simulations - 1) / num_simulations)
+        : 0.0;
+    result.probability_of_loss = static_cast<double>(losses) / num_simulations;
+
+    // Build histogram of final values
+    PhaseTimer timer(result.timings.histogram_seconds);
+    result.histogram_data.resize(histogram_bins, 0);
+    result.histogram_edges.resize(histogram_bins + 1);
+
+    // Add margin to histogram range
+    double margin = (result.final_price_max - result.final_price_min) * 0.05;
+    double hist_min = result.final_price_min - margin;
+    double hist_max = result.final_price_max + margin;
+
+    // Handle edge case where all final values are the same
+    if (hist_max <= hist_min) {
+        hist_min = result.final_price_mean * 0.9;
+        hist_max = result.final_price_mean * 1.1;
+    }
+
+    double bin_width = (hist_max - hist_min) / histogram_bins;
+
+    // Compute bin edges
+    for (int i = 0; i <= histogram_bins; ++i) {
+        result.histogram_edges[i] = hist_min + i * bin_width;
+    }
+
+    // Count values in each bin
+    for (int i = 0; i < num_simulations; ++i) {
+        const double value = final_values[i];
+        int bin = static_cast<int>((value - hist_min) / bin_width);
+        // Clamp to valid bin range
+        bin = std::max(0, std::min(bin, histogram_bins - 1));
+        result.histogram_data[bin]++;
+    }
+}
+
+void aggregate_drawdowns(
+    double* max_drawdown,
+    int num_simulations,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationResult& result
+) {
+    double sum = std::accumulate(max_drawdown, max_drawdown + num_simulations, 0.0);
+    result.max_drawdown_mean = sum / num_simulations;
+
+    select_order_statistics(max_drawdown, num_simulations, plan.drawdown_indices);
+
+    for (std::size_t c = 0; c < options.confidence_levels.size(); ++c) {
+        result.max_drawdown_quantiles[c] =
+            max_drawdown[quantile_index(options.confidence_levels[c], num_simulations)];
+    }
+}
+
+} // namespace quant
@@ -0,0 +1,82 @@
+/**
+ * @file percentiles.cpp
+ * @brief Implementation of multi-quantile selection.
+ */
+
+#include "percentiles.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+/**
+ * @brief Place order statistics idx[lo_idx..hi_idx) inside data[lo..hi).
+ *
+ * Selecting the middle requested position splits both the data and the
+ * remaining positions in two, so each level of recursion touches every
+ * element at most once.
+ */
+template <typename T>
+void select_range(T* data, int lo, int hi, const int* idx, int lo_idx, int hi_idx) {
+    while (lo_idx < hi_idx) {
+        const int mid_idx = lo_idx + (hi_idx - lo_idx) / 2;
+        const int k = idx[mid_idx];
+
+        std::nth_element(data + lo, data + k, data + hi);
+
+        // Recurse into the smaller side, loop on the larger one
+        if (mid_idx - lo_idx < hi_idx - mid_idx - 1) {
+            select_range(data, lo, k, idx, lo_idx, mid_idx);
+            lo = k + 1;
+            lo_idx = mid_idx + 1;
+        } else {
+            select_range(data, k + 1, hi, idx, mid_idx + 1, hi_idx);
+            hi = k;
+            hi_idx = mid_idx;
+        }
+    }
+}
+
+template <typename T>
+void select_order_statistics_of(T* data, int n, const std::vector<int>& sorted_indices) {
+    if (n <= 1 || sorted_indices.empty()) {
+        return;
+    }
+    select_range(data, 0, n, sorted_indices.data(), 0, static_cast<int>(sorted_indices.size()));
+}
+
+} // namespace
+
+int quantile_index(double q, int n) {
+    int idx = static_cast<int>(q * n);
+    return std::max(0, std::min(idx, n - 1));
+}
+
+std::vector<int> quantile_indices(const std::vector<double>& quantiles, int n) {
+    std::vector<int> indices;
+    indices.reserve(quantiles.size());
+
+    for (double q : quantiles) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::invalid_argument("quantiles must lie in [0, 1]");
+        }
+        indices.push_back(quantile_index(q, n));
+    }
+
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    return indices;
+}
+
+void select_order_statistics(double* data, int n, const std::vector<int>& sorted_indices) {
+    select_order_statistics_of(data, n, sorted_indices);
+}
+
+void select_order_statistics(float* data, int n, const std::vector<int>& sorted_indices) {
+    select_order_statistics_of(data, n, sorted_indices);
+}
+
+} // namespace quant
@@ -0,0 +1,353 @@
+/**
+ * @file portfolio_monte_carlo.cpp
+ * @brief Implementation of the correlated portfolio Monte Carlo engine.
+ */
+
+#include "portfolio_monte_carlo.h"
+#include "path_matrix.h"
+#include "path_statistics.h"
+#include "simd_kernels.h"
+#include "simulation_workspace.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+/// Paths per parallel task. Fixed so the work split never depends on the
+/// number of threads.
+constexpr int PATH_BLOCK = 1024;
+
+/// Steps generated per kernel call, and per pass in streaming mode.
+/// Must be even so every block starts on a Philox normal pair.
+constexpr int STEP_BLOCK = 8;
+
+/// Stride between the normals of two assets in a tile's shock buffer
+constexpr int ASSET_STRIDE = STEP_BLOCK * SIMD_TILE;
+
+static_assert(PATH_BLOCK % SIMD_TILE == 0, "path blocks must hold whole SIMD tiles");
+
+std::size_t num_path_blocks(int num_simulations) {
+    return static_cast<std::size_t>((num_simulations + PATH_BLOCK - 1) / PATH_BLOCK);
+}
+
+/**
+ * @brief Validated model, prepared once per run.
+ */
+struct PortfolioModel {
+    int num_assets = 0;
+
+    /// Lower Cholesky factor of the covariance, row-major
+    std::vector<double> factor;
+
+    /// Per-step log drift of each asset
+    std::vector<double> mean;
+
+    /// Value held in each asset at t = 0 (weights * initial_value)
+    std::vector<double> holdings;
+
+    /// Portfolio value at t = 0
+    double initial_value = 0.0;
+};
+
+PortfolioModel make_model(const PortfolioConfig& config) {
+    const std::size_t n = config.mean.size();
+    if (n == 0) {
+        throw std::invalid_argument("portfolio needs at least one asset");
+    }
+    if (config.weights.size() != n) {
+        throw std::invalid_argument("weights must have one entry per asset");
+    }
+    if (config.covariance.size() != n * n) {
+        throw std::invalid_argument("covariance must be num_assets x num_assets");
+    }
+
+    PortfolioModel model;
+    model.num_assets = static_cast<int>(n);
+    model.factor = cholesky_factor(config.covariance, model.num_assets);
+    model.mean = config.mean;
+
+    for (double w : config.weights) {
+        model.holdings.push_back(w * config.initial_value);
+        model.initial_value += w * config.initial_value;
+    }
+    return model;
+}
+
+/**
+ * @brief Advance a tile of paths by up to STEP_BLOCK steps.
+ *
+ * Draws the normals of every asset for the whole block of steps, then per
+ * step mixes them through the Cholesky factor, applies the log-normal step
+ * to each asset's price relative and sums the holdings into the value
+ * (SimdKernels::portfolio_step).
+ *
+ * @param sim0   First path of the tile
+ * @param lanes  Paths in the tile (<= SIMD_TILE)
+ * @param first  First step to produce (1-based); first - 1 must be even
+ * @param count  Steps to produce (<= STEP_BLOCK)
+ * @param levels Price relative S_i(t) / S_i(0) as levels[asset][lane],
+ *               row stride SIMD_TILE, updated in place
+ * @param z      Scratch of num_assets * ASSET_STRIDE doubles
+ * @param emit   Called as emit(step, values) after every step
+ */
+template <typename Emit>
+void advance_tile(
+    const PortfolioModel& model,
+    uint64_t key,
+    int sim0,
+    int lanes,
+    int first,
+    int count,
+    double* levels,
+    double* z,
+    Emit&& emit
+) {
+    const SimdKernels& kernels = simd_kernels();
+    const int num_assets = model.num_assets;
+    alignas(64) double values[SIMD_TILE];
+
+    // One Philox stream per asset keeps the draws independent of the
+    // number of assets sharing the tile
+    for (int a = 0; a < num_assets; ++a) {
+        kernels.normals(key, static_cast<uint64_t>(sim0), lanes, (first - 1) / 2, (count + 1) / 2,
+                        static_cast<uint32_t>(a), z + a * ASSET_STRIDE);
+    }
+
+    for (int j = 0; j < count; ++j) {
+        kernels.portfolio_step(model.factor.data(), model.mean.data(), model.holdings.data(),
+                               num_assets, z + j * SIMD_TILE, ASSET_STRIDE, levels, values, lanes);
+        emit(first + j, values);
+    }
+}
+
+/**
+ * @brief Generate every value path up front, then aggregate step by step.
+ *
+ * A block of paths advances all its tiles by STEP_BLOCK steps before the
+ * next STEP_BLOCK, so writes stay within STEP_BLOCK rows of the matrix.
+ */
+void simulate_full(
+    const PortfolioConfig& config,
+    const PortfolioModel& model,
+    uint64_t key,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationWorkspace& workspace,
+    SimulationResult& result
+) {
+    const int num_simulations = config.num_simulations;
+    const int num_steps = config.num_steps;
+    const int num_assets = model.num_assets;
+    const unsigned threads = resolve_num_threads(config.num_threads);
+    ThreadPool& pool = ThreadPool::instance();
+
+    // [step][simulation] of portfolio values
+    PathMatrix paths(workspace, num_steps + 1, num_simulations);
+    std::fill(paths.row(0), paths.row(0) + num_simulations, model.initial_value);
+
+    // Price relatives laid out tile by tile as [tile][asset][lane]
+    const std::size_t tile_size = static_cast<std::size_t>(num_assets) * SIMD_TILE;
+    const std::size_t num_tiles = (num_simulations + SIMD_TILE - 1) / SIMD_TILE;
+    double* levels = workspace.allocate<double>(num_tiles * tile_size);
+    std::fill(levels, levels + num_tiles * tile_size, 1.0);
+
+    // Running peak and worst drawdown of every path
+    double* peak = workspace.allocate<double>(num_simulations);
+    double* max_drawdown = workspace.allocate<double>(num_simulations);
+    std::fill(peak, peak + num_simulations, model.initial_value);
+    std::fill(max_drawdown, max_drawdown + num_simulations, 0.0);
+    count_bytes(result.timings,
+                paths.bytes() + (num_tiles * tile_size + 2 * static_cast<std::size_t>(num_simulations)) * sizeof(double));
+
+    PhaseTimer path_timer(result.timings.path_seconds);
+    pool.parallel_for(num_path_blocks(num_simulations), threads, [&](std::size_t block) {
+        const int sim_begin = static_cast<int>(block) * PATH_BLOCK;
+        const int sim_end = std::min(sim_begin + PATH_BLOCK, num_simulations);
+        std::vector<double> z(static_cast<std::size_t>(num_assets) * ASSET_STRIDE);
+
+        for (int first = 1; first <= num_steps; first += STEP_BLOCK) {
+            const int count = std::min(STEP_BLOCK, num_steps - first + 1);
+
+            for (int sim0 = sim_begin; sim0 < sim_end; sim0 += SIMD_TILE) {
+                const int lanes = std::min(SIMD_TILE, sim_end - sim0);
+                double* tile_levels = &levels[(sim0 / SIMD_TILE) * tile_size];
+                advance_tile(model, key, sim0, lanes, first, count, tile_levels, z.data(),
+                    [&](int step, const double* values) {
+                        std::copy(values, values + lanes, paths.row(step) + sim0);
+                        track_drawdown(values, peak + sim0, max_drawdown + sim0, lanes);
+                    });
+            }
+        }
+    });
+    path_timer.stop();
+
+    PhaseTimer step_timer(result.timings.step_stats_seconds);
+    pool.parallel_for(num_steps + 1, threads, [&](std::size_t step) {
+        const int s = static_cast<int>(step);
+        aggregate_step(paths.row(s), num_simulations, s, plan, result);
+    });
+    step_timer.stop();
+
+    PhaseTimer final_timer(result.timings.final_stats_seconds);
+    aggregate_final_values(paths.row(num_steps), num_simulations, options, plan, result);
+    aggregate_drawdowns(max_drawdown, num_simulations, options, plan, result);
+}
+
+/**
+ * @brief Advance all paths one block of steps at a time, aggregating as we go.
+ *
+ * Keeps the price relatives of every (path, asset) pair plus a
+ * STEP_BLOCK x num_simulations buffer of values.
+ */
+void simulate_streaming(
+    const PortfolioConfig& config,
+    const PortfolioModel& model,
+    uint64_t key,
+    const AggregationOptions& options,
+    const QuantilePlan& plan,
+    SimulationWorkspace& workspace,
+    SimulationResult& result
+) {
+    const int num_simulations = config.num_simulations;
+    const int num_steps = config.num_steps;
+    const int num_assets = model.num_assets;
+    const unsigned threads = resolve_num_threads(config.num_threads);
+    ThreadPool& pool = ThreadPool::instance();
+
+    // Price relatives laid out tile by tile as [tile][asset][lane]
+    const std::size_t tile_size = static_cast<std::size_t>(num_assets) * SIMD_TILE;
+    const std::size_t num_tiles = (num_simulations + SIMD_TILE - 1) / SIMD_TILE;
+    double* levels = workspace.allocate<double>(num_tiles * tile_size);
+    std::fill(levels, levels + num_tiles * tile_size, 1.0);
+
+    double* peak = workspace.allocate<double>(num_simulations);
+    double* max_drawdown = workspace.allocate<double>(num_simulations);
+    std::fill(peak, peak + num_simulations, model.initial_value);
+    std::fill(max_drawdown, max_drawdown + num_simulations, 0.0);
+
+    // Reused for every block; aggregate_step reorders each row in place
+    PathMatrix rows(workspace, std::min(STEP_BLOCK, std::max(num_steps, 1)), num_simulations);
+    count_bytes(result.timings,
+                rows.bytes() + (num_tiles * tile_size + 2 * static_cast<std::size_t>(num_simulations)) * sizeof(double));
+
+    std::fill(rows.row(0), rows.row(0) + num_simulations, model.initial_value);
+    {
+        PhaseTimer timer(result.timings.step_stats_seconds);
+        aggregate_step(rows.row(0), num_simulations, 0, plan, result);
+    }
+    int final_row = 0;
+
+    for (int first = 1; first <= num_steps; first += STEP_BLOCK) {
+        const int count = std::min(STEP_BLOCK, num_steps - first + 1);
+
+        PhaseTimer path_timer(result.timings.path_seconds);
+        pool.parallel_for(num_path_blocks(num_simulations), threads, [&](std::size_t block) {
+            const int sim_begin = static_cast<int>(block) * PATH_BLOCK;
+            const int sim_end = std::min(sim_begin + PATH_BLOCK, num_simulations);
+            std::vector<double> z(static_cast<std::size_t>(num_assets) * ASSET_STRIDE);
+
+            for (int sim0 = sim_begin; sim0 < sim_end; sim0 += SIMD_TILE) {
+                const int lanes = std::min(SIMD_TILE, sim_end - sim0);
+                double* tile_levels = &levels[(sim0 / SIMD_TILE) * tile_size];
+                advance_tile(model, key, sim0, lanes, first, count, tile_levels, z.data(),
+                    [&](int step, const double* values) {
+                        std::copy(values, values + lanes, rows.row(step - first) + sim0);
+                        track_drawdown(values, peak + sim0, max_drawdown + sim0, lanes);
+                    });
+            }
+        });
+        path_timer.stop();
+
+        PhaseTimer step_timer(result.timings.step_stats_seconds);
+        pool.parallel_for(count, threads, [&](std::size_t j) {
+            const int r = static_cast<int>(j);
+            aggregate_step(rows.row(r), num_simulations, first + r, plan, result);
+        });
+
+        final_row = count - 1;
+    }
+
+    // The last aggregated row holds the final step
+    PhaseTimer final_timer(result.timings.final_stats_seconds);
+    aggregate_final_values(rows.row(final_row), num_simulations, options, plan, result);
+    aggregate_drawdowns(max_drawdown, num_simulations, options, plan, result);
+}
+
+} // namespace
+
+std::vector<double> cholesky_factor(const std::vector<double>& covariance, int n) {
+    std::vector<double> factor(static_cast<std::size_t>(n) * n, 0.0);
+
+    for (int j = 0; j < n; ++j) {
+        const double* lj = &factor[static_cast<std::size_t>(j) * n];
+        const double c_jj = covariance[static_cast<std::size_t>(j) * n + j];
+
+        double pivot = c_jj;
+        for (int k = 0; k < j; ++k) {
+            pivot -= lj[k] * lj[k];
+        }
+
+        // Round-off may leave a tiny negative pivot on a singular matrix
+        const double tolerance = 1e-12 * std::max(c_jj, 0.0);
+        if (pivot < -tolerance || c_jj < 0.0) {
+            throw std::invalid_argument("covariance must be positive semi-definite");
+        }
+        const double diag = pivot > tolerance ? std::sqrt(pivot) : 0.0;
+        factor[static_cast<std::size_t>(j) * n + j] = diag;
+
+        for (int i = j + 1; i < n; ++i) {
+            double* li = &factor[static_cast<std::size_t>(i) * n];
+            double sum = covariance[static_cast<std::size_t>(i) * n + j];
+            for (int k = 0; k < j; ++k) {
+                sum -= li[k] * lj[k];
+            }
+            li[j] = diag > 0.0 ? sum / diag : 0.0;
+        }
+    }
+
+    return factor;
+}
+
+SimulationResult run_portfolio_monte_carlo(const PortfolioConfig& config) {
+    SimulationResult result;
+    PhaseTimer total(result.timings.total_seconds);
+
+    // Use provided seed or generate from high-resolution clock
+    uint64_t seed = config.seed;
+    if (seed == 0) {
+        auto now = std::chrono::high_resolution_clock::now();
+        seed = static_cast<uint64_t>(now.time_since_epoch().count());
+    }
+
+    const PortfolioModel model = make_model(config);
+
+    AggregationOptions options;
+    options.reference = model.initial_value;
+    options.histogram_bins = config.histogram_bins;
+    options.quantiles = config.quantiles;
+    options.confidence_levels = config.confidence_levels;
+    options.keep_final_values = config.keep_final_values;
+
+    prepare_result(result, config.num_steps, options);
+
+    const QuantilePlan plan = make_quantile_plan(config.num_simulations, options);
+
+    WorkspaceScope scope(nullptr);
+    if (config.storage == PathStorage::Streaming) {
+        simulate_streaming(config, model, seed, options, plan, scope.workspace(), result);
+    } else {
+        simulate_full(config, model, seed, options, plan, scope.workspace(), result);
+    }
+
+    total.stop();
+    finish_timings(result.timings, config.num_simulations);
+    return result;
+}
+
+} // namespace quant
@@ -0,0 +1,470 @@
+/**
+ * @file price_panel.cpp
+ * @brief Implementation of the memory-mapped price panel.
+ */
+
+#include "price_panel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace quant {
+
+namespace {
+
+constexpr char MAGIC[8] = {'S', 'T', 'R', 'A', 'T', 'A', 'P', 'X'};
+constexpr std::uint32_t VERSION = 1;
+
+constexpr std::size_t ALIGNMENT = 64;
+constexpr std::size_t NAME_WIDTH = PANEL_NAME_MAX + 1;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t num_dates;
+    std::uint64_t num_symbols;
+    std::uint64_t num_fields;
+    std::uint64_t column_stride;  // doubles per column
+    std::uint64_t reserved[2];
+};
+static_assert(sizeof(FileHeader) == ALIGNMENT, "panel header must be one cache line");
+
+inline std::size_t align_up(std::size_t n, std::size_t a) {
+    return (n + a - 1) / a * a;
+}
+
+/**
+ * @brief Byte offsets of the sections of a panel file.
+ */
+struct Layout {
+    std::size_t fields;
+    std::size_t symbols;
+    std::size_t dates;
+    std::size_t validity;
+    std::size_t values;
+    std::size_t total;
+    std::size_t column_stride;
+    std::size_t validity_words;  // per symbol
+};
+
+Layout layout(std::size_t num_dates, std::size_t num_symbols, std::size_t num_fields) {
+    Layout l;
+    l.column_stride = align_up(num_dates, ALIGNMENT / sizeof(double));
+    l.validity_words = (num_dates + 63) / 64;
+
+    std::size_t offset = sizeof(FileHeader);
+    l.fields = offset;
+    offset += align_up(num_fields * NAME_WIDTH, ALIGNMENT);
+    l.symbols = offset;
+    offset += align_up(num_symbols * NAME_WIDTH, ALIGNMENT);
+    l.dates = offset;
+    offset += align_up(num_dates * sizeof(PanelDate), ALIGNMENT);
+    l.validity = offset;
+    offset += align_up(num_symbols * l.validity_words * sizeof(std::uint64_t), ALIGNMENT);
+    l.values = offset;
+    offset += num_fields * num_symbols * l.column_stride * sizeof(double);
+    l.total = offset;
+    return l;
+}
+
+std::vector<std::string> read_names(const char* base, std::size_t count) {
+    std::vector<std::string> names(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const char* name = base + i * NAME_WIDTH;
+        names[i].assign(name, std::find(name, name + NAME_WIDTH, '\0'));
+    }
+    return names;
+}
+
+/**
+ * @brief Finite check on the bit pattern; the engine builds with
+ *        -ffast-math, under which std::isfinite may fold to true.
+ */
+inline bool is_finite(double x) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7ff0000000000000ULL) != 0x7ff0000000000000ULL;
+}
+
+void check_name(const std::string& name, const char* what) {
+    if (name.empty() || name.size() > PANEL_NAME_MAX) {
+        throw std::invalid_argument(std::string(what) + " names must have 1 to 31 characters");
+    }
+}
+
+/**
+ * @brief Buffered section writer that pads every section to ALIGNMENT.
+ */
+class SectionWriter {
+public:
+    explicit SectionWriter(const std::string& path) : out_(path, std::ios::binary | std::ios::trunc) {
+        if (!out_) {
+            throw std::runtime_error("cannot create price panel " + path);
+        }
+    }
+
+    void write(const void* data, std::size_t bytes) {
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        written_ += bytes;
+    }
+
+    void pad() {
+        static const char zeros[ALIGNMENT] = {};
+        write(zeros, align_up(written_, ALIGNMENT) - written_);
+    }
+
+    void close(const std::string& path) {
+        out_.close();
+        if (!out_) {
+            throw std::runtime_error("cannot write price panel " + path);
+        }
+    }
+
+private:
+    std::ofstream out_;
+    std::size_t written_ = 0;
+};
+
+} // namespace
+
+PricePanel::PricePanel(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("cannot open price panel " + path);
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw std::runtime_error("cannot stat price panel " + path);
+    }
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+    if (size_ >= sizeof(FileHeader)) {
+        mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        data_ = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    }
+    CloseHandle(file);
+    if (size_ >= sizeof(FileHeader) && data_ == nullptr) {
+        unmap();
+        throw std::runtime_error("cannot map price panel " + path);
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open price panel " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("cannot stat price panel " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ >= sizeof(FileHeader)) {
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        data_ = data == MAP_FAILED ? nullptr : data;
+    }
+    ::close(fd);
+    if (size_ >= sizeof(FileHeader) && data_ == nullptr) {
+        throw std::runtime_error("cannot map price panel " + path);
+    }
+#endif
+
+    if (data_ == nullptr) {
+        throw std::invalid_argument("not a price panel (file too small): " + path);
+    }
+
+    const char* base = static_cast<const char*>(data_);
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.header_size != sizeof(FileHeader)) {
+        unmap();
+        throw std::invalid_argument("not a price panel: " + path);
+    }
+    if (header.version != VERSION) {
+        unmap();
+        throw std::invalid_argument("unsupported price panel version " + std::to_string(header.version));
+    }
+
+    const Layout l = layout(header.num_dates, header.num_symbols, header.num_fields);
+    if (l.column_stride != header.column_stride || size_ < l.total) {
+        unmap();
+        throw std::invalid_argument("truncated or corrupt price panel: " + path);
+    }
+
+    num_dates_ = header.num_dates;
+    column_stride_ = l.column_stride;
+    validity_words_ = l.validity_words;
+    fields_ = read_names(base + l.fields, header.num_fields);
+    symbols_ = read_names(base + l.symbols, header.num_symbols);
+    dates_ = reinterpret_cast<const PanelDate*>(base + l.dates);
+    validity_ = reinterpret_cast<const std::uint64_t*>(base + l.validity);
+    values_ = reinterpret_cast<const double*>(base + l.values);
+}
+
+PricePanel::~PricePanel() {
+    unmap();
+}
+
+PricePanel::PricePanel(PricePanel&& other) noexcept {
+    *this = std::move(other);
+}
+
+PricePanel& PricePanel::operator=(PricePanel&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+        num_dates_ = other.num_dates_;
+        column_stride_ = other.column_stride_;
+        validity_words_ = other.validity_words_;
+        symbols_ = std::move(other.symbols_);
+        fields_ = std::move(other.fields_);
+        dates_ = std::exchange(other.dates_, nullptr);
+        validity_ = std::exchange(other.validity_, nullptr);
+        values_ = std::exchange(other.values_, nullptr);
+    }
+    return *this;
+}
+
+void PricePanel::unmap() noexcept {
+#ifdef _WIN32
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+#else
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+int PricePanel::symbol_index(const std::string& symbol) const {
+    const auto it = std::lower_bound(symbols_.begin(), symbols_.end(), symbol);
+    return it != symbols_.end() && *it == symbol ? static_cast<int>(it - symbols_.begin()) : -1;
+}
+
+int PricePanel::field_index(const std::string& field) const {
+    const auto it = std::find(fields_.begin(), fields_.end(), field);
+    return it != fields_.end() ? static_cast<int>(it - fields_.begin()) : -1;
+}
+
+const double* PricePanel::column(int field, int symbol) const {
+    return values_ + (static_cast<std::size_t>(field) * symbols_.size() + symbol) * column_stride_;
+}
+
+const std::uint64_t* PricePanel::validity(int symbol) const {
+    return validity_ + static_cast<std::size_t>(symbol) * validity_words_;
+}
+
+std::size_t PricePanel::lower_bound(PanelDate date) const {
+    return static_cast<std::size_t>(std::lower_bound(dates_, dates_ + num_dates_, date) - dates_);
+}
+
+AlignedPanel PricePanel::align(
+    int field,
+    const std::vector<int>& symbols,
+    PanelDate first,
+    PanelDate last,
+    bool forward_fill
+) const {
+    if (field < 0 || field >= static_cast<int>(fields_.size())) {
+        throw std::invalid_argument("price panel field index out of range");
+    }
+    for (int s : symbols) {
+        if (s < 0 || s >= static_cast<int>(symbols_.size())) {
+            throw std::invalid_argument("price panel symbol index out of range");
+        }
+    }
+
+    const std::size_t k = symbols.size();
+    std::vector<const double*> columns(k);
+    for (std::size_t j = 0; j < k; ++j) {
+        columns[j] = column(field, symbols[j]);
+    }
+
+    AlignedPanel result;
+    result.num_symbols = k;
+    const std::size_t begin = lower_bound(first);
+    const std::size_t end = static_cast<std::size_t>(std::upper_bound(dates_, dates_ + num_dates_, last) - dates_);
+
+    std::vector<double> carry(k, 0.0);
+    std::vector<char> has_carry(k, 0);
+    std::size_t started = 0;  // symbols with a value to carry
+    for (std::size_t t = begin; t < end; ++t) {
+        bool any = false;
+        bool all = true;
+        for (std::size_t j = 0; j < k; ++j) {
+            const bool v = valid(symbols[j], t);
+            any = any || v;
+            all = all && v;
+            if (v && forward_fill) {
+                started += has_carry[j] ? 0 : 1;
+                has_carry[j] = 1;
+                carry[j] = columns[j][t];
+            }
+        }
+        if (!any || !(all || (forward_fill && started == k))) {
+            continue;
+        }
+
+        result.dates.push_back(dates_[t]);
+        for (std::size_t j = 0; j < k; ++j) {
+            result.values.push_back(forward_fill ? carry[j] : columns[j][t]);
+        }
+    }
+    return result;
+}
+
+void write_price_panel(
+    const std::string& path,
+    const std::vector<PanelDate>& dates,
+    const std::vector<std::string>& symbols,
+    const std::vector<std::string>& fields,
+    const double* values
+) {
+    const std::size_t num_dates = dates.size();
+    const std::size_t num_symbols = symbols.size();
+    const std::size_t num_fields = fields.size();
+
+    if (num_fields == 0) {
+        throw std::invalid_argument("price panel needs at least one field");
+    }
+    if (num_dates * num_symbols > 0 && values == nullptr) {
+        throw std::invalid_argument("price panel values are missing");
+    }
+    for (std::size_t t = 1; t < num_dates; ++t) {
+        if (dates[t] <= dates[t - 1]) {
+            throw std::invalid_argument("price panel dates must be strictly increasing");
+        }
+    }
+    for (const std::string& f : fields) {
+        check_name(f, "field");
+    }
+    for (const std::string& s : symbols) {
+        check_name(s, "symbol");
+    }
+
+    // Symbols are stored sorted so readers can binary-search them
+    std::vector<std::size_t> order(num_symbols);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return symbols[a] < symbols[b]; });
+    for (std::size_t i = 1; i < num_symbols; ++i) {
+        if (symbols[order[i]] == symbols[order[i - 1]]) {
+            throw std::invalid_argument("duplicate price panel symbol " + symbols[order[i]]);
+        }
+    }
+
+    const Layout l = layout(num_dates, num_symbols, num_fields);
+    auto value = [&](std::size_t f, std::size_t s, std::size_t t) {
+        return values[(f * num_symbols + s) * num_dates + t];
+    };
+
+    // A bar is valid when every field of it is present
+    std::vector<std::uint64_t> validity(num_symbols * l.validity_words, 0);
+    for (std::size_t i = 0; i < num_symbols; ++i) {
+        std::uint64_t* bits = &validity[i * l.validity_words];
+        for (std::size_t t = 0; t < num_dates; ++t) {
+            bool v = true;
+            for (std::size_t f = 0; f < num_fields && v; ++f) {
+                v = is_finite(value(f, order[i], t));
+            }
+            bits[t / 64] |= static_cast<std::uint64_t>(v) << (t % 64);
+        }
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.header_size = sizeof(FileHeader);
+    header.num_dates = num_dates;
+    header.num_symbols = num_symbols;
+    header.num_fields = num_fields;
+    header.column_stride = l.column_stride;
+
+    // Write next to the target and rename over it, so readers never map a
+    // partial file and existing mappings keep their snapshot
+    const std::string staging = path + ".tmp";
+    try {
+        SectionWriter out(staging);
+        out.write(&header, sizeof(header));
+
+        char name[NAME_WIDTH];
+        for (const std::string& f : fields) {
+            std::memset(name, 0, sizeof(name));
+            std::memcpy(name, f.data(), f.size());
+            out.write(name, sizeof(name));
+        }
+        out.pad();
+        for (std::size_t i = 0; i < num_symbols; ++i) {
+            const std::string& s = symbols[order[i]];
+            std::memset(name, 0, sizeof(name));
+            std::memcpy(name, s.data(), s.size());
+            out.write(name, sizeof(name));
+        }
+        out.pad();
+        out.write(dates.data(), num_dates * sizeof(PanelDate));
+        out.pad();
+        out.write(validity.data(), validity.size() * sizeof(std::uint64_t));
+        out.pad();
+
+        std::vector<double> column(l.column_stride, std::numeric_limits<double>::quiet_NaN());
+        for (std::size_t f = 0; f < num_fields; ++f) {
+            for (std::size_t i = 0; i < num_symbols; ++i) {
+                const std::uint64_t* bits = &validity[i * l.validity_words];
+                for (std::size_t t = 0; t < num_dates; ++t) {
+                    column[t] = (bits[t / 64] >> (t % 64)) & 1u
+                        ? value(f, order[i], t)
+                        : std::numeric_limits<double>::quiet_NaN();
+                }
+                out.write(column.data(), column.size() * sizeof(double));
+            }
+        }
+        out.close(staging);
+    } catch (...) {
+        // The writer is closed by now; leave no staging file behind
+        std::error_code error;
+        std::filesystem::remove(staging, error);
+        throw;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(staging, path, error);
+    if (error) {
+        std::filesystem::remove(staging, error);
+        throw std::runtime_error("cannot replace price panel " + path);
+    }
+}
+
+} // namespace quant
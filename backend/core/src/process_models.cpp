@@ -0,0 +1,96 @@
+/**
+ * @file process_models.cpp
+ * @brief Parameter validation and per-run constants of the process policies.
+ */
+
+#include "process_models.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+GbmProcess::GbmProcess(const SimulationConfig& config)
+    : kernels_(simd_kernels()),
+      // S(t+dt) = S(t) * exp((mu - 0.5*sigma^2)*dt + sigma*sqrt(dt)*Z)
+      drift_((config.mu - 0.5 * config.sigma * config.sigma) * config.dt),
+      diffusion_(config.sigma * std::sqrt(config.dt)) {}
+
+HestonProcess::HestonProcess(const SimulationConfig& config)
+    : kernels_(simd_kernels()) {
+    const HestonParams& p = config.heston;
+    if (p.v0 < 0.0 || p.kappa < 0.0 || p.theta < 0.0 || p.xi < 0.0) {
+        throw std::invalid_argument("Heston v0, kappa, theta and xi must be non-negative");
+    }
+    if (p.rho < -1.0 || p.rho > 1.0) {
+        throw std::invalid_argument("Heston rho must lie in [-1, 1]");
+    }
+
+    mu_ = config.mu;
+    dt_ = config.dt;
+    v0_ = p.v0;
+    kappa_dt_ = p.kappa * config.dt;
+    theta_ = p.theta;
+    xi_ = p.xi;
+    rho_ = p.rho;
+    rho_bar_ = std::sqrt(1.0 - p.rho * p.rho);
+}
+
+MertonProcess::MertonProcess(const SimulationConfig& config)
+    : kernels_(simd_kernels()) {
+    const MertonParams& p = config.merton;
+    if (p.intensity < 0.0 || p.jump_std < 0.0) {
+        throw std::invalid_argument("Merton intensity and jump_std must be non-negative");
+    }
+
+    // Compensate the drift by the mean relative jump so E[S(T)] = s0 e^(mu T)
+    const double mean_jump = std::exp(p.jump_mean + 0.5 * p.jump_std * p.jump_std) - 1.0;
+    drift_ = (config.mu - p.intensity * mean_jump - 0.5 * config.sigma * config.sigma) * config.dt;
+    diffusion_ = config.sigma * std::sqrt(config.dt);
+    jump_mean_ = p.jump_mean;
+    jump_std_ = p.jump_std;
+
+    // Poisson upper tails P(N > k), summed from the far end of the pmf so
+    // small tails keep their relative precision
+    const double rate = p.intensity * config.dt;
+    constexpr int PMF_TERMS = 2 * MAX_JUMPS;
+    double pmf[PMF_TERMS];
+    pmf[0] = std::exp(-rate);
+    for (int k = 1; k < PMF_TERMS; ++k) {
+        pmf[k] = pmf[k - 1] * rate / k;
+    }
+
+    double tail = 0.0;
+    double tails[PMF_TERMS];
+    for (int k = PMF_TERMS - 1; k >= 0; --k) {
+        tails[k] = tail;
+        tail += pmf[k];
+    }
+
+    num_tails_ = 0;
+    while (num_tails_ < MAX_JUMPS && tails[num_tails_] > 1e-300) {
+        tail_[num_tails_] = tails[num_tails_];
+        ++num_tails_;
+    }
+}
+
+GarchProcess::GarchProcess(const SimulationConfig& config)
+    : kernels_(simd_kernels()) {
+    const GarchParams& p = config.garch;
+    if (p.alpha < 0.0 || p.beta < 0.0 || p.long_run_variance < 0.0) {
+        throw std::invalid_argument("GARCH alpha, beta and long_run_variance must be non-negative");
+    }
+    if (p.alpha + p.beta >= 1.0) {
+        throw std::invalid_argument("GARCH alpha + beta must be below 1");
+    }
+
+    const double long_run = p.long_run_variance > 0.0 ? p.long_run_variance : config.sigma * config.sigma;
+
+    mu_dt_ = config.mu * config.dt;
+    h0_ = config.sigma * config.sigma * config.dt;
+    omega_ = (1.0 - p.alpha - p.beta) * long_run * config.dt;
+    alpha_ = p.alpha;
+    beta_ = p.beta;
+}
+
+} // namespace quant
@@ -0,0 +1,111 @@
+/**
+ * @file progressive_simulation.cpp
+ * @brief Implementation of the chunked Monte Carlo run.
+ */
+
+#include "progressive_simulation.h"
+#include "path_simulation.h"
+#include "process_models.h"
+#include "simulation_workspace.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace quant {
+
+ProgressiveSimulation::ProgressiveSimulation(const SimulationConfig& config)
+    : config_(config),
+      seed_(resolve_seed(config.seed)),
+      options_(aggregation_options(config)),
+      shocks_(config.variance_reduction, seed_, config.num_simulations, config.num_steps),
+      final_prices_(config.num_simulations),
+      max_drawdown_(config.num_simulations) {
+    if (!config.export_paths.path.empty()) {
+        throw std::invalid_argument("path export is only supported by run_monte_carlo");
+    }
+    // Fail on bad quantiles or model parameters now rather than mid-run
+    make_quantile_plan(std::max(config.num_simulations, 1), options_);
+    visit_process(config_, [](const auto&) {});
+
+    const std::size_t num_points = static_cast<std::size_t>(StepGrid(config.num_steps, config.output_stride).num_points());
+    mean_sum_.assign(num_points, 0.0);
+    percentile_05_sum_.assign(num_points, 0.0);
+    percentile_95_sum_.assign(num_points, 0.0);
+    bands_sum_.assign(config.quantiles.size() * num_points, 0.0);
+}
+
+int ProgressiveSimulation::run(int num_paths, const CancellationToken* cancel) {
+    const int rounded = (std::max(num_paths, 0) + SIMD_TILE - 1) / SIMD_TILE * SIMD_TILE;
+    const int chunk_paths = std::min(rounded, config_.num_simulations - completed_);
+    if (chunk_paths <= 0) {
+        return 0;
+    }
+
+    SimulationConfig chunk_config = config_;
+    chunk_config.num_simulations = chunk_paths;
+
+    const QuantilePlan plan = make_quantile_plan(chunk_paths, options_);
+    SimulationResult chunk;
+    prepare_result(chunk, StepGrid(config_.num_steps, config_.output_stride), options_);
+
+    bool finished = false;
+    WorkspaceScope scope(nullptr);
+    visit_process(config_, [&](const auto& process) {
+        visit_precision(config_, [&](auto value) {
+            StreamingAggregator<decltype(value)> aggregator(chunk_config, plan, chunk, scope.workspace());
+            finished = simulate_paths(chunk_config, process, seed_, shocks_, aggregator, scope.workspace(),
+                                      completed_, chunk_paths, cancel, &final_prices_[completed_],
+                                      &max_drawdown_[completed_]);
+        });
+    });
+    if (!finished) {
+        return 0;
+    }
+
+    const double weight = static_cast<double>(chunk_paths);
+    for (std::size_t i = 0; i < mean_sum_.size(); ++i) {
+        mean_sum_[i] += weight * chunk.mean_path[i];
+        percentile_05_sum_[i] += weight * chunk.percentile_05[i];
+        percentile_95_sum_[i] += weight * chunk.percentile_95[i];
+    }
+    for (std::size_t i = 0; i < bands_sum_.size(); ++i) {
+        bands_sum_[i] += weight * chunk.percentile_bands[i];
+    }
+
+    completed_ += chunk_paths;
+    return chunk_paths;
+}
+
+SimulationResult ProgressiveSimulation::snapshot() const {
+    if (completed_ == 0) {
+        throw std::logic_error("no paths simulated yet");
+    }
+
+    SimulationResult result;
+    prepare_result(result, StepGrid(config_.num_steps, config_.output_stride), options_);
+
+    const double inv = 1.0 / completed_;
+    for (std::size_t i = 0; i < mean_sum_.size(); ++i) {
+        result.mean_path[i] = mean_sum_[i] * inv;
+        result.percentile_05[i] = percentile_05_sum_[i] * inv;
+        result.percentile_95[i] = percentile_95_sum_[i] * inv;
+    }
+    for (std::size_t i = 0; i < bands_sum_.size(); ++i) {
+        result.percentile_bands[i] = bands_sum_[i] * inv;
+    }
+
+    const QuantilePlan plan = make_quantile_plan(completed_, options_);
+    std::vector<double> final_prices(final_prices_.begin(), final_prices_.begin() + completed_);
+    std::vector<double> max_drawdown(max_drawdown_.begin(), max_drawdown_.begin() + completed_);
+
+    // Before aggregation reorders the final prices
+    const MeanEstimate estimate = shocks_.estimate_mean(final_prices);
+
+    aggregate_final_values(final_prices, options_, plan, result);
+    aggregate_drawdowns(max_drawdown, options_, plan, result);
+    apply_mean_estimate(estimate, config_.variance_reduction, result);
+
+    return result;
+}
+
+} // namespace quant
@@ -0,0 +1,67 @@
+/**
+ * @file risk_metrics.cpp
+ * @brief Implementation of VaR / expected shortfall.
+ */
+
+#include "risk_metrics.h"
+#include "percentiles.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace quant {
+
+int tail_index(double confidence, int n) {
+    return quantile_index(1.0 - confidence, n);
+}
+
+std::vector<int> tail_indices(const std::vector<double>& confidence_levels, int n) {
+    std::vector<int> indices;
+    indices.reserve(confidence_levels.size());
+
+    for (double c : confidence_levels) {
+        if (!(c > 0.0 && c < 1.0)) {
+            throw std::invalid_argument("confidence levels must lie in (0, 1)");
+        }
+        indices.push_back(tail_index(c, n));
+    }
+
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    return indices;
+}
+
+void tail_risk(
+    const double* values,
+    int n,
+    double reference,
+    const std::vector<double>& confidence_levels,
+    double* value_at_risk,
+    double* expected_shortfall
+) {
+    const std::vector<int> indices = tail_indices(confidence_levels, n);
+    if (indices.empty()) {
+        return;
+    }
+
+    // Everything left of a selected position is no larger than it, so one
+    // running sum up to the deepest cut-off gives the mean of every tail
+    std::vector<double> tail_mean(indices.size());
+    double sum = 0.0;
+    int i = 0;
+    for (std::size_t t = 0; t < indices.size(); ++t) {
+        for (; i <= indices[t]; ++i) {
+            sum += values[i];
+        }
+        tail_mean[t] = sum / (indices[t] + 1);
+    }
+
+    for (std::size_t c = 0; c < confidence_levels.size(); ++c) {
+        const int k = tail_index(confidence_levels[c], n);
+        const std::size_t t = std::lower_bound(indices.begin(), indices.end(), k) - indices.begin();
+        value_at_risk[c] = reference - values[k];
+        expected_shortfall[c] = reference - tail_mean[t];
+    }
+}
+
+} // namespace quant
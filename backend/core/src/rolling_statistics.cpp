@@ -0,0 +1,139 @@
+/**
+ * @file rolling_statistics.cpp
+ * @brief Implementation of the rolling statistics and pair signals.
+ */
+
+#include "rolling_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+/**
+ * @brief Window mean and squared-deviation sum after adding value (and
+ *        dropping oldest when replace is set).
+ */
+inline void welford_update(double value, bool replace, double oldest, int count, double& mean, double& m2) {
+    if (replace) {
+        const double old_mean = mean;
+        mean += (value - oldest) / count;
+        m2 += (value - oldest) * (value - mean + oldest - old_mean);
+    } else {
+        const double delta = value - mean;
+        mean += delta / (count + 1);
+        m2 += delta * (value - mean);
+    }
+    m2 = std::max(m2, 0.0);
+}
+
+inline double z_of(double value, double mean, double m2, int count) {
+    const double variance = count > 1 ? m2 / (count - 1) : 0.0;
+    return variance > 0.0 ? (value - mean) / std::sqrt(variance) : 0.0;
+}
+
+} // namespace
+
+RollingStatistics::RollingStatistics(int window) {
+    if (window < 2) {
+        throw std::invalid_argument("rolling window must be at least 2");
+    }
+    buffer_.assign(static_cast<std::size_t>(window), 0.0);
+}
+
+void RollingStatistics::push(double value) {
+    const bool full = ready();
+    welford_update(value, full, buffer_[head_], count_, mean_, m2_);
+
+    buffer_[head_] = value;
+    head_ = (head_ + 1) % window();
+    if (!full) {
+        ++count_;
+        return;
+    }
+
+    // Replacements accumulate rounding; refresh from the buffer now and then
+    if (++updates_ >= window()) {
+        recompute();
+    }
+}
+
+void RollingStatistics::reset() {
+    std::fill(buffer_.begin(), buffer_.end(), 0.0);
+    head_ = 0;
+    count_ = 0;
+    updates_ = 0;
+    mean_ = 0.0;
+    m2_ = 0.0;
+}
+
+double RollingStatistics::variance() const {
+    return count_ > 1 ? m2_ / (count_ - 1) : 0.0;
+}
+
+double RollingStatistics::std_dev() const {
+    return std::sqrt(variance());
+}
+
+double RollingStatistics::z_score(double value) const {
+    return z_of(value, mean_, m2_, count_);
+}
+
+double RollingStatistics::preview_z_score(double value) const {
+    const bool full = ready();
+    double mean = mean_;
+    double m2 = m2_;
+    welford_update(value, full, buffer_[head_], count_, mean, m2);
+    return z_of(value, mean, m2, full ? count_ : count_ + 1);
+}
+
+void RollingStatistics::recompute() {
+    updates_ = 0;
+    double sum = 0.0;
+    for (int i = 0; i < count_; ++i) {
+        sum += buffer_[i];
+    }
+    mean_ = sum / count_;
+    double m2 = 0.0;
+    for (int i = 0; i < count_; ++i) {
+        const double d = buffer_[i] - mean_;
+        m2 += d * d;
+    }
+    m2_ = m2;
+}
+
+PairSignal::PairSignal(double hedge_ratio, int window, const PairsThresholds& thresholds)
+    : hedge_ratio_(hedge_ratio), thresholds_(thresholds), stats_(window) {}
+
+void PairSignal::seed(const double* price_1, const double* price_2, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        update(price_1[i], price_2[i]);
+    }
+}
+
+PairSignalState PairSignal::update(double price_1, double price_2) {
+    state_.spread = price_1 - hedge_ratio_ * price_2;
+    stats_.push(state_.spread);
+    state_.ready = stats_.ready();
+    if (state_.ready) {
+        state_.z_score = stats_.z_score(state_.spread);
+        state_.position = next_pairs_position(state_.position, state_.z_score, thresholds_);
+    }
+    return state_;
+}
+
+PairSignalState PairSignal::preview(double price_1, double price_2) const {
+    PairSignalState next = state_;
+    next.spread = price_1 - hedge_ratio_ * price_2;
+    next.ready = stats_.ready() || stats_.count() + 1 == stats_.window();
+    if (next.ready) {
+        next.z_score = stats_.preview_z_score(next.spread);
+        next.position = next_pairs_position(state_.position, next.z_score, thresholds_);
+    }
+    return next;
+}
+
+} // namespace quant
@@ -0,0 +1,198 @@
+/**
+ * @file scenario_engine.cpp
+ * @brief Implementation of the spot/vol scenario ladder engine.
+ */
+
+#include "scenario_engine.h"
+#include "fast_math.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace quant {
+
+namespace {
+
+/// Positions per parallel task. Fixed so the book summation order never
+/// depends on the number of threads.
+constexpr std::size_t POSITION_BLOCK = 16;
+
+/// Outputs per scenario, in tensor order
+constexpr int NUM_OUTPUTS = 6;
+
+/**
+ * @brief Spot-ladder inputs shared by every position.
+ */
+struct SpotLadder {
+    std::vector<double> spot;     // shocked spot per spot shock
+    std::vector<double> log_spot; // log of it (0 where spot <= 0)
+};
+
+/**
+ * @brief Price and Greeks of one position over the whole grid.
+ *
+ * Writes NUM_OUTPUTS values per scenario into out[output][spot][vol].
+ */
+void price_position(
+    const OptionPosition& position,
+    double risk_free_rate,
+    const SpotLadder& ladder,
+    const ScenarioGrid& grid,
+    double* const* out
+) {
+    const SimdKernels& kernels = simd_kernels();
+    const int num_spot = static_cast<int>(ladder.spot.size());
+    const int num_vol = static_cast<int>(grid.vol_shocks.size());
+
+    std::vector<double> scratch(6 * static_cast<std::size_t>(num_spot));
+    double* signed_d1 = scratch.data();
+    double* signed_d2 = signed_d1 + num_spot;
+    double* d1 = signed_d2 + num_spot;
+    double* n_signed_d1 = d1 + num_spot;
+    double* n_signed_d2 = n_signed_d1 + num_spot;
+    double* n_prime_d1 = n_signed_d2 + num_spot;
+
+    const double k = position.strike;
+    const double t = position.time_to_expiry;
+    const double r = risk_free_rate;
+    const double sign = position.is_call ? 1.0 : -1.0;
+
+    // Shock-independent terms
+    const bool live = t > 0.0 && k > 0.0;
+    const double ts = live ? t : 1.0;
+    const double ks = live ? k : 1.0;
+    const double sqrt_t = std::sqrt(ts);
+    const double discount = fmath::exp(-r * ts);
+    const double discounted_strike = ks * discount;
+    const double log_strike = fmath::log(ks);
+    const double payoff_strike = t > 0.0 ? k * discount : k;
+
+    for (int j = 0; j < num_vol; ++j) {
+        // Terms that depend on the vol shock only
+        const double v = position.volatility + grid.vol_shocks[j];
+        const bool live_vol = live && v > 0.0;
+        const double vs = live_vol ? v : 1.0;
+        const double vol_sqrt_t = vs * sqrt_t;
+        const double inv_vol_sqrt_t = 1.0 / vol_sqrt_t;
+        const double carry = (r + 0.5 * vs * vs) * ts - log_strike;
+
+        // Calls use N(d1), N(d2); puts N(-d1), N(-d2)
+        for (int i = 0; i < num_spot; ++i) {
+            d1[i] = (ladder.log_spot[i] + carry) * inv_vol_sqrt_t;
+            signed_d1[i] = sign * d1[i];
+            signed_d2[i] = sign * (d1[i] - vol_sqrt_t);
+        }
+        kernels.normal_cdf(signed_d1, n_signed_d1, num_spot);
+        kernels.normal_cdf(signed_d2, n_signed_d2, num_spot);
+        kernels.normal_pdf(d1, n_prime_d1, num_spot);
+
+        for (int i = 0; i < num_spot; ++i) {
+            const double s = ladder.spot[i];
+            const bool ok = live_vol && s > 0.0;
+            const double ss = ok ? s : 1.0;
+
+            const double price = sign * (ss * n_signed_d1[i] - discounted_strike * n_signed_d2[i]);
+            const double intrinsic = std::max(sign * (s - payoff_strike), 0.0);
+            const double expiry_delta = position.is_call ? (s > payoff_strike ? 1.0 : 0.0) : (s < payoff_strike ? -1.0 : 0.0);
+            const double decay = -(ss * n_prime_d1[i] * vs) / (2.0 * sqrt_t);
+            const double rate_term = -sign * r * discounted_strike * n_signed_d2[i];
+
+            const std::size_t o = static_cast<std::size_t>(i) * num_vol + j;
+            out[0][o] = ok ? price : intrinsic;
+            out[1][o] = ok ? sign * n_signed_d1[i] : expiry_delta;
+            out[2][o] = ok ? n_prime_d1[i] / (ss * vol_sqrt_t) : 0.0;
+            out[3][o] = ok ? ss * n_prime_d1[i] * sqrt_t * 0.01 : 0.0;
+            out[4][o] = ok ? (decay + rate_term) / 365.0 : 0.0;
+            out[5][o] = ok ? sign * ks * ts * discount * n_signed_d2[i] * 0.01 : 0.0;
+        }
+    }
+}
+
+} // namespace
+
+ScenarioResult run_scenario_grid(
+    const std::vector<OptionPosition>& positions,
+    double spot,
+    double risk_free_rate,
+    const ScenarioGrid& grid,
+    bool per_position,
+    int num_threads
+) {
+    ScenarioResult result;
+    result.num_positions = static_cast<int>(positions.size());
+    result.num_spot = static_cast<int>(grid.spot_shocks.size());
+    result.num_vol = static_cast<int>(grid.vol_shocks.size());
+
+    const std::size_t num_scenarios = grid.spot_shocks.size() * grid.vol_shocks.size();
+    const std::size_t num_positions = positions.size();
+
+    std::vector<double>* tensors[NUM_OUTPUTS] = {
+        &result.price, &result.delta, &result.gamma, &result.vega, &result.theta, &result.rho
+    };
+    std::vector<double>* book[NUM_OUTPUTS] = {
+        &result.book_price, &result.book_delta, &result.book_gamma,
+        &result.book_vega, &result.book_theta, &result.book_rho
+    };
+    for (int o = 0; o < NUM_OUTPUTS; ++o) {
+        if (per_position) {
+            tensors[o]->resize(num_positions * num_scenarios);
+        }
+        book[o]->assign(num_scenarios, 0.0);
+    }
+
+    // Spot ladder is shared by every position
+    SpotLadder ladder;
+    for (double shock : grid.spot_shocks) {
+        const double s = spot * (1.0 + shock);
+        ladder.spot.push_back(s);
+        ladder.log_spot.push_back(s > 0.0 ? fmath::log(s) : 0.0);
+    }
+
+    const std::size_t num_blocks = (num_positions + POSITION_BLOCK - 1) / POSITION_BLOCK;
+    const std::size_t partial_size = NUM_OUTPUTS * num_scenarios;
+    std::vector<double> partials(num_blocks * partial_size, 0.0);
+
+    ThreadPool::instance().parallel_for(num_blocks, resolve_num_threads(num_threads), [&](std::size_t block) {
+        const std::size_t begin = block * POSITION_BLOCK;
+        const std::size_t end = std::min(begin + POSITION_BLOCK, num_positions);
+        double* partial = partials.data() + block * partial_size;
+
+        std::vector<double> local(per_position ? 0 : partial_size);
+
+        for (std::size_t p = begin; p < end; ++p) {
+            double* out[NUM_OUTPUTS];
+            for (int o = 0; o < NUM_OUTPUTS; ++o) {
+                out[o] = per_position ? tensors[o]->data() + p * num_scenarios
+                                      : local.data() + o * num_scenarios;
+            }
+
+            price_position(positions[p], risk_free_rate, ladder, grid, out);
+
+            // Book partials in position order within the block
+            const double q = positions[p].quantity;
+            for (int o = 0; o < NUM_OUTPUTS; ++o) {
+                double* acc = partial + o * num_scenarios;
+                for (std::size_t c = 0; c < num_scenarios; ++c) {
+                    acc[c] += q * out[o][c];
+                }
+            }
+        }
+    });
+
+    // Combine block partials in block order
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        const double* partial = partials.data() + block * partial_size;
+        for (int o = 0; o < NUM_OUTPUTS; ++o) {
+            std::vector<double>& acc = *book[o];
+            for (std::size_t c = 0; c < num_scenarios; ++c) {
+                acc[c] += partial[o * num_scenarios + c];
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace quant
@@ -0,0 +1,132 @@
+/**
+ * @file simulation_workspace.cpp
+ * @brief Implementation of the reusable simulation arena.
+ */
+
+#include "simulation_workspace.h"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace quant {
+
+namespace {
+
+/// Bytes rounded up to whole blocks of WORKSPACE_ALIGNMENT
+std::size_t aligned_size(std::size_t bytes) {
+    return (bytes + WORKSPACE_ALIGNMENT - 1) / WORKSPACE_ALIGNMENT * WORKSPACE_ALIGNMENT;
+}
+
+void* aligned_new(std::size_t bytes) {
+    return ::operator new(bytes, std::align_val_t{WORKSPACE_ALIGNMENT});
+}
+
+} // namespace
+
+void SimulationWorkspace::AlignedDelete::operator()(void* p) const {
+    ::operator delete(p, std::align_val_t{WORKSPACE_ALIGNMENT});
+}
+
+SimulationWorkspace::SimulationWorkspace(std::size_t retain_bytes) : retain_bytes_(retain_bytes) {}
+
+SimulationWorkspace::~SimulationWorkspace() = default;
+
+SimulationWorkspace& SimulationWorkspace::local() {
+    thread_local SimulationWorkspace workspace;
+    return workspace;
+}
+
+SimulationWorkspace::Lease::Lease(SimulationWorkspace& workspace) : workspace_(workspace) {
+    workspace_.begin();
+}
+
+SimulationWorkspace::Lease::~Lease() {
+    workspace_.end();
+}
+
+void SimulationWorkspace::begin() {
+    if (in_use_.exchange(true, std::memory_order_acq_rel)) {
+        throw std::runtime_error("SimulationWorkspace is already in use by another run");
+    }
+    // One buffer large enough for the last run, so a repeat fits entirely
+    if (last_run_bytes_ > capacity_) {
+        try {
+            resize_buffer(last_run_bytes_);
+        } catch (...) {
+            in_use_.store(false, std::memory_order_release);
+            throw;
+        }
+    }
+    offset_ = 0;
+}
+
+void SimulationWorkspace::end() noexcept {
+    last_run_bytes_ = offset_ + overflow_bytes_;
+    last_overflow_count_ = overflow_.size();
+    high_water_ = std::max(high_water_, last_run_bytes_);
+
+    overflow_.clear();
+    overflow_bytes_ = 0;
+    offset_ = 0;
+    if (capacity_ > retain_bytes_) {
+        buffer_.reset();
+        capacity_ = 0;
+    }
+    in_use_.store(false, std::memory_order_release);
+}
+
+void* SimulationWorkspace::allocate_bytes(std::size_t bytes) {
+    bytes = aligned_size(std::max<std::size_t>(bytes, 1));
+    if (capacity_ - offset_ >= bytes) {
+        void* block = static_cast<char*>(buffer_.get()) + offset_;
+        offset_ += bytes;
+        return block;
+    }
+    overflow_.emplace_back(aligned_new(bytes));
+    overflow_bytes_ += bytes;
+    return overflow_.back().get();
+}
+
+void SimulationWorkspace::resize_buffer(std::size_t bytes) {
+    buffer_.reset();
+    capacity_ = 0;
+    buffer_.reset(aligned_new(aligned_size(bytes)));
+    capacity_ = aligned_size(bytes);
+}
+
+void SimulationWorkspace::reserve(std::size_t bytes) {
+    if (in_use()) {
+        throw std::runtime_error("cannot resize a SimulationWorkspace during a run");
+    }
+    if (bytes > capacity_) {
+        resize_buffer(bytes);
+    }
+}
+
+void SimulationWorkspace::release() {
+    if (in_use()) {
+        throw std::runtime_error("cannot release a SimulationWorkspace during a run");
+    }
+    buffer_.reset();
+    capacity_ = 0;
+    last_run_bytes_ = 0;
+}
+
+WorkspaceScope::WorkspaceScope(SimulationWorkspace* workspace)
+    : workspace_(select(workspace, own_)), lease_(workspace_) {}
+
+SimulationWorkspace& WorkspaceScope::select(SimulationWorkspace* workspace,
+                                            std::unique_ptr<SimulationWorkspace>& own) {
+    if (workspace != nullptr) {
+        return *workspace;
+    }
+    SimulationWorkspace& local = SimulationWorkspace::local();
+    if (!local.in_use()) {
+        return local;
+    }
+    own = std::make_unique<SimulationWorkspace>();
+    return *own;
+}
+
+} // namespace quant
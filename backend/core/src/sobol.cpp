@@ -0,0 +1,99 @@
+/**
+ * @file sobol.cpp
+ * @brief Sobol direction numbers and point evaluation.
+ */
+
+#include "sobol.h"
+
+#include <array>
+
+namespace quant {
+
+namespace {
+
+/// Bits per coordinate
+constexpr int SOBOL_BITS = 32;
+
+/**
+ * @brief Primitive polynomial and initial direction numbers of one
+ *        dimension (Joe & Kuo, new-joe-kuo-6.21201).
+ */
+struct SobolDimension {
+    int degree;             // s
+    uint32_t coefficients;  // a: inner coefficients of the polynomial
+    uint32_t initial[6];    // m_1 .. m_s
+};
+
+/// Dimensions 2 .. SOBOL_MAX_DIMS; the first is the van der Corput sequence
+constexpr SobolDimension DIMENSIONS[SOBOL_MAX_DIMS - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+};
+
+using DirectionTable = std::array<std::array<uint32_t, SOBOL_BITS>, SOBOL_MAX_DIMS>;
+
+/**
+ * @brief Direction numbers v[dim][bit], scaled to 32-bit fractions.
+ */
+DirectionTable make_directions() {
+    DirectionTable v{};
+
+    for (int bit = 0; bit < SOBOL_BITS; ++bit) {
+        v[0][bit] = 1u << (SOBOL_BITS - 1 - bit);
+    }
+
+    for (int dim = 1; dim < SOBOL_MAX_DIMS; ++dim) {
+        const SobolDimension& d = DIMENSIONS[dim - 1];
+        const int s = d.degree;
+        std::array<uint32_t, SOBOL_BITS>& vd = v[dim];
+
+        for (int bit = 0; bit < s; ++bit) {
+            vd[bit] = d.initial[bit] << (SOBOL_BITS - 1 - bit);
+        }
+
+        // v_i = v_{i-s} ^ (v_{i-s} >> s) ^ sum_k a_k v_{i-k}
+        for (int bit = s; bit < SOBOL_BITS; ++bit) {
+            uint32_t value = vd[bit - s] ^ (vd[bit - s] >> s);
+            for (int k = 1; k < s; ++k) {
+                if ((d.coefficients >> (s - 1 - k)) & 1u) {
+                    value ^= vd[bit - k];
+                }
+            }
+            vd[bit] = value;
+        }
+    }
+
+    return v;
+}
+
+const DirectionTable& directions() {
+    static const DirectionTable table = make_directions();
+    return table;
+}
+
+} // namespace
+
+uint32_t sobol_coordinate(uint32_t index, int dim) {
+    const std::array<uint32_t, SOBOL_BITS>& v = directions()[dim];
+
+    uint32_t x = 0;
+    for (int bit = 0; index != 0; ++bit, index >>= 1) {
+        x ^= (index & 1u) ? v[bit] : 0u;
+    }
+    return x;
+}
+
+} // namespace quant
@@ -0,0 +1,275 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementation of the persistent work-stealing worker pool.
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+/// Pool and worker index of the current thread (nullptr outside workers)
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local std::size_t current_worker = 0;
+
+thread_local TaskPriority current_priority = TaskPriority::Interactive;
+
+/**
+ * @brief Shared state of one parallel_for call.
+ *
+ * Held by shared_ptr so helpers that are dequeued after the loop has
+ * already finished can still safely observe that there is nothing left.
+ */
+struct LoopState {
+    const std::function<void(std::size_t)>* fn = nullptr;
+    std::size_t num_tasks = 0;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::exception_ptr error;
+
+    /// Claim and run tasks until none are left
+    void run() {
+        for (;;) {
+            const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= num_tasks) {
+                return;
+            }
+
+            try {
+                (*fn)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == num_tasks) {
+                std::lock_guard<std::mutex> lock(mutex);
+                cv.notify_all();
+            }
+        }
+    }
+};
+
+bool is_cpu_directory(const std::string& name) {
+    return name.size() > 3 && name.compare(0, 3, "cpu") == 0 &&
+           std::all_of(name.begin() + 3, name.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned num_workers) {
+    if (num_workers == 0) {
+        num_workers = physical_core_count();
+    }
+
+    queues_.reserve(num_workers);
+    for (unsigned i = 0; i < num_workers; ++i) {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+
+    workers_.reserve(num_workers);
+    for (unsigned i = 0; i < num_workers; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    sleep_cv_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::push(Task task) {
+    // A worker keeps its own work local; everyone else goes through the injector
+    TaskQueue& queue = current_pool == this ? *queues_[current_worker] : injector_;
+    const auto priority = static_cast<std::size_t>(task.priority);
+
+    // Counted before it is visible, so pending_ never undercounts and a
+    // worker cannot go to sleep past it
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks[priority].push_back(std::move(task));
+    }
+    sleep_cv_.notify_one();
+}
+
+bool ThreadPool::try_pop(std::size_t index, Task& task) {
+    const std::size_t n = queues_.size();
+
+    auto take = [&](TaskQueue& queue, std::size_t priority, bool back) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        std::deque<Task>& tasks = queue.tasks[priority];
+        if (tasks.empty()) {
+            return false;
+        }
+        if (back) {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        } else {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    for (std::size_t priority = 0; priority < NUM_TASK_PRIORITIES; ++priority) {
+        if (take(*queues_[index], priority, true) || take(injector_, priority, false)) {
+            return true;
+        }
+        // Steal the oldest (typically largest-grained) work of the others
+        for (std::size_t k = 1; k < n; ++k) {
+            if (take(*queues_[(index + k) % n], priority, false)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadPool::worker_loop(std::size_t index) {
+    current_pool = this;
+    current_worker = index;
+
+    for (;;) {
+        Task task;
+        if (try_pop(index, task)) {
+            PriorityScope scope(task.priority);
+            task.fn();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this] {
+            return stopping_ || pending_.load(std::memory_order_relaxed) > 0;
+        });
+        if (stopping_ && pending_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallel_for(
+    std::size_t num_tasks,
+    unsigned max_threads,
+    const std::function<void(std::size_t)>& fn
+) {
+    if (num_tasks == 0) {
+        return;
+    }
+
+    unsigned threads = max_threads == 0 ? concurrency() : std::min(max_threads, concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, num_tasks));
+
+    // Serial fast path: no synchronization at all
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < num_tasks; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    auto state = std::make_shared<LoopState>();
+    state->fn = &fn;
+    state->num_tasks = num_tasks;
+
+    const TaskPriority priority = PriorityScope::current();
+    for (unsigned i = 1; i < threads; ++i) {
+        push(Task{[state] { state->run(); }, priority});
+    }
+
+    // Calling thread works too
+    state->run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done.load(std::memory_order_acquire) == num_tasks; });
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+void ThreadPool::submit(std::function<void()> job, TaskPriority priority) {
+    push(Task{std::move(job), priority});
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+PriorityScope::PriorityScope(TaskPriority priority) : previous_(current_priority) {
+    current_priority = priority;
+}
+
+PriorityScope::~PriorityScope() {
+    current_priority = previous_;
+}
+
+TaskPriority PriorityScope::current() {
+    return current_priority;
+}
+
+unsigned physical_core_count() {
+    namespace fs = std::filesystem;
+
+    const unsigned logical = std::max(1u, std::thread::hardware_concurrency());
+
+    // (package, core) pairs of the online CPUs; offline ones have no topology
+    std::set<std::pair<int, int>> cores;
+    std::error_code error;
+    for (fs::directory_iterator it("/sys/devices/system/cpu", error), end; !error && it != end;
+         it.increment(error)) {
+        if (!is_cpu_directory(it->path().filename().string())) {
+            continue;
+        }
+        std::ifstream package(it->path() / "topology" / "physical_package_id");
+        std::ifstream core(it->path() / "topology" / "core_id");
+        int package_id = 0;
+        int core_id = 0;
+        if (package >> package_id && core >> core_id) {
+            cores.emplace(package_id, core_id);
+        }
+    }
+
+    if (cores.empty()) {
+        return logical;
+    }
+    return std::min(static_cast<unsigned>(cores.size()), logical);
+}
+
+unsigned resolve_num_threads(int num_threads) {
+    if (num_threads <= 0) {
+        return ThreadPool::instance().concurrency();
+    }
+    return static_cast<unsigned>(num_threads);
+}
+
+} // namespace quant
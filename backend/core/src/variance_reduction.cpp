@@ -0,0 +1,330 @@
+/**
+ * @file variance_reduction.cpp
+ * @brief Implementation of the variance-reduction shock generators and
+ *        mean estimators.
+ */
+
+#include "variance_reduction.h"
+#include "fast_math.h"
+#include "rng.h"
+#include "simd_kernels.h"
+#include "sobol.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <utility>
+
+namespace quant {
+
+namespace {
+
+/// Most steps generate() produces per call
+constexpr int MAX_BLOCK_STEPS = 8;
+
+/// Philox stream of the normals between Sobol knots (stream 0 is unused
+/// in Sobol mode, so the fine and coarse draws never overlap)
+constexpr uint32_t BRIDGE_STREAM = 1;
+
+/// Philox stream reserved for the digital shifts
+constexpr uint32_t SHIFT_STREAM = 0xFFFFFFFFu;
+
+/**
+ * @brief Sample mean and unbiased variance of values[0..n).
+ */
+std::pair<double, double> mean_and_variance(const double* values, int n) {
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        sum += values[i];
+    }
+    const double mean = sum / n;
+
+    double sq_sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double diff = values[i] - mean;
+        sq_sum += diff * diff;
+    }
+    return {mean, n > 1 ? sq_sum / (n - 1) : 0.0};
+}
+
+/**
+ * @brief Plain mean with standard error sqrt(var / n).
+ */
+MeanEstimate plain_estimate(const double* values, int n) {
+    const auto [mean, variance] = mean_and_variance(values, n);
+    return {mean, std::sqrt(variance / n)};
+}
+
+/**
+ * @brief Mean of all paths; standard error from the spread of the means
+ *        of `groups` interleaved groups (path i belongs to group i % groups).
+ */
+MeanEstimate grouped_estimate(const double* values, int n, int groups) {
+    groups = std::min(groups, n);
+
+    std::vector<double> group_sum(groups, 0.0);
+    std::vector<int> group_size(groups, 0);
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        group_sum[i % groups] += values[i];
+        group_size[i % groups] += 1;
+        sum += values[i];
+    }
+
+    for (int g = 0; g < groups; ++g) {
+        group_sum[g] /= group_size[g];
+    }
+    const double group_variance = mean_and_variance(group_sum.data(), groups).second;
+
+    return {sum / n, std::sqrt(group_variance / groups)};
+}
+
+} // namespace
+
+void apply_mean_estimate(const MeanEstimate& estimate, VarianceReduction mode, SimulationResult& result) {
+    result.standard_error = estimate.standard_error;
+    if (mode == VarianceReduction::ControlVariate) {
+        result.final_price_mean = estimate.mean;
+    }
+}
+
+BrownianBridge make_brownian_bridge(int num_steps, int max_knots) {
+    BrownianBridge bridge;
+    const int k = std::max(1, std::min(num_steps, max_knots));
+    bridge.num_knots = k;
+
+    // Floors of (m + 1) * N / K are strictly increasing for K <= N
+    for (int m = 0; m < k; ++m) {
+        bridge.knot_step.push_back(static_cast<int>(static_cast<long long>(m + 1) * num_steps / k));
+    }
+
+    auto time = [&](int knot) { return knot < 0 ? 0.0 : static_cast<double>(bridge.knot_step[knot]); };
+
+    // Terminal knot from W(0) = 0
+    bridge.node.push_back(k - 1);
+    bridge.left.push_back(-1);
+    bridge.right.push_back(-1);
+    bridge.left_weight.push_back(0.0);
+    bridge.right_weight.push_back(0.0);
+    bridge.stddev.push_back(std::sqrt(time(k - 1)));
+
+    // Then midpoints, breadth first
+    std::deque<std::pair<int, int>> intervals = {{-1, k - 1}};
+    while (!intervals.empty()) {
+        const auto [l, r] = intervals.front();
+        intervals.pop_front();
+        if (r - l < 2) {
+            continue;
+        }
+
+        const int m = (l + r) / 2;
+        const double tl = time(l);
+        const double tm = time(m);
+        const double tr = time(r);
+
+        bridge.node.push_back(m);
+        bridge.left.push_back(l);
+        bridge.right.push_back(r);
+        bridge.left_weight.push_back((tr - tm) / (tr - tl));
+        bridge.right_weight.push_back((tm - tl) / (tr - tl));
+        bridge.stddev.push_back(std::sqrt((tm - tl) * (tr - tm) / (tr - tl)));
+
+        intervals.emplace_back(l, m);
+        intervals.emplace_back(m, r);
+    }
+
+    bridge.next_knot.assign(num_steps + 1, 0);
+    for (int step = 1, m = 0; step <= num_steps; ++step) {
+        while (bridge.knot_step[m] < step) {
+            ++m;
+        }
+        bridge.next_knot[step] = m;
+    }
+
+    return bridge;
+}
+
+ShockGenerator::ShockGenerator(
+    VarianceReduction mode,
+    uint64_t key,
+    int num_simulations,
+    int num_steps
+)
+    : mode_(mode), key_(key) {
+    const std::size_t n = static_cast<std::size_t>(num_simulations);
+
+    if (mode_ == VarianceReduction::ControlVariate) {
+        shock_sum_.assign(n, 0.0);
+    }
+
+    if (mode_ == VarianceReduction::Sobol && num_steps > 0) {
+        bridge_ = make_brownian_bridge(num_steps, SOBOL_MAX_DIMS);
+        const int k = bridge_.num_knots;
+
+        shifts_.resize(static_cast<std::size_t>(SOBOL_REPLICATES) * k);
+        for (int r = 0; r < SOBOL_REPLICATES; ++r) {
+            for (int d = 0; d < k; ++d) {
+                const Philox4x32::Block bits = Philox4x32::generate(
+                    {static_cast<uint32_t>(d), SHIFT_STREAM, static_cast<uint32_t>(r), 0}, key_);
+                shifts_[static_cast<std::size_t>(r) * k + d] = bits[0];
+            }
+        }
+
+        knots_.resize(n * k);
+        brownian_.resize(n);
+    }
+}
+
+void ShockGenerator::sobol_knots(int sim0, int lanes) {
+    const int k = bridge_.num_knots;
+    double z[SOBOL_MAX_DIMS];
+
+    for (int lane = 0; lane < lanes; ++lane) {
+        const int path = sim0 + lane;
+        const int replicate = path % SOBOL_REPLICATES;
+        const uint32_t index = static_cast<uint32_t>(path / SOBOL_REPLICATES);
+        const uint32_t* shift = &shifts_[static_cast<std::size_t>(replicate) * k];
+
+        // Midpoint of the shifted cell, in (0, 1)
+        for (int d = 0; d < k; ++d) {
+            const uint32_t bits = sobol_coordinate(index, d) ^ shift[d];
+            z[d] = fmath::normal_quantile((static_cast<double>(bits) + 0.5) * (1.0 / 4294967296.0));
+        }
+
+        double* w = &knots_[static_cast<std::size_t>(path) * k];
+        for (int i = 0; i < k; ++i) {
+            const int l = bridge_.left[i];
+            const int r = bridge_.right[i];
+            const double mean = (l < 0 ? 0.0 : bridge_.left_weight[i] * w[l])
+                              + (r < 0 ? 0.0 : bridge_.right_weight[i] * w[r]);
+            w[bridge_.node[i]] = mean + bridge_.stddev[i] * z[i];
+        }
+
+        brownian_[path] = 0.0;
+    }
+}
+
+void ShockGenerator::generate(int sim0, int lanes, int first, int count, double* z) {
+    const SimdKernels& kernels = simd_kernels();
+    const int first_pair = (first - 1) / 2;
+    const int num_pairs = (count + 1) / 2;
+
+    switch (mode_) {
+    case VarianceReduction::None:
+        kernels.normals(key_, static_cast<uint64_t>(sim0), lanes, first_pair, num_pairs, 0, z);
+        break;
+
+    case VarianceReduction::Antithetic: {
+        // Pair k of paths (2k, 2k + 1) shares base draws of path k. Tiles
+        // start on even paths, so pairs never straddle two tiles.
+        alignas(64) double base[MAX_BLOCK_STEPS * SIMD_TILE];
+        kernels.normals(key_, static_cast<uint64_t>(sim0 / 2), (lanes + 1) / 2,
+                        first_pair, num_pairs, 0, base);
+        for (int j = 0; j < count; ++j) {
+            const double* b = base + j * SIMD_TILE;
+            double* row = z + j * SIMD_TILE;
+            for (int lane = 0; lane < lanes; ++lane) {
+                row[lane] = (lane & 1) ? -b[lane / 2] : b[lane / 2];
+            }
+        }
+        break;
+    }
+
+    case VarianceReduction::ControlVariate:
+        kernels.normals(key_, static_cast<uint64_t>(sim0), lanes, first_pair, num_pairs, 0, z);
+        if (first == 1) {
+            std::fill(&shock_sum_[sim0], &shock_sum_[sim0] + lanes, 0.0);
+        }
+        for (int j = 0; j < count; ++j) {
+            const double* row = z + j * SIMD_TILE;
+            for (int lane = 0; lane < lanes; ++lane) {
+                shock_sum_[sim0 + lane] += row[lane];
+            }
+        }
+        break;
+
+    case VarianceReduction::Sobol: {
+        if (first == 1) {
+            sobol_knots(sim0, lanes);
+        }
+
+        // Fine draws eps fill each knot interval with a bridge from the
+        // current W to the knot: with L steps left to the knot,
+        // W_next = W + (W_knot - W) / L + sqrt((L - 1) / L) * eps
+        kernels.normals(key_, static_cast<uint64_t>(sim0), lanes, first_pair, num_pairs,
+                        BRIDGE_STREAM, z);
+
+        const int k = bridge_.num_knots;
+        for (int j = 0; j < count; ++j) {
+            const int step = first + j;
+            const int knot = bridge_.next_knot[step];
+            const double remaining = static_cast<double>(bridge_.knot_step[knot] - step + 1);
+            const double pull = 1.0 / remaining;
+            const double spread = std::sqrt((remaining - 1.0) / remaining);
+
+            double* row = z + j * SIMD_TILE;
+            for (int lane = 0; lane < lanes; ++lane) {
+                const std::size_t path = static_cast<std::size_t>(sim0 + lane);
+                const double w = brownian_[path];
+                const double target = knots_[path * k + knot];
+                const double next = w + (target - w) * pull + spread * row[lane];
+                row[lane] = next - w;
+                brownian_[path] = next;
+            }
+        }
+        break;
+    }
+    }
+}
+
+MeanEstimate ShockGenerator::estimate_mean(const double* final_prices, int n) const {
+
+    switch (mode_) {
+    case VarianceReduction::Antithetic:
+        // Pair means are independent; an odd last path only enters the mean
+        if (n >= 4) {
+            std::vector<double> pairs(n / 2);
+            double sum = 0.0;
+            for (int i = 0; i < n / 2; ++i) {
+                pairs[i] = 0.5 * (final_prices[2 * i] + final_prices[2 * i + 1]);
+            }
+            for (int i = 0; i < n; ++i) {
+                sum += final_prices[i];
+            }
+            const double pair_variance = mean_and_variance(pairs.data(), n / 2).second;
+            return {sum / n, std::sqrt(pair_variance / (n / 2))};
+        }
+        return plain_estimate(final_prices, n);
+
+    case VarianceReduction::ControlVariate: {
+        // The summed shocks W have known mean 0 and variance num_steps
+        const double price_mean = mean_and_variance(final_prices, n).first;
+        const auto [shock_mean, shock_variance] = mean_and_variance(shock_sum_.data(), n);
+
+        double covariance = 0.0;
+        for (int i = 0; i < n; ++i) {
+            covariance += (final_prices[i] - price_mean) * (shock_sum_[i] - shock_mean);
+        }
+        covariance = n > 1 ? covariance / (n - 1) : 0.0;
+        const double b = shock_variance > 0.0 ? covariance / shock_variance : 0.0;
+
+        double sq_sum = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double residual = (final_prices[i] - price_mean) - b * (shock_sum_[i] - shock_mean);
+            sq_sum += residual * residual;
+        }
+        const double residual_variance = n > 2 ? sq_sum / (n - 2) : 0.0;
+
+        return {price_mean - b * shock_mean, std::sqrt(residual_variance / n)};
+    }
+
+    case VarianceReduction::Sobol:
+        return grouped_estimate(final_prices, n, SOBOL_REPLICATES);
+
+    case VarianceReduction::None:
+    default:
+        return plain_estimate(final_prices, n);
+    }
+}
+
+} // namespace quant
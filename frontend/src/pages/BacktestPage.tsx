@@ -16,6 +16,7 @@ interface SensitivityPoint {
     exit_z: number;
     sharpe_ratio: number;
     total_return: number;
+    max_drawdown: number;
     win_rate: number;
     trades: number;
 }
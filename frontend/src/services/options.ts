@@ -23,3 +23,44 @@ export async function getIVSurface(ticker: string): Promise<IVSurfaceResponse> {
     const response = await api.get<IVSurfaceResponse>(`/options/iv/${ticker}`);
     return response.data;
 }
+
+export interface AmericanContract {
+    strike: number;
+    days_to_expiry: number;
+    volatility: number;
+    is_call?: boolean;
+}
+
+/** American options on one underlying, priced by Longstaff-Schwartz */
+export interface AmericanChainRequest {
+    spot: number;
+    risk_free_rate?: number;
+    /** Continuous dividend yield */
+    dividend_yield?: number;
+    contracts: AmericanContract[];
+    /** Paths per contract */
+    num_simulations?: number;
+    /** Exercise dates up to expiry */
+    exercise_dates?: number;
+    seed?: number;
+}
+
+/** One entry per contract, Greeks in the units of IVSurfaceResponse */
+export interface AmericanChainResponse {
+    price: number[];
+    standard_error: number[];
+    delta: number[];
+    gamma: number[];
+    vega: number[];
+    theta: number[];
+    rho: number[];
+    count: number;
+}
+
+/**
+ * Price an American option chain in one call.
+ */
+export async function priceAmericanChain(request: AmericanChainRequest): Promise<AmericanChainResponse> {
+    const response = await api.post<AmericanChainResponse>("/options/american", request);
+    return response.data;
+}
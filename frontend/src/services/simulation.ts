@@ -25,6 +25,50 @@ export interface SimulationRequest {
     histogram_bins?: number;
     /** Random seed for reproducibility (optional) */
     seed?: number;
+    /** Quantiles in (0, 1) for the percentile bands (optional) */
+    quantiles?: number[];
+    /** Confidence levels in (0, 1) for VaR/CVaR/drawdown (optional) */
+    confidence_levels?: number[];
+    /** Also return every path's final price (optional) */
+    include_final_prices?: boolean;
+    /** Shock scheme (default "none") */
+    variance_reduction?: VarianceReduction;
+    /** Standard error of the mean final price to aim for; overrides num_simulations */
+    target_standard_error?: number;
+    /** Return the paths at every k-th step plus the final one (default 1) */
+    output_stride?: number;
+}
+
+export type VarianceReduction = "none" | "antithetic" | "control_variate" | "sobol";
+
+/** One simulation per ticker; every other field applies to all of them */
+export interface BatchSimulationRequest
+    extends Omit<SimulationRequest, "ticker" | "target_standard_error"> {
+    /** Tickers to simulate (up to 100) */
+    tickers: string[];
+}
+
+export interface PortfolioSimulationRequest {
+    /** Tickers held in the portfolio */
+    tickers: string[];
+    /** Fraction of initial_value held in each ticker (same order) */
+    weights: number[];
+    /** Portfolio value at the start of the simulation */
+    initial_value?: number;
+    /** Number of simulation paths (100-100,000) */
+    num_simulations?: number;
+    /** Number of time steps to project (trading days) */
+    num_steps?: number;
+    /** Number of histogram bins */
+    histogram_bins?: number;
+    /** Random seed for reproducibility (optional) */
+    seed?: number;
+    /** Quantiles in (0, 1) for the percentile bands (optional) */
+    quantiles?: number[];
+    /** Confidence levels in (0, 1) for VaR/CVaR/drawdown (optional) */
+    confidence_levels?: number[];
+    /** Also return every path's final value (optional) */
+    include_final_prices?: boolean;
 }
 
 // ==============================================================================
@@ -35,8 +79,10 @@ export interface SimulationParameters {
     s0: number;
     mu: number;
     sigma: number;
+    /** Paths simulated (chosen by the server for a target standard error) */
     num_simulations: number;
     num_steps: number;
+    variance_reduction: VarianceReduction;
     data_points_used: number;
     analysis_period: {
         start: string;
@@ -49,6 +95,8 @@ export interface FinalPriceStats {
     std: number;
     min: number;
     max: number;
+    /** Standard error of the mean final price */
+    standard_error: number;
 }
 
 export interface HistogramData {
@@ -56,20 +104,43 @@ export interface HistogramData {
     edges: number[];
 }
 
+export interface PercentileBands {
+    /** Quantile of each band */
+    quantiles: number[];
+    /** One price path per quantile */
+    paths: number[][];
+}
+
+export interface MaxDrawdownStats {
+    /** Mean per-path maximum drawdown (fraction of running peak) */
+    mean: number;
+    /** Maximum drawdown quantile at each confidence level */
+    quantiles: number[];
+}
+
 export interface TailRiskMetrics {
     var_95: number;
     var_99: number;
     cvar_95: number;
     cvar_99: number;
+    confidence_levels: number[];
+    var: number[];
+    cvar: number[];
+    probability_of_loss: number;
+    max_drawdown: MaxDrawdownStats;
 }
 
 export interface SimulationResults {
+    /** Step index of each point of the paths and bands */
+    steps: number[];
     mean_path: number[];
     percentile_05: number[];
     percentile_95: number[];
+    percentile_bands: PercentileBands;
     histogram: HistogramData;
     final_price: FinalPriceStats;
     tail_risk: TailRiskMetrics;
+    final_prices?: number[] | null;
 }
 
 export interface SimulationResponse {
@@ -78,6 +149,50 @@ export interface SimulationResponse {
     results: SimulationResults;
 }
 
+export interface SimulationProgress {
+    completed_paths: number;
+    total_paths: number;
+    done: boolean;
+}
+
+/** Snapshot over the paths completed so far */
+export interface ProgressiveSimulationResponse extends SimulationResponse {
+    progress: SimulationProgress;
+}
+
+export type SimulationStreamMessage =
+    | ({ type: "progress" | "complete" } & ProgressiveSimulationResponse)
+    | { type: "cancelled" }
+    | { type: "error"; detail: string };
+
+export interface BatchSimulationResponse {
+    /** One result per ticker with usable price data, in request order */
+    results: SimulationResponse[];
+    /** Why each remaining ticker could not be simulated */
+    errors: Record<string, string>;
+}
+
+export interface PortfolioSimulationParameters {
+    initial_value: number;
+    /** Annualized mean log return per ticker */
+    mu: number[];
+    /** Annualized volatility per ticker */
+    sigma: number[];
+    /** Correlation matrix of daily log returns */
+    correlation: number[][];
+    num_simulations: number;
+    num_steps: number;
+}
+
+export interface PortfolioSimulationResponse {
+    /** Tickers, in the order of the parameters */
+    tickers: string[];
+    weights: number[];
+    parameters: PortfolioSimulationParameters;
+    /** Results in portfolio value instead of price */
+    results: SimulationResults;
+}
+
 // ==============================================================================
 // Chart Data Types
 // ==============================================================================
@@ -93,10 +208,10 @@ export interface ChartDataPoint {
  * Transform simulation response into chart-friendly data.
  */
 export function transformToChartData(response: SimulationResponse): ChartDataPoint[] {
-    const { mean_path, percentile_05, percentile_95 } = response.results;
+    const { steps, mean_path, percentile_05, percentile_95 } = response.results;
 
     return mean_path.map((mean, index) => ({
-        day: index,
+        day: steps[index],
         mean: Number(mean.toFixed(2)),
         upper: Number(percentile_95[index].toFixed(2)),
         lower: Number(percentile_05[index].toFixed(2)),
@@ -124,6 +239,80 @@ export async function runSimulation(
     return response.data;
 }
 
+/**
+ * Run a Monte Carlo simulation for several tickers in one request.
+ *
+ * Each result equals runSimulation for that ticker with the same options;
+ * tickers without usable data are listed in errors instead of failing.
+ *
+ * @param request Tickers and shared simulation parameters
+ * @returns Per-ticker results and errors
+ * @throws Error if the batch fails
+ */
+export async function runBatchSimulation(
+    request: BatchSimulationRequest
+): Promise<BatchSimulationResponse> {
+    const response = await api.post<BatchSimulationResponse>(
+        "/simulation/monte-carlo/batch",
+        request
+    );
+    return response.data;
+}
+
+/**
+ * Stream a progressive Monte Carlo simulation over WebSocket.
+ *
+ * The server sends a snapshot after every chunk of paths (num_simulations
+ * may go up to 1,000,000), ending with a "complete" message. Call the
+ * returned function to cancel; the engine stops within one block of paths.
+ *
+ * @param request Simulation parameters
+ * @param onMessage Called with every progress, complete, cancelled or error message
+ * @returns Function that cancels the run and closes the socket
+ */
+export function streamSimulation(
+    request: SimulationRequest,
+    onMessage: (message: SimulationStreamMessage) => void
+): () => void {
+    const ws = new WebSocket("ws://127.0.0.1:8000/api/v1/simulation/ws");
+
+    ws.onopen = () => ws.send(JSON.stringify(request));
+
+    ws.onmessage = (event) => {
+        const message = JSON.parse(event.data) as SimulationStreamMessage;
+        onMessage(message);
+        if (message.type !== "progress") {
+            ws.close();
+        }
+    };
+
+    ws.onerror = () => onMessage({ type: "error", detail: "Simulation stream failed" });
+
+    return () => {
+        if (ws.readyState === WebSocket.OPEN) {
+            ws.send(JSON.stringify({ action: "cancel" }));
+        }
+        ws.close();
+    };
+}
+
+/**
+ * Run a correlated Monte Carlo simulation of a multi-asset portfolio.
+ *
+ * @param request Holdings and simulation parameters
+ * @returns Portfolio value paths, distribution and tail risk
+ * @throws Error if simulation fails
+ */
+export async function runPortfolioSimulation(
+    request: PortfolioSimulationRequest
+): Promise<PortfolioSimulationResponse> {
+    const response = await api.post<PortfolioSimulationResponse>(
+        "/simulation/portfolio",
+        request
+    );
+    return response.data;
+}
+
 /**
  * Check simulation engine health.
  */